@@ -0,0 +1,118 @@
+//
+// Copyright (c) 2025 Mohammad Nejati
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#ifndef BOOST_HTTP_PROTO_BENCH_COMMON_HPP
+#define BOOST_HTTP_PROTO_BENCH_COMMON_HPP
+
+// Timing and body generation shared by the
+// microbenchmarks, so that their results are
+// measured the same way.
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <ctime>
+#include <string>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+# include <intrin.h>
+# define BENCH_HAS_RDTSC
+#elif defined(__x86_64__) || defined(__i386__)
+# include <x86intrin.h>
+# define BENCH_HAS_RDTSC
+#endif
+
+namespace bench {
+
+using clock_type = std::chrono::steady_clock;
+
+// Return the time stamp counter, or
+// zero where there is none.
+inline
+std::uint64_t
+cycles() noexcept
+{
+#ifdef BENCH_HAS_RDTSC
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+struct timing
+{
+    double seconds;
+    double cycles;
+
+    // from std::clock, which on POSIX systems
+    // is the CPU time of the whole process,
+    // including any helper threads
+    double cpu;
+};
+
+// Return the average time per call of f, run
+// until at least a quarter of a second elapses.
+template<class F>
+timing
+measure(F const& f)
+{
+    f(); // warm up
+    std::size_t n = 0;
+    auto const p0 = std::clock();
+    auto const c0 = cycles();
+    auto const t0 = clock_type::now();
+    auto t1 = t0;
+    do
+    {
+        f();
+        ++n;
+        t1 = clock_type::now();
+    }
+    while(t1 - t0 < std::chrono::milliseconds(250));
+    auto const c1 = cycles();
+    auto const p1 = std::clock();
+    return {
+        std::chrono::duration<double>(
+            t1 - t0).count() / static_cast<double>(n),
+        static_cast<double>(c1 - c0) /
+            static_cast<double>(n),
+        static_cast<double>(p1 - p0) / CLOCKS_PER_SEC /
+            static_cast<double>(n) };
+}
+
+// Return a body of JSON records of the given size
+inline
+std::string
+make_json(std::size_t size)
+{
+    std::string s = "[";
+    for(std::size_t i = 0; s.size() < size; ++i)
+    {
+        char buf[256];
+        int n = std::snprintf(buf, sizeof(buf),
+            "{\"id\":%u,\"name\":\"user%u\","
+            "\"email\":\"user%u@example.com\","
+            "\"active\":%s,\"score\":%u.%02u,"
+            "\"tags\":[\"alpha\",\"beta\",\"gamma\"]},",
+            unsigned(i),
+            unsigned(i % 977),
+            unsigned(i % 977),
+            (i % 3) ? "true" : "false",
+            unsigned((i * 7919) % 1000),
+            unsigned(i % 100));
+        s.append(buf, static_cast<std::size_t>(n));
+    }
+    s.resize(size - 1);
+    s.push_back(']');
+    return s;
+}
+
+} // bench
+
+#endif
@@ -0,0 +1,241 @@
+//
+// Copyright (c) 2025 Mohammad Nejati
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+// Measures the throughput of Content-Encoding in the
+// serializer and the parser over JSON bodies from 1KB
+// to 10MB. Each coding is run with the default payload
+// buffer, where large bodies are coded in pieces, and
+// with one big enough to code every body in one call.
+
+#include "common.hpp"
+
+#include <boost/http_proto/response.hpp>
+#include <boost/http_proto/response_parser.hpp>
+#include <boost/http_proto/serializer.hpp>
+#include <boost/http_proto/zstd.hpp>
+
+#include <boost/buffers.hpp>
+#include <boost/core/detail/string_view.hpp>
+#include <boost/rts/brotli.hpp>
+#include <boost/rts/context.hpp>
+#include <boost/rts/zlib.hpp>
+#include <boost/system/system_error.hpp>
+
+#include <cstdio>
+#include <exception>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace http_proto = boost::http_proto;
+namespace buffers = boost::buffers;
+namespace rts = boost::rts;
+using boost::core::string_view;
+
+namespace {
+
+void
+serialize(
+    http_proto::serializer& sr,
+    http_proto::response const& res,
+    std::string const& body,
+    std::string& out)
+{
+    out.clear();
+    sr.start(res, buffers::const_buffer(
+        body.data(), body.size()));
+    do
+    {
+        auto cbs = sr.prepare();
+        if(cbs.has_error())
+            throw boost::system::system_error(cbs.error());
+        auto const n = buffers::size(cbs.value());
+        auto const pos = out.size();
+        out.resize(pos + n);
+        buffers::copy(
+            buffers::mutable_buffer(&out[pos], n),
+            cbs.value());
+        sr.consume(n);
+    }
+    while(!sr.is_done());
+}
+
+void
+parse(
+    http_proto::response_parser& pr,
+    string_view msg,
+    std::string& body)
+{
+    body.clear();
+    pr.start();
+    buffers::const_buffer in(msg.data(), msg.size());
+    boost::system::error_code ec;
+    while(!pr.got_header())
+    {
+        auto const n = buffers::copy(pr.prepare(), in);
+        buffers::remove_prefix(in, n);
+        pr.commit(n);
+        pr.parse(ec);
+        if(ec.failed() && ec != http_proto::error::need_data)
+            throw boost::system::system_error(ec);
+    }
+
+    buffers::string_buffer buf(&body);
+    pr.set_body(std::ref(buf));
+    pr.parse(ec);
+    while(ec == http_proto::error::need_data)
+    {
+        auto const n = buffers::copy(pr.prepare(), in);
+        buffers::remove_prefix(in, n);
+        pr.commit(n);
+        pr.parse(ec);
+    }
+    if(ec.failed())
+        throw boost::system::system_error(ec);
+}
+
+void
+run(
+    string_view coding,
+    std::size_t payload_buffer,
+    std::vector<std::string> const& bodies)
+{
+    rts::context ctx;
+
+    http_proto::serializer::config scfg;
+    scfg.payload_buffer = payload_buffer;
+
+    http_proto::response_parser::config pcfg;
+    pcfg.body_limit = 64 * 1024 * 1024;
+    pcfg.min_buffer = payload_buffer;
+
+#ifdef BOOST_RTS_HAS_ZLIB
+    rts::zlib::install_deflate_service(ctx);
+    rts::zlib::install_inflate_service(ctx);
+    scfg.apply_deflate_encoder = true;
+    scfg.apply_gzip_encoder = true;
+    pcfg.apply_deflate_decoder = true;
+    pcfg.apply_gzip_decoder = true;
+#endif
+#ifdef BOOST_RTS_HAS_BROTLI
+    rts::brotli::install_encode_service(ctx);
+    rts::brotli::install_decode_service(ctx);
+    scfg.apply_brotli_encoder = true;
+    pcfg.apply_brotli_decoder = true;
+#endif
+#ifdef BOOST_HTTP_PROTO_HAS_ZSTD
+    http_proto::zstd::install_compress_service(ctx);
+    http_proto::zstd::install_decompress_service(ctx);
+    scfg.apply_zstd_encoder = true;
+    pcfg.apply_zstd_decoder = true;
+#endif
+
+    http_proto::install_serializer_service(ctx, scfg);
+    http_proto::install_parser_service(ctx, pcfg);
+
+    http_proto::serializer sr(ctx);
+    http_proto::response_parser pr(ctx);
+    pr.reset();
+
+    http_proto::response res;
+    res.set(http_proto::field::content_type, "application/json");
+    res.set(http_proto::field::content_encoding, coding);
+
+    for(auto const& body : bodies)
+    {
+        std::string wire;
+        auto const enc = bench::measure([&]
+        {
+            serialize(sr, res, body, wire);
+        }).seconds;
+
+        // Replace the close-delimited framing with a
+        // Content-Length so the parser knows the end.
+        auto const coded = wire.size() - res.buffer().size();
+        std::string msg = "HTTP/1.1 200 OK\r\n"
+            "Content-Type: application/json\r\n"
+            "Content-Encoding: ";
+        msg.append(coding.data(), coding.size());
+        msg += "\r\nContent-Length: ";
+        msg += std::to_string(coded);
+        msg += "\r\n\r\n";
+        msg.append(wire, res.buffer().size(), coded);
+
+        std::string decoded;
+        auto const dec = bench::measure([&]
+        {
+            parse(pr, msg, decoded);
+        }).seconds;
+        if(decoded != body)
+            throw std::runtime_error("body mismatch");
+
+        auto const mb = static_cast<double>(
+            body.size()) / (1024 * 1024);
+        std::printf(
+            "%-8.*s %10u %10u %8.2f %10.1f %10.1f\n",
+            static_cast<int>(coding.size()),
+            coding.data(),
+            static_cast<unsigned>(payload_buffer),
+            static_cast<unsigned>(body.size()),
+            static_cast<double>(body.size()) /
+                static_cast<double>(coded),
+            mb / enc,
+            mb / dec);
+    }
+}
+
+} // (anon)
+
+int
+main()
+{
+    std::vector<std::string> bodies;
+    for(std::size_t n : {
+        std::size_t(1024),
+        std::size_t(16 * 1024),
+        std::size_t(256 * 1024),
+        std::size_t(1024 * 1024),
+        std::size_t(10 * 1024 * 1024) })
+        bodies.push_back(bench::make_json(n));
+
+    std::vector<string_view> codings;
+#ifdef BOOST_RTS_HAS_ZLIB
+    codings.push_back("deflate");
+    codings.push_back("gzip");
+#endif
+#ifdef BOOST_RTS_HAS_BROTLI
+    codings.push_back("br");
+#endif
+#ifdef BOOST_HTTP_PROTO_HAS_ZSTD
+    codings.push_back("zstd");
+#endif
+
+    std::printf(
+        "%-8s %10s %10s %8s %10s %10s\n",
+        "coding", "buffer", "body", "ratio",
+        "enc MB/s", "dec MB/s");
+
+    try
+    {
+        for(auto coding : codings)
+        {
+            // pieces for all but the smallest bodies
+            run(coding, 8192, bodies);
+            // one call for every body
+            run(coding, 16 * 1024 * 1024, bodies);
+        }
+    }
+    catch(std::exception const& e)
+    {
+        std::fprintf(stderr, "error: %s\n", e.what());
+        return 1;
+    }
+    return 0;
+}
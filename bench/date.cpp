@@ -0,0 +1,134 @@
+//
+// Copyright (c) 2025 Mohammad Nejati
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+// Measures the cost of producing a Date field value
+// from many threads at once: formatting it on every
+// call with strftime, formatting it on every call
+// with format_date, and reading the shared cache
+// with current_date.
+
+#include <boost/http_proto/date.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <thread>
+#include <vector>
+
+namespace http_proto = boost::http_proto;
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+// What a server does without the library
+std::size_t
+strftime_date(char* dest, std::size_t size)
+{
+    std::time_t const t = std::time(nullptr);
+    std::tm tm;
+#ifdef _WIN32
+    ::gmtime_s(&tm, &t);
+#else
+    ::gmtime_r(&t, &tm);
+#endif
+    return std::strftime(dest, size,
+        "%a, %d %b %Y %H:%M:%S GMT", &tm);
+}
+
+std::size_t
+format_date()
+{
+    char buf[http_proto::date_size];
+    return http_proto::format_date(
+        std::time(nullptr), buf).size();
+}
+
+std::size_t
+cached_date()
+{
+    return http_proto::current_date().size();
+}
+
+// Return the total calls per second of f over
+// the given number of threads.
+template<class F>
+double
+measure(std::size_t threads, F const& f)
+{
+    std::atomic<bool> stop{false};
+    std::atomic<std::size_t> ready{0};
+    std::vector<std::size_t> calls(threads);
+    std::vector<std::thread> v;
+    for(std::size_t i = 0; i < threads; ++i)
+    {
+        v.emplace_back([&, i]
+        {
+            std::size_t n = 0;
+            std::size_t sum = 0;
+            ++ready;
+            while(! stop.load(
+                std::memory_order_relaxed))
+            {
+                sum += f();
+                ++n;
+            }
+            // keep the results alive
+            calls[i] = sum ? n : 0;
+        });
+    }
+    while(ready.load() < threads)
+        std::this_thread::yield();
+    auto const t0 = clock_type::now();
+    std::this_thread::sleep_for(
+        std::chrono::milliseconds(500));
+    stop = true;
+    for(auto& t : v)
+        t.join();
+    auto const t1 = clock_type::now();
+
+    std::size_t total = 0;
+    for(auto n : calls)
+        total += n;
+    return static_cast<double>(total) /
+        std::chrono::duration<double>(t1 - t0).count();
+}
+
+} // (anon)
+
+int
+main()
+{
+    std::vector<std::size_t> counts;
+    auto const hc =
+        std::thread::hardware_concurrency();
+    for(std::size_t n = 1; n < hc; n *= 2)
+        counts.push_back(n);
+    counts.push_back(hc ? hc : 1);
+
+    std::printf(
+        "%8s %14s %14s %14s\n",
+        "threads", "strftime/s", "format/s", "cached/s");
+
+    for(auto n : counts)
+    {
+        auto const a = measure(n, []
+        {
+            char buf[64];
+            return strftime_date(buf, sizeof(buf));
+        });
+        auto const b = measure(n, format_date);
+        auto const c = measure(n, cached_date);
+        std::printf(
+            "%8u %14.0f %14.0f %14.0f\n",
+            static_cast<unsigned>(n), a, b, c);
+    }
+    return 0;
+}
@@ -0,0 +1,363 @@
+//
+// Copyright (c) 2025 Mohammad Nejati
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+// Measures the ratio and throughput of Content-Encoding
+// with and without a shared dictionary, over a corpus of
+// small JSON responses.
+//
+// Usage: dictionary [corpus [dictionary]]
+//
+// The corpus is a file holding one response body per
+// line, such as bodies captured from an API. Without
+// one, a corpus of synthetic records is used. Without
+// a dictionary file, the first tenth of the corpus is
+// concatenated into one and left out of the measurement.
+
+#include <boost/http_proto/compression_dictionary.hpp>
+#include <boost/http_proto/response.hpp>
+#include <boost/http_proto/response_parser.hpp>
+#include <boost/http_proto/serializer.hpp>
+#include <boost/http_proto/zstd.hpp>
+
+#include <boost/buffers.hpp>
+#include <boost/core/detail/string_view.hpp>
+#include <boost/rts/brotli.hpp>
+#include <boost/rts/context.hpp>
+#include <boost/rts/zlib.hpp>
+#include <boost/system/system_error.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <exception>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace http_proto = boost::http_proto;
+namespace buffers = boost::buffers;
+namespace rts = boost::rts;
+using boost::core::string_view;
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+constexpr std::uint32_t dictionary_id = 1;
+
+// Return a corpus of API responses which share
+// their structure but differ in their values
+std::vector<std::string>
+make_corpus(std::size_t count)
+{
+    std::vector<std::string> v;
+    for(std::size_t i = 0; i < count; ++i)
+    {
+        char buf[512];
+        int n = std::snprintf(buf, sizeof(buf),
+            "{\"status\":\"ok\",\"data\":{\"id\":%u,"
+            "\"username\":\"user%u\",\"email\":"
+            "\"user%u@example.com\",\"verified\":%s,"
+            "\"created_at\":\"2025-%02u-%02uT%02u:%02u:00Z\","
+            "\"plan\":\"%s\",\"quota\":{\"used\":%u,"
+            "\"limit\":%u}},\"meta\":{\"request_id\":"
+            "\"%08x\",\"version\":\"v2\"}}",
+            unsigned(i),
+            unsigned(i * 7919 % 100000),
+            unsigned(i * 7919 % 100000),
+            (i % 3) ? "true" : "false",
+            unsigned(i % 12 + 1),
+            unsigned(i % 28 + 1),
+            unsigned(i % 24),
+            unsigned(i % 60),
+            (i % 5) ? "free" : "pro",
+            unsigned(i * 31 % 1000),
+            (i % 5) ? 1000u : 100000u,
+            unsigned(i * 2654435761u));
+        v.emplace_back(buf, static_cast<std::size_t>(n));
+    }
+    return v;
+}
+
+std::vector<std::string>
+read_corpus(char const* path)
+{
+    std::ifstream f(path);
+    if(! f)
+        throw std::runtime_error("cannot open corpus");
+    std::vector<std::string> v;
+    std::string line;
+    while(std::getline(f, line))
+    {
+        if(! line.empty())
+            v.push_back(line);
+    }
+    return v;
+}
+
+std::string
+read_file(char const* path)
+{
+    std::ifstream f(path, std::ios::binary);
+    if(! f)
+        throw std::runtime_error("cannot open dictionary");
+    return std::string(
+        std::istreambuf_iterator<char>(f),
+        std::istreambuf_iterator<char>());
+}
+
+void
+serialize(
+    http_proto::serializer& sr,
+    http_proto::response const& res,
+    bool use_dictionary,
+    std::string const& body,
+    std::string& out)
+{
+    out.clear();
+    if(use_dictionary)
+        sr.set_dictionary(dictionary_id);
+    sr.start(res, buffers::const_buffer(
+        body.data(), body.size()));
+    do
+    {
+        auto cbs = sr.prepare();
+        if(cbs.has_error())
+            throw boost::system::system_error(cbs.error());
+        auto const n = buffers::size(cbs.value());
+        auto const pos = out.size();
+        out.resize(pos + n);
+        buffers::copy(
+            buffers::mutable_buffer(&out[pos], n),
+            cbs.value());
+        sr.consume(n);
+    }
+    while(!sr.is_done());
+}
+
+void
+parse(
+    http_proto::response_parser& pr,
+    bool use_dictionary,
+    string_view msg,
+    std::string& body)
+{
+    body.clear();
+    pr.start();
+    buffers::const_buffer in(msg.data(), msg.size());
+    boost::system::error_code ec;
+    while(!pr.got_header())
+    {
+        auto const n = buffers::copy(pr.prepare(), in);
+        buffers::remove_prefix(in, n);
+        pr.commit(n);
+        pr.parse(ec);
+        if(ec.failed() && ec != http_proto::error::need_data)
+            throw boost::system::system_error(ec);
+    }
+
+    if(use_dictionary)
+        pr.set_dictionary(dictionary_id);
+    buffers::string_buffer buf(&body);
+    pr.set_body(std::ref(buf));
+    pr.parse(ec);
+    while(ec == http_proto::error::need_data)
+    {
+        auto const n = buffers::copy(pr.prepare(), in);
+        buffers::remove_prefix(in, n);
+        pr.commit(n);
+        pr.parse(ec);
+    }
+    if(ec.failed())
+        throw boost::system::system_error(ec);
+}
+
+// Return the average seconds per call of f, run
+// until at least a quarter of a second elapses.
+template<class F>
+double
+measure(F const& f)
+{
+    f(); // warm up
+    std::size_t n = 0;
+    auto const t0 = clock_type::now();
+    auto t1 = t0;
+    do
+    {
+        f();
+        ++n;
+        t1 = clock_type::now();
+    }
+    while(t1 - t0 < std::chrono::milliseconds(250));
+    return std::chrono::duration<double>(
+        t1 - t0).count() / static_cast<double>(n);
+}
+
+void
+run(
+    rts::context& ctx,
+    string_view coding,
+    bool use_dictionary,
+    std::vector<std::string> const& corpus)
+{
+    http_proto::serializer sr(ctx);
+    http_proto::response_parser pr(ctx);
+    pr.reset();
+
+    http_proto::response res;
+    res.set(http_proto::field::content_type, "application/json");
+    res.set(http_proto::field::content_encoding, coding);
+
+    // Replace the close-delimited framing with a
+    // Content-Length so the parser knows the end.
+    std::vector<std::string> msgs;
+    std::size_t plain = 0;
+    std::size_t coded = 0;
+    std::string wire;
+    for(auto const& body : corpus)
+    {
+        serialize(sr, res, use_dictionary, body, wire);
+        auto const n = wire.size() - res.buffer().size();
+        std::string msg = "HTTP/1.1 200 OK\r\n"
+            "Content-Type: application/json\r\n"
+            "Content-Encoding: ";
+        msg.append(coding.data(), coding.size());
+        msg += "\r\nContent-Length: ";
+        msg += std::to_string(n);
+        msg += "\r\n\r\n";
+        msg.append(wire, res.buffer().size(), n);
+        msgs.push_back(std::move(msg));
+        plain += body.size();
+        coded += n;
+    }
+
+    auto const enc = measure([&]
+    {
+        for(auto const& body : corpus)
+            serialize(sr, res, use_dictionary, body, wire);
+    });
+
+    std::string decoded;
+    for(std::size_t i = 0; i < msgs.size(); ++i)
+    {
+        parse(pr, use_dictionary, msgs[i], decoded);
+        if(decoded != corpus[i])
+            throw std::runtime_error("body mismatch");
+    }
+
+    auto const dec = measure([&]
+    {
+        for(auto const& msg : msgs)
+            parse(pr, use_dictionary, msg, decoded);
+    });
+
+    auto const count = static_cast<double>(corpus.size());
+    auto const mb = static_cast<double>(plain) / (1024 * 1024);
+    std::printf(
+        "%-8.*s %-5s %8.2f %10.0f %10.1f %10.0f %10.1f\n",
+        static_cast<int>(coding.size()),
+        coding.data(),
+        use_dictionary ? "yes" : "no",
+        static_cast<double>(plain) /
+            static_cast<double>(coded),
+        count / enc,
+        mb / enc,
+        count / dec,
+        mb / dec);
+}
+
+} // (anon)
+
+int
+main(int argc, char** argv)
+{
+    try
+    {
+        auto corpus = (argc > 1)
+            ? read_corpus(argv[1])
+            : make_corpus(11000);
+
+        std::string dictionary;
+        if(argc > 2)
+        {
+            dictionary = read_file(argv[2]);
+        }
+        else
+        {
+            // train on samples which are
+            // not part of the measurement
+            auto const n = corpus.size() / 10;
+            for(std::size_t i = 0; i < n; ++i)
+                dictionary += corpus[i];
+            corpus.erase(corpus.begin(), corpus.begin() +
+                static_cast<std::ptrdiff_t>(n));
+        }
+        if(corpus.empty() || dictionary.empty())
+            throw std::runtime_error("empty corpus");
+
+        rts::context ctx;
+        http_proto::serializer::config scfg;
+        http_proto::response_parser::config pcfg;
+        std::vector<string_view> codings;
+
+#ifdef BOOST_RTS_HAS_ZLIB
+        rts::zlib::install_deflate_service(ctx);
+        rts::zlib::install_inflate_service(ctx);
+        scfg.apply_deflate_encoder = true;
+        pcfg.apply_deflate_decoder = true;
+        codings.push_back("deflate");
+#endif
+#ifdef BOOST_RTS_HAS_BROTLI
+        rts::brotli::install_encode_service(ctx);
+        rts::brotli::install_decode_service(ctx);
+        scfg.apply_brotli_encoder = true;
+        pcfg.apply_brotli_decoder = true;
+        codings.push_back("br");
+#endif
+#ifdef BOOST_HTTP_PROTO_HAS_ZSTD
+        http_proto::zstd::install_compress_service(ctx);
+        http_proto::zstd::install_decompress_service(ctx);
+        scfg.apply_zstd_encoder = true;
+        pcfg.apply_zstd_decoder = true;
+        codings.push_back("zstd");
+#endif
+
+        // dictionaries are digested by the
+        // services installed after them
+        http_proto::install_compression_dictionary(
+            ctx, dictionary_id, dictionary);
+        http_proto::install_serializer_service(ctx, scfg);
+        http_proto::install_parser_service(ctx, pcfg);
+
+        std::printf(
+            "%u bodies, %u byte dictionary\n",
+            static_cast<unsigned>(corpus.size()),
+            static_cast<unsigned>(dictionary.size()));
+        std::printf(
+            "%-8s %-5s %8s %10s %10s %10s %10s\n",
+            "coding", "dict", "ratio",
+            "enc msg/s", "enc MB/s",
+            "dec msg/s", "dec MB/s");
+
+        for(auto coding : codings)
+        {
+            run(ctx, coding, false, corpus);
+            run(ctx, coding, true, corpus);
+        }
+    }
+    catch(std::exception const& e)
+    {
+        std::fprintf(stderr, "error: %s\n", e.what());
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,114 @@
+//
+// Copyright (c) 2025 Mohammad Nejati
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+// Measures the cost of the field edits a proxy makes
+// on each response, applied with one call per edit
+// and with an edit_batch.
+
+#include <boost/http_proto/edit_batch.hpp>
+#include <boost/http_proto/response.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+namespace http_proto = boost::http_proto;
+using http_proto::field;
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+constexpr std::size_t iterations = 1000000;
+
+// A response as received from an origin server
+http_proto::response
+make_response()
+{
+    return http_proto::response(
+        "HTTP/1.1 200 OK\r\n"
+        "Server: origin/1.0\r\n"
+        "Date: Sun, 06 Nov 1994 08:49:37 GMT\r\n"
+        "Connection: keep-alive\r\n"
+        "Keep-Alive: timeout=5, max=100\r\n"
+        "Content-Type: application/json\r\n"
+        "Cache-Control: private, max-age=0\r\n"
+        "X-Powered-By: framework\r\n"
+        "X-Internal-Trace: 8c1f0a2e\r\n"
+        "Transfer-Encoding: chunked\r\n"
+        "\r\n");
+}
+
+// Return the nanoseconds per response of f
+template<class F>
+double
+measure(
+    http_proto::response const& tmpl,
+    http_proto::response& res,
+    F const& f)
+{
+    std::size_t sum = 0;
+    auto const t0 = clock_type::now();
+    for(std::size_t i = 0; i < iterations; ++i)
+    {
+        res = tmpl;
+        f();
+        sum += res.buffer().size();
+    }
+    auto const t1 = clock_type::now();
+    if(sum == 0)
+        std::printf("unexpected\n");
+    return std::chrono::duration<double, std::nano>(
+        t1 - t0).count() / iterations;
+}
+
+} // (anon)
+
+int
+main()
+{
+    auto const tmpl = make_response();
+    std::string const via = "1.1 proxy";
+
+    http_proto::response res;
+    res.reserve_bytes(1024);
+    auto const copy = measure(tmpl, res, []{});
+
+    auto const singles = measure(tmpl, res, [&]
+    {
+        res.erase(field::connection);
+        res.erase(field::keep_alive);
+        res.erase("X-Powered-By");
+        res.erase("X-Internal-Trace");
+        res.set(field::server, "proxy");
+        res.append(field::via, via);
+        res.append("X-Cache", "MISS");
+        res.set(field::cache_control, "no-store");
+    });
+
+    http_proto::edit_batch b(res);
+    auto const batch = measure(tmpl, res, [&]
+    {
+        b.erase(field::connection)
+         .erase(field::keep_alive)
+         .erase("X-Powered-By")
+         .erase("X-Internal-Trace")
+         .set(field::server, "proxy")
+         .append(field::via, via)
+         .append("X-Cache", "MISS")
+         .set(field::cache_control, "no-store");
+        b.commit();
+    });
+
+    std::printf("%-10s %10s\n", "edits", "ns/msg");
+    std::printf("%-10s %10.1f\n", "copy only", copy);
+    std::printf("%-10s %10.1f\n", "single", singles - copy);
+    std::printf("%-10s %10.1f\n", "batch", batch - copy);
+    return 0;
+}
@@ -0,0 +1,675 @@
+//
+// Copyright (c) 2025 Mohammad Nejati
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+// A load generator for HTTP/1.1 servers, built on the
+// library alone. Requests are produced by serializer,
+// with optional chunked and compressed bodies, and
+// responses are checked by response_parser, which
+// also decodes compressed responses when asked to.
+//
+// Each thread runs an epoll loop over its share of
+// the connections. A connection sends a batch of
+// pipelined requests and waits for all responses
+// before sending the next. Latency is measured from
+// the time a request is queued to the time its
+// response completes, and is recorded in a histogram
+// with three significant digits, in the manner of
+// HdrHistogram.
+//
+// Run against the server benchmark with:
+//   server --serve &
+//   load --connections 256 --depth 4
+
+#include <boost/http_proto/error.hpp>
+#include <boost/http_proto/request.hpp>
+#include <boost/http_proto/response_parser.hpp>
+#include <boost/http_proto/serializer.hpp>
+
+#include <boost/buffers.hpp>
+#include <boost/core/detail/string_view.hpp>
+#include <boost/rts/context.hpp>
+
+#include <cstdio>
+
+#if defined(__linux__)
+
+#include "net.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <netinet/in.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace http_proto = boost::http_proto;
+namespace buffers = boost::buffers;
+namespace rts = boost::rts;
+using boost::core::string_view;
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+struct options
+{
+    std::string host = "127.0.0.1";
+    unsigned short port = 8080;
+    std::size_t threads = 0;
+    std::size_t connections = 64;
+    std::size_t depth = 1;
+    std::size_t seconds = 5;
+    std::size_t warmup = 1;
+    std::string target = "/fixed";
+    std::size_t body = 0;
+    bool chunked = false;
+    std::string coding;
+    std::string accept;
+    bool keep_alive = true;
+};
+
+std::atomic<bool> stop{false};
+std::atomic<bool> measuring{false};
+
+//------------------------------------------------
+
+// Counts of values in buckets whose width grows
+// with the value, so that every recorded value is
+// known to within 1/1024 of itself, over a range
+// of nanoseconds to minutes, in fixed memory.
+class histogram
+{
+    // values below this are counted exactly
+    static constexpr unsigned sub_bits = 11;
+    static constexpr std::uint64_t sub_count = 1 << sub_bits;
+    static constexpr std::uint64_t half_count = sub_count / 2;
+    static constexpr unsigned max_shift = 30;
+
+    std::vector<std::uint64_t> counts_;
+    std::uint64_t total_ = 0;
+    std::uint64_t max_ = 0;
+
+    static
+    unsigned
+    log2(std::uint64_t v) noexcept
+    {
+        unsigned n = 0;
+        while(v >>= 1)
+            ++n;
+        return n;
+    }
+
+    static
+    std::size_t
+    index_of(std::uint64_t v) noexcept
+    {
+        if(v < sub_count)
+            return static_cast<std::size_t>(v);
+        // v >> shift is in [half_count, sub_count)
+        auto shift = log2(v) - (sub_bits - 1);
+        if(shift > max_shift)
+        {
+            shift = max_shift;
+            v = (sub_count << max_shift) - 1;
+        }
+        return static_cast<std::size_t>(
+            sub_count + (shift - 1) * half_count +
+            ((v >> shift) - half_count));
+    }
+
+    // the highest value counted in a bucket
+    static
+    std::uint64_t
+    value_at(std::size_t i) noexcept
+    {
+        if(i < sub_count)
+            return i;
+        auto const shift = static_cast<unsigned>(
+            (i - sub_count) / half_count + 1);
+        auto const sub =
+            (i - sub_count) % half_count + half_count;
+        return ((sub + 1) << shift) - 1;
+    }
+
+public:
+    histogram()
+        : counts_(sub_count + max_shift * half_count)
+    {
+    }
+
+    void
+    record(std::uint64_t v) noexcept
+    {
+        ++counts_[index_of(v)];
+        ++total_;
+        max_ = (std::max)(max_, v);
+    }
+
+    void
+    merge(histogram const& other) noexcept
+    {
+        for(std::size_t i = 0; i < counts_.size(); ++i)
+            counts_[i] += other.counts_[i];
+        total_ += other.total_;
+        max_ = (std::max)(max_, other.max_);
+    }
+
+    std::uint64_t
+    count() const noexcept
+    {
+        return total_;
+    }
+
+    std::uint64_t
+    percentile(double p) const noexcept
+    {
+        if(total_ == 0)
+            return 0;
+        if(p >= 100)
+            return max_;
+        auto const want = (std::max)(std::uint64_t(1),
+            static_cast<std::uint64_t>(
+                p / 100 * static_cast<double>(total_) + 0.5));
+        std::uint64_t seen = 0;
+        for(std::size_t i = 0; i < counts_.size(); ++i)
+        {
+            seen += counts_[i];
+            if(seen >= want)
+                return (std::min)(value_at(i), max_);
+        }
+        return max_;
+    }
+};
+
+constexpr std::uint64_t histogram::sub_count;
+constexpr std::uint64_t histogram::half_count;
+
+//------------------------------------------------
+
+struct stats
+{
+    histogram latency;
+    std::uint64_t responses = 0;
+    std::uint64_t errors = 0;
+    std::uint64_t sent = 0;
+    std::uint64_t received = 0;
+    std::uint64_t body = 0;
+};
+
+//------------------------------------------------
+
+class connection
+{
+    options const& opt_;
+    sockaddr_in const& addr_;
+    http_proto::request const& req_;
+    std::string const& body_;
+    http_proto::serializer sr_;
+    http_proto::response_parser pr_;
+    int fd_ = -1;
+
+    // the serialized batch of requests
+    std::string out_;
+    std::size_t sent_ = 0;
+
+    // when each request in flight was queued
+    std::deque<clock_type::time_point> queued_;
+
+public:
+    connection(
+        rts::context const& ctx,
+        options const& opt,
+        sockaddr_in const& addr,
+        http_proto::request const& req,
+        std::string const& body)
+        : opt_(opt)
+        , addr_(addr)
+        , req_(req)
+        , body_(body)
+        , sr_(ctx)
+        , pr_(ctx)
+    {
+    }
+
+    ~connection()
+    {
+        if(fd_ != -1)
+            ::close(fd_);
+    }
+
+    int
+    fd() const noexcept
+    {
+        return fd_;
+    }
+
+    void
+    connect()
+    {
+        if(fd_ != -1)
+            ::close(fd_);
+        fd_ = ::socket(AF_INET,
+            SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if(fd_ == -1)
+            net::fail("socket");
+        net::set_nodelay(fd_);
+        if(::connect(fd_, reinterpret_cast<
+            sockaddr const*>(&addr_), sizeof(addr_)) != 0 &&
+                errno != EINPROGRESS)
+            net::fail("connect");
+        pr_.reset();
+        pr_.start();
+        queued_.clear();
+        queue_batch();
+    }
+
+    // Returns false when the connection
+    // is closed, by either side.
+    bool
+    on_ready(stats& st)
+    {
+        auto const measured = measuring.load(
+            std::memory_order_relaxed);
+        for(;;)
+        {
+            while(sent_ < out_.size())
+            {
+                auto const n = ::send(fd_,
+                    out_.data() + sent_,
+                    out_.size() - sent_,
+                    MSG_NOSIGNAL);
+                if(n == -1)
+                    return net::would_block();
+                sent_ += static_cast<std::size_t>(n);
+                if(measured)
+                    st.sent += static_cast<std::size_t>(n);
+            }
+
+            boost::system::error_code ec;
+            pr_.parse(ec);
+            if(pr_.got_header())
+            {
+                auto const n = buffers::size(pr_.pull_body());
+                pr_.consume_body(n);
+                if(measured)
+                    st.body += n;
+            }
+            if(ec == http_proto::error::need_data)
+            {
+                auto const n = net::readv_some(
+                    fd_, pr_.prepare());
+                if(n == 0)
+                {
+                    // closed with requests in flight
+                    if(measured)
+                        ++st.errors;
+                    return false;
+                }
+                if(n == -1)
+                    return net::would_block();
+                pr_.commit(static_cast<std::size_t>(n));
+                if(measured)
+                    st.received += static_cast<std::size_t>(n);
+                continue;
+            }
+            if(ec.failed())
+            {
+                if(measured)
+                    ++st.errors;
+                return false;
+            }
+            if(! pr_.is_complete())
+                continue;
+
+            auto const& res = pr_.get();
+            if(measured)
+            {
+                auto const t = clock_type::now() -
+                    queued_.front();
+                st.latency.record(static_cast<std::uint64_t>(
+                    std::chrono::duration_cast<
+                        std::chrono::nanoseconds>(t).count()));
+                ++st.responses;
+                if(res.status_int() != 200)
+                    ++st.errors;
+            }
+            queued_.pop_front();
+            if(! res.keep_alive())
+                return false;
+            pr_.start();
+            if(queued_.empty())
+                queue_batch();
+        }
+    }
+
+private:
+    // Serialize the next batch of
+    // pipelined requests
+    void
+    queue_batch()
+    {
+        out_.clear();
+        sent_ = 0;
+        auto const depth =
+            opt_.keep_alive ? opt_.depth : 1;
+        auto const now = clock_type::now();
+        for(std::size_t i = 0; i < depth; ++i)
+        {
+            if(body_.empty())
+                sr_.start(req_);
+            else
+                sr_.start(req_, buffers::const_buffer(
+                    body_.data(), body_.size()));
+            do
+            {
+                auto cbs = sr_.prepare();
+                if(cbs.has_error())
+                    throw boost::system::system_error(
+                        cbs.error());
+                auto const n = buffers::size(cbs.value());
+                auto const pos = out_.size();
+                out_.resize(pos + n);
+                buffers::copy(
+                    buffers::mutable_buffer(&out_[pos], n),
+                    cbs.value());
+                sr_.consume(n);
+            }
+            while(! sr_.is_done());
+            queued_.push_back(now);
+        }
+    }
+};
+
+void
+run(
+    options const& opt,
+    sockaddr_in const& addr,
+    std::size_t connections,
+    stats& st)
+{
+    rts::context ctx;
+    net::install_services(ctx, opt.coding, opt.accept);
+
+    http_proto::request req;
+    req.set_start_line(
+        opt.body ? http_proto::method::post :
+            http_proto::method::get,
+        opt.target,
+        http_proto::version::http_1_1);
+    req.set(http_proto::field::host, opt.host);
+    if(! opt.accept.empty())
+        req.set(http_proto::field::accept_encoding, opt.accept);
+    if(! opt.keep_alive)
+        req.set_keep_alive(false);
+
+    std::string body;
+    if(opt.body)
+    {
+        for(std::size_t i = 0; body.size() < opt.body; ++i)
+            body += "field" + std::to_string(i % 97) +
+                "=value" + std::to_string(i) + "&";
+        body.resize(opt.body);
+        req.set(http_proto::field::content_type,
+            "application/x-www-form-urlencoded");
+        if(! opt.coding.empty())
+            req.set(http_proto::field::content_encoding,
+                opt.coding);
+        // coded sizes are not known up front
+        if(opt.chunked || ! opt.coding.empty())
+            req.set_chunked(true);
+        else
+            req.set_payload_size(body.size());
+    }
+
+    int ep = ::epoll_create1(EPOLL_CLOEXEC);
+    if(ep == -1)
+        net::fail("epoll_create1");
+
+    auto const add = [&](connection& c)
+    {
+        c.connect();
+        epoll_event ev{};
+        ev.events = EPOLLIN | EPOLLOUT | EPOLLET;
+        ev.data.ptr = &c;
+        ::epoll_ctl(ep, EPOLL_CTL_ADD, c.fd(), &ev);
+    };
+
+    std::vector<std::unique_ptr<connection>> v;
+    for(std::size_t i = 0; i < connections; ++i)
+    {
+        v.emplace_back(new connection(
+            ctx, opt, addr, req, body));
+        add(*v.back());
+    }
+
+    epoll_event events[256];
+    while(! stop.load(std::memory_order_relaxed))
+    {
+        int n = ::epoll_wait(ep, events, 256, 100);
+        for(int i = 0; i < n; ++i)
+        {
+            auto& c = *static_cast<
+                connection*>(events[i].data.ptr);
+            // closing the descriptor
+            // removes it from the set
+            if(! c.on_ready(st))
+                add(c);
+        }
+    }
+    v.clear();
+    ::close(ep);
+}
+
+//------------------------------------------------
+
+void
+usage()
+{
+    std::fprintf(stderr,
+        "usage: load [options]\n"
+        "  --host ADDR       IPv4 address of the server (127.0.0.1)\n"
+        "  --port N          port of the server (8080)\n"
+        "  --threads N       event loops (cores / 2)\n"
+        "  --connections N   connections (64)\n"
+        "  --depth N         pipelined requests per connection (1)\n"
+        "  --close           one request per connection\n"
+        "  --target PATH     request target (/fixed)\n"
+        "  --body N          POST a body of N bytes (GET)\n"
+        "  --chunked         send the body with chunked encoding\n"
+        "  --coding NAME     compress the body: deflate, gzip, br or zstd\n"
+        "  --accept NAME     ask for and decode compressed responses\n"
+        "  --warmup N        seconds before measuring (1)\n"
+        "  --seconds N       duration of the measurement (5)\n");
+}
+
+bool
+parse_options(
+    int argc,
+    char** argv,
+    options& opt)
+{
+    for(int i = 1; i < argc; ++i)
+    {
+        string_view a = argv[i];
+        auto const next = [&]() -> char const*
+        {
+            if(i + 1 >= argc)
+                throw std::invalid_argument(
+                    "missing value");
+            return argv[++i];
+        };
+        auto const num = [&]
+        {
+            return static_cast<std::size_t>(
+                std::strtoull(next(), nullptr, 10));
+        };
+        if(a == "--host")
+            opt.host = next();
+        else if(a == "--port")
+            opt.port = static_cast<unsigned short>(num());
+        else if(a == "--threads")
+            opt.threads = num();
+        else if(a == "--connections")
+            opt.connections = num();
+        else if(a == "--depth")
+            opt.depth = num();
+        else if(a == "--close")
+            opt.keep_alive = false;
+        else if(a == "--target")
+            opt.target = next();
+        else if(a == "--body")
+            opt.body = num();
+        else if(a == "--chunked")
+            opt.chunked = true;
+        else if(a == "--coding")
+            opt.coding = next();
+        else if(a == "--accept")
+            opt.accept = next();
+        else if(a == "--warmup")
+            opt.warmup = num();
+        else if(a == "--seconds")
+            opt.seconds = num();
+        else
+            return false;
+    }
+    return opt.depth != 0 && opt.connections != 0;
+}
+
+} // (anon)
+
+int
+main(int argc, char** argv)
+{
+    try
+    {
+        options opt;
+        if(! parse_options(argc, argv, opt))
+        {
+            usage();
+            return 2;
+        }
+        if(! net::coding_supported(opt.coding) ||
+            ! net::coding_supported(opt.accept))
+        {
+            std::fprintf(stderr, "coding not available\n");
+            return 2;
+        }
+        if(opt.threads == 0)
+        {
+            auto const hc = std::thread::hardware_concurrency();
+            opt.threads = hc > 1 ? hc / 2 : 1;
+        }
+        opt.threads = (std::min)(opt.threads, opt.connections);
+
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(opt.port);
+        if(::inet_pton(AF_INET, opt.host.c_str(),
+            &addr.sin_addr) != 1)
+        {
+            std::fprintf(stderr, "bad address: %s\n",
+                opt.host.c_str());
+            return 2;
+        }
+
+        std::vector<stats> st(opt.threads);
+        std::vector<std::thread> threads;
+        for(std::size_t i = 0; i < opt.threads; ++i)
+        {
+            auto const n = opt.connections / opt.threads +
+                (i < opt.connections % opt.threads ? 1 : 0);
+            auto& s = st[i];
+            threads.emplace_back([&opt, &addr, n, &s]
+            {
+                run(opt, addr, n, s);
+            });
+        }
+
+        std::this_thread::sleep_for(
+            std::chrono::seconds(opt.warmup));
+        measuring = true;
+        auto const t0 = clock_type::now();
+        std::this_thread::sleep_for(
+            std::chrono::seconds(opt.seconds));
+        measuring = false;
+        auto const t1 = clock_type::now();
+        stop = true;
+        for(auto& t : threads)
+            t.join();
+
+        stats total;
+        for(auto const& s : st)
+        {
+            total.latency.merge(s.latency);
+            total.responses += s.responses;
+            total.errors += s.errors;
+            total.sent += s.sent;
+            total.received += s.received;
+            total.body += s.body;
+        }
+
+        auto const secs =
+            std::chrono::duration<double>(t1 - t0).count();
+        auto const n = static_cast<double>(
+            (std::max)(total.responses, std::uint64_t(1)));
+        auto const us = [&](double p)
+        {
+            return static_cast<double>(
+                total.latency.percentile(p)) / 1000;
+        };
+
+        std::printf("%-14s %12.0f\n", "requests/s",
+            static_cast<double>(total.responses) / secs);
+        std::printf("%-14s %12u\n", "responses",
+            unsigned(total.responses));
+        std::printf("%-14s %12u\n", "errors",
+            unsigned(total.errors));
+        std::printf("%-14s %12.1f\n", "sent B/req",
+            static_cast<double>(total.sent) / n);
+        std::printf("%-14s %12.1f\n", "recv B/req",
+            static_cast<double>(total.received) / n);
+        std::printf("%-14s %12.1f\n", "body B/req",
+            static_cast<double>(total.body) / n);
+        std::printf("latency (us)\n");
+        for(double p : { 50.0, 90.0, 99.0, 99.9, 99.99, 100.0 })
+            std::printf("  p%-11g %12.1f\n", p, us(p));
+    }
+    catch(std::exception const& e)
+    {
+        std::fprintf(stderr, "error: %s\n", e.what());
+        return 1;
+    }
+    return 0;
+}
+
+#else
+
+int
+main()
+{
+    std::fprintf(stderr,
+        "this benchmark requires Linux\n");
+    return 0;
+}
+
+#endif
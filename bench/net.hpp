@@ -0,0 +1,196 @@
+//
+// Copyright (c) 2025 Mohammad Nejati
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#ifndef BOOST_HTTP_PROTO_BENCH_NET_HPP
+#define BOOST_HTTP_PROTO_BENCH_NET_HPP
+
+// Socket and service helpers shared by the
+// benchmarks which run over TCP on Linux.
+
+#include <boost/http_proto/response_parser.hpp>
+#include <boost/http_proto/serializer.hpp>
+#include <boost/http_proto/zstd.hpp>
+
+#include <boost/core/detail/string_view.hpp>
+#include <boost/rts/brotli.hpp>
+#include <boost/rts/context.hpp>
+#include <boost/rts/zlib.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#include <errno.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+namespace net {
+
+inline
+void
+fail(char const* what)
+{
+    throw std::runtime_error(
+        std::string(what) + ": " + std::strerror(errno));
+}
+
+// Install the serializer and parser services
+// on a per-thread context. Bodies are sent with
+// the content coding `coding`, and responses
+// in the coding `accept` are decoded. Either
+// may be empty. One parser service serves both
+// requests and responses.
+inline
+void
+install_services(
+    boost::rts::context& ctx,
+    boost::core::string_view coding,
+    boost::core::string_view accept)
+{
+    namespace http_proto = boost::http_proto;
+    namespace rts = boost::rts;
+
+    http_proto::serializer::config scfg;
+    http_proto::response_parser::config pcfg;
+    pcfg.body_limit = std::uint64_t(-1);
+
+#ifdef BOOST_RTS_HAS_ZLIB
+    if(coding == "deflate" || coding == "gzip")
+    {
+        rts::zlib::install_deflate_service(ctx);
+        scfg.apply_deflate_encoder = true;
+        scfg.apply_gzip_encoder = true;
+    }
+    if(accept == "deflate" || accept == "gzip")
+    {
+        rts::zlib::install_inflate_service(ctx);
+        pcfg.apply_deflate_decoder = true;
+        pcfg.apply_gzip_decoder = true;
+    }
+#endif
+#ifdef BOOST_RTS_HAS_BROTLI
+    if(coding == "br")
+    {
+        rts::brotli::install_encode_service(ctx);
+        scfg.apply_brotli_encoder = true;
+    }
+    if(accept == "br")
+    {
+        rts::brotli::install_decode_service(ctx);
+        pcfg.apply_brotli_decoder = true;
+    }
+#endif
+#ifdef BOOST_HTTP_PROTO_HAS_ZSTD
+    if(coding == "zstd")
+    {
+        http_proto::zstd::install_compress_service(ctx);
+        scfg.apply_zstd_encoder = true;
+    }
+    if(accept == "zstd")
+    {
+        http_proto::zstd::install_decompress_service(ctx);
+        pcfg.apply_zstd_decoder = true;
+    }
+#endif
+
+    http_proto::install_serializer_service(ctx, scfg);
+    http_proto::install_parser_service(ctx, pcfg);
+}
+
+// Whether the coding is empty, or
+// available in this build.
+inline
+bool
+coding_supported(boost::core::string_view coding)
+{
+#ifdef BOOST_RTS_HAS_ZLIB
+    if(coding == "deflate" || coding == "gzip")
+        return true;
+#endif
+#ifdef BOOST_RTS_HAS_BROTLI
+    if(coding == "br")
+        return true;
+#endif
+#ifdef BOOST_HTTP_PROTO_HAS_ZSTD
+    if(coding == "zstd")
+        return true;
+#endif
+    return coding.empty();
+}
+
+inline
+void
+set_nodelay(int fd)
+{
+    int one = 1;
+    ::setsockopt(fd, IPPROTO_TCP,
+        TCP_NODELAY, &one, sizeof(one));
+}
+
+inline
+bool
+would_block() noexcept
+{
+    return errno == EAGAIN || errno == EWOULDBLOCK;
+}
+
+// Return the number of bytes moved, 0 on
+// end of stream, or -1 with errno set.
+template<class Buffers>
+ssize_t
+readv_some(int fd, Buffers const& bs)
+{
+    iovec iov[16];
+    int n = 0;
+    for(auto const& b : bs)
+    {
+        if(n == 16)
+            break;
+        iov[n].iov_base = b.data();
+        iov[n].iov_len = b.size();
+        ++n;
+    }
+    ssize_t rv;
+    do
+        rv = ::readv(fd, iov, n);
+    while(rv == -1 && errno == EINTR);
+    return rv;
+}
+
+template<class Buffers>
+ssize_t
+writev_some(int fd, Buffers const& bs)
+{
+    iovec iov[16];
+    int n = 0;
+    for(auto const& b : bs)
+    {
+        if(n == 16)
+            break;
+        iov[n].iov_base = const_cast<void*>(b.data());
+        iov[n].iov_len = b.size();
+        ++n;
+    }
+    msghdr msg{};
+    msg.msg_iov = iov;
+    msg.msg_iovlen = n;
+    ssize_t rv;
+    do
+        rv = ::sendmsg(fd, &msg, MSG_NOSIGNAL);
+    while(rv == -1 && errno == EINTR);
+    return rv;
+}
+
+} // net
+
+#endif
@@ -0,0 +1,412 @@
+//
+// Copyright (c) 2025 Mohammad Nejati
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+// Microbenchmarks of parsing, over the messages in
+// corpus.hpp:
+//
+//   header   the header alone, parsed into a request
+//            or response container
+//   field    string_to_field on every field name
+//   method   string_to_method on common methods
+//   parser   whole messages through the parser,
+//            including chunked bodies
+//   decode   compressed, chunked JSON responses
+//            through the parser with decoders applied
+//
+// Parser input is fed whole, in pieces the size of
+// a TCP segment, and one byte at a time. Results are
+// printed as CSV, one row per case. Cycles are read
+// from the time stamp counter where there is one,
+// which counts at a fixed rate rather than the core
+// clock; pin the frequency for stable results.
+//
+// Usage: parser [filter]
+//
+// Only cases whose name contains the filter are run.
+
+#include "common.hpp"
+#include "corpus.hpp"
+
+#include <boost/http_proto/field.hpp>
+#include <boost/http_proto/method.hpp>
+#include <boost/http_proto/request.hpp>
+#include <boost/http_proto/request_parser.hpp>
+#include <boost/http_proto/response.hpp>
+#include <boost/http_proto/response_parser.hpp>
+#include <boost/http_proto/serializer.hpp>
+#include <boost/http_proto/zstd.hpp>
+
+#include <boost/buffers.hpp>
+#include <boost/core/detail/string_view.hpp>
+#include <boost/rts/brotli.hpp>
+#include <boost/rts/context.hpp>
+#include <boost/rts/zlib.hpp>
+#include <boost/system/system_error.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <exception>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace http_proto = boost::http_proto;
+namespace buffers = boost::buffers;
+namespace rts = boost::rts;
+using boost::core::string_view;
+
+namespace {
+
+// the payload of a TCP segment on Ethernet
+constexpr std::size_t mtu = 1460;
+
+// keeps results from being optimized away
+volatile std::size_t sink;
+
+std::string filter;
+
+void
+report(
+    string_view bench,
+    string_view name,
+    string_view feed,
+    std::size_t bytes,
+    bench::timing const& t)
+{
+    std::printf("%.*s,%.*s,%.*s,%u,%.1f,%.0f,%.1f,",
+        static_cast<int>(bench.size()), bench.data(),
+        static_cast<int>(name.size()), name.data(),
+        static_cast<int>(feed.size()), feed.data(),
+        static_cast<unsigned>(bytes),
+        t.seconds * 1e9,
+        1 / t.seconds,
+        static_cast<double>(bytes) / t.seconds / (1024 * 1024));
+#ifdef BENCH_HAS_RDTSC
+    std::printf("%.2f\n",
+        t.cycles / static_cast<double>(bytes));
+#else
+    std::printf("\n");
+#endif
+    std::fflush(stdout);
+}
+
+bool
+selected(
+    string_view bench,
+    string_view name)
+{
+    if(filter.empty())
+        return true;
+    std::string s(bench.data(), bench.size());
+    s += '/';
+    s.append(name.data(), name.size());
+    return s.find(filter) != std::string::npos;
+}
+
+string_view
+header_of(string_view msg)
+{
+    auto const n = msg.find("\r\n\r\n");
+    if(n == string_view::npos)
+        throw std::runtime_error("no header");
+    return msg.substr(0, n + 4);
+}
+
+// Parse one message, supplying at most
+// piece bytes to the parser at a time.
+std::size_t
+feed(
+    http_proto::parser& pr,
+    string_view msg,
+    std::size_t piece)
+{
+    pr.start();
+    std::size_t body = 0;
+    std::size_t pos = 0;
+    boost::system::error_code ec;
+    for(;;)
+    {
+        pr.parse(ec);
+        if(pr.got_header())
+        {
+            auto const n = buffers::size(pr.pull_body());
+            pr.consume_body(n);
+            body += n;
+        }
+        if(ec != http_proto::error::need_data)
+            break;
+        if(pos == msg.size())
+            throw std::runtime_error("incomplete message");
+        auto const n = buffers::copy(
+            pr.prepare(),
+            buffers::const_buffer(
+                msg.data() + pos,
+                (std::min)(piece, msg.size() - pos)));
+        pr.commit(n);
+        pos += n;
+    }
+    if(ec.failed())
+        throw boost::system::system_error(ec);
+    if(! pr.is_complete())
+        throw std::runtime_error("incomplete message");
+    return body;
+}
+
+struct feed_mode
+{
+    char const* name;
+    std::size_t piece;
+};
+
+constexpr feed_mode feeds[] = {
+    { "whole", std::size_t(-1) },
+    { "mtu", mtu },
+    { "byte", 1 }
+};
+
+//------------------------------------------------
+
+void
+bench_header()
+{
+    for(auto const& m : corpus::messages)
+    {
+        if(! selected("header", m.name))
+            continue;
+        auto const h = header_of(m.text);
+        auto const t = bench::measure([&]
+        {
+            if(m.request)
+                sink = http_proto::request(h).size();
+            else
+                sink = http_proto::response(h).size();
+        });
+        report("header", m.name, "whole", h.size(), t);
+    }
+}
+
+void
+bench_field()
+{
+    if(! selected("field", "corpus"))
+        return;
+    std::vector<std::string> names;
+    std::size_t bytes = 0;
+    for(auto const& m : corpus::messages)
+    {
+        auto const h = header_of(m.text);
+        auto const add = [&](
+            http_proto::fields_base const& f)
+        {
+            for(auto const& e : f)
+            {
+                names.emplace_back(e.name);
+                bytes += e.name.size();
+            }
+        };
+        if(m.request)
+            add(http_proto::request(h));
+        else
+            add(http_proto::response(h));
+    }
+    auto const t = bench::measure([&]
+    {
+        std::size_t n = 0;
+        for(auto const& s : names)
+            if(http_proto::string_to_field(s))
+                ++n;
+        sink = n;
+    });
+    report("field", "corpus", "whole", bytes, t);
+}
+
+void
+bench_method()
+{
+    if(! selected("method", "common"))
+        return;
+    // weighted roughly as seen on the web,
+    // with a few rare and unknown ones
+    static char const* const methods[] = {
+        "GET", "GET", "GET", "GET", "GET", "GET",
+        "POST", "POST", "POST", "HEAD", "OPTIONS",
+        "PUT", "DELETE", "PATCH", "CONNECT",
+        "PROPFIND", "M-SEARCH", "BREW" };
+    std::size_t bytes = 0;
+    for(string_view s : methods)
+        bytes += s.size();
+    auto const t = bench::measure([&]
+    {
+        std::size_t n = 0;
+        for(string_view s : methods)
+            n += static_cast<std::size_t>(
+                http_proto::string_to_method(s));
+        sink = n;
+    });
+    report("method", "common", "whole", bytes, t);
+}
+
+void
+bench_parser(rts::context const& ctx)
+{
+    http_proto::request_parser req(ctx);
+    http_proto::response_parser res(ctx);
+    req.reset();
+    res.reset();
+    for(auto const& m : corpus::messages)
+    {
+        if(! selected("parser", m.name))
+            continue;
+        string_view const msg = m.text;
+        http_proto::parser& pr = m.request ?
+            static_cast<http_proto::parser&>(req) :
+            static_cast<http_proto::parser&>(res);
+        for(auto const& f : feeds)
+        {
+            auto const t = bench::measure([&]
+            {
+                sink = feed(pr, msg, f.piece);
+            });
+            report("parser", m.name, f.name, msg.size(), t);
+        }
+    }
+}
+
+// Return a complete response with the
+// body compressed and chunked
+std::string
+make_coded(
+    rts::context const& ctx,
+    string_view coding,
+    std::string const& body)
+{
+    http_proto::response res;
+    res.set(http_proto::field::content_type, "application/json");
+    res.set(http_proto::field::content_encoding, coding);
+    res.set_chunked(true);
+
+    http_proto::serializer sr(ctx);
+    sr.start(res, buffers::const_buffer(
+        body.data(), body.size()));
+    std::string out;
+    do
+    {
+        auto cbs = sr.prepare();
+        if(cbs.has_error())
+            throw boost::system::system_error(cbs.error());
+        auto const n = buffers::size(cbs.value());
+        auto const pos = out.size();
+        out.resize(pos + n);
+        buffers::copy(
+            buffers::mutable_buffer(&out[pos], n),
+            cbs.value());
+        sr.consume(n);
+    }
+    while(! sr.is_done());
+    return out;
+}
+
+void
+bench_decode(rts::context const& ctx)
+{
+    std::vector<string_view> codings;
+#ifdef BOOST_RTS_HAS_ZLIB
+    codings.push_back("deflate");
+    codings.push_back("gzip");
+#endif
+#ifdef BOOST_RTS_HAS_BROTLI
+    codings.push_back("br");
+#endif
+#ifdef BOOST_HTTP_PROTO_HAS_ZSTD
+    codings.push_back("zstd");
+#endif
+
+    auto const body = bench::make_json(64 * 1024);
+    http_proto::response_parser pr(ctx);
+    pr.reset();
+    for(auto coding : codings)
+    {
+        if(! selected("decode", coding))
+            continue;
+        auto const msg = make_coded(ctx, coding, body);
+        if(feed(pr, msg, msg.size()) != body.size())
+            throw std::runtime_error("body mismatch");
+        for(auto const& f : feeds)
+        {
+            auto const t = bench::measure([&]
+            {
+                sink = feed(pr, msg, f.piece);
+            });
+            report("decode", coding, f.name, msg.size(), t);
+        }
+    }
+}
+
+} // (anon)
+
+int
+main(int argc, char** argv)
+{
+    if(argc > 2)
+    {
+        std::fprintf(stderr, "usage: parser [filter]\n");
+        return 2;
+    }
+    if(argc == 2)
+        filter = argv[1];
+
+    try
+    {
+        rts::context ctx;
+
+        http_proto::serializer::config scfg;
+        http_proto::response_parser::config pcfg;
+        pcfg.body_limit = 64 * 1024 * 1024;
+
+#ifdef BOOST_RTS_HAS_ZLIB
+        rts::zlib::install_deflate_service(ctx);
+        rts::zlib::install_inflate_service(ctx);
+        scfg.apply_deflate_encoder = true;
+        scfg.apply_gzip_encoder = true;
+        pcfg.apply_deflate_decoder = true;
+        pcfg.apply_gzip_decoder = true;
+#endif
+#ifdef BOOST_RTS_HAS_BROTLI
+        rts::brotli::install_encode_service(ctx);
+        rts::brotli::install_decode_service(ctx);
+        scfg.apply_brotli_encoder = true;
+        pcfg.apply_brotli_decoder = true;
+#endif
+#ifdef BOOST_HTTP_PROTO_HAS_ZSTD
+        http_proto::zstd::install_compress_service(ctx);
+        http_proto::zstd::install_decompress_service(ctx);
+        scfg.apply_zstd_encoder = true;
+        pcfg.apply_zstd_decoder = true;
+#endif
+
+        http_proto::install_serializer_service(ctx, scfg);
+        http_proto::install_parser_service(ctx, pcfg);
+
+        std::printf(
+            "bench,name,feed,bytes,ns_per_msg,"
+            "msgs_per_sec,mb_per_sec,cycles_per_byte\n");
+
+        bench_header();
+        bench_field();
+        bench_method();
+        bench_parser(ctx);
+        bench_decode(ctx);
+    }
+    catch(std::exception const& e)
+    {
+        std::fprintf(stderr, "error: %s\n", e.what());
+        return 1;
+    }
+    return 0;
+}
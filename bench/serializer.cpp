@@ -0,0 +1,486 @@
+//
+// Copyright (c) 2025 Mohammad Nejati
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+// Measures serializer::prepare and consume over HTML,
+// JSON and binary bodies, for data to choose the
+// serializer::config settings by:
+//
+//   style    each body style (empty, buffers, source
+//            and stream) without a content coding
+//   coding   each content coding at several levels
+//            and payload_buffer sizes
+//
+// The output is consumed without being copied, so
+// only the work of the serializer is counted. Results
+// are printed as CSV, one row per case, with the
+// throughput over the body, the average number of
+// buffers returned by prepare, and the CPU time of
+// the process per byte of coded output. That time
+// covers all of prepare and consume, not only the
+// filter, and includes the threads of any thread
+// pool used by a coding. Compare it with the
+// style rows of the same body to estimate the cost
+// of the coding itself.
+//
+// Usage: serializer [filter]
+//
+// Only cases whose name contains the filter are run.
+
+#include "common.hpp"
+
+#include <boost/http_proto/error.hpp>
+#include <boost/http_proto/response.hpp>
+#include <boost/http_proto/serializer.hpp>
+#include <boost/http_proto/source.hpp>
+#include <boost/http_proto/zstd.hpp>
+
+#include <boost/buffers.hpp>
+#include <boost/core/detail/string_view.hpp>
+#include <boost/rts/brotli.hpp>
+#include <boost/rts/context.hpp>
+#include <boost/rts/zlib.hpp>
+#include <boost/system/system_error.hpp>
+
+#include <cstdint>
+#include <cstdio>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace http_proto = boost::http_proto;
+namespace buffers = boost::buffers;
+namespace rts = boost::rts;
+using boost::core::string_view;
+
+namespace {
+
+std::string filter;
+
+struct body
+{
+    char const* name;
+    std::string data;
+};
+
+// Return an HTML page of the given size
+std::string
+make_html(std::size_t size)
+{
+    std::string s =
+        "<!DOCTYPE html><html lang=\"en\"><head>"
+        "<meta charset=\"utf-8\"><title>Products</title>"
+        "<link rel=\"stylesheet\" href=\"/static/site.css\">"
+        "</head><body><main class=\"grid\">";
+    for(std::size_t i = 0; s.size() < size; ++i)
+    {
+        char buf[512];
+        int n = std::snprintf(buf, sizeof(buf),
+            "<article class=\"card\" data-id=\"%u\">"
+            "<a href=\"/products/%u\"><img src=\"/img/%u.webp\" "
+            "alt=\"Product %u\" loading=\"lazy\" width=\"320\" "
+            "height=\"240\"></a><h2>Product %u</h2>"
+            "<p class=\"price\">$%u.%02u</p><p>Rated %u of 5 "
+            "by %u customers.</p><button class=\"btn\" "
+            "data-sku=\"SKU-%05u\">Add to cart</button></article>",
+            unsigned(i),
+            unsigned(i * 7919 % 100000),
+            unsigned(i * 7919 % 100000),
+            unsigned(i),
+            unsigned(i),
+            unsigned(i * 37 % 500),
+            unsigned(i % 100),
+            unsigned(i % 5 + 1),
+            unsigned(i * 13 % 2000),
+            unsigned(i * 7919 % 100000));
+        s.append(buf, static_cast<std::size_t>(n));
+    }
+    s.resize(size);
+    return s;
+}
+
+// Return incompressible data, such as
+// an image or an archive
+std::string
+make_binary(std::size_t size)
+{
+    std::string s(size, '\0');
+    std::uint64_t x = 0x9e3779b97f4a7c15;
+    for(auto& c : s)
+    {
+        x ^= x << 13;
+        x ^= x >> 7;
+        x ^= x << 17;
+        c = static_cast<char>(x >> 56);
+    }
+    return s;
+}
+
+// Supplies the body by copying,
+// as a file_source would
+class memory_source
+    : public http_proto::source
+{
+    buffers::const_buffer cb_;
+
+public:
+    explicit
+    memory_source(string_view s) noexcept
+        : cb_(s.data(), s.size())
+    {
+    }
+
+private:
+    results
+    on_read(
+        buffers::mutable_buffer b) override
+    {
+        results rv;
+        rv.bytes = buffers::copy(b, cb_);
+        buffers::remove_prefix(cb_, rv.bytes);
+        rv.finished = cb_.size() == 0;
+        return rv;
+    }
+};
+
+struct counts
+{
+    std::size_t out = 0;
+    std::size_t prepares = 0;
+    std::size_t buffers = 0;
+};
+
+// Consume all of the output, which
+// starts with the body style given
+template<class Start>
+counts
+drain(
+    http_proto::serializer& sr,
+    Start const& start)
+{
+    counts c;
+    auto st = start();
+    do
+    {
+        auto cbs = sr.prepare();
+        if(cbs.has_error())
+        {
+            if(cbs.error() != http_proto::error::need_data)
+                throw boost::system::system_error(cbs.error());
+            st();
+            continue;
+        }
+        auto const n = buffers::size(cbs.value());
+        ++c.prepares;
+        c.buffers += static_cast<std::size_t>(std::distance(
+            buffers::begin(cbs.value()),
+            buffers::end(cbs.value())));
+        c.out += n;
+        sr.consume(n);
+    }
+    while(! sr.is_done());
+    return c;
+}
+
+// Supplies more stream data when the
+// serializer asks for it
+class stream_writer
+{
+    http_proto::serializer::stream* st_;
+    string_view rest_;
+
+public:
+    stream_writer(
+        http_proto::serializer::stream& st,
+        string_view body) noexcept
+        : st_(&st)
+        , rest_(body)
+    {
+    }
+
+    void
+    operator()()
+    {
+        if(! st_->is_open())
+            return;
+        if(rest_.empty())
+        {
+            st_->close();
+            return;
+        }
+        auto const n = buffers::copy(
+            st_->prepare(),
+            buffers::const_buffer(
+                rest_.data(), rest_.size()));
+        st_->commit(n);
+        rest_.remove_prefix(n);
+    }
+};
+
+struct no_writer
+{
+    void
+    operator()() const
+    {
+        throw std::logic_error("unexpected need_data");
+    }
+};
+
+void
+report(
+    string_view bench,
+    body const& b,
+    string_view style,
+    string_view coding,
+    int level,
+    std::size_t payload_buffer,
+    counts const& c,
+    bench::timing const& t)
+{
+    auto const size = b.data.size();
+    auto const coded = c.out;
+    std::printf(
+        "%.*s,%s,%u,%.*s,%.*s,%d,%u,%u,%.0f,%.1f,%u,%.2f,%.2f\n",
+        static_cast<int>(bench.size()), bench.data(),
+        b.name,
+        static_cast<unsigned>(size),
+        static_cast<int>(style.size()), style.data(),
+        static_cast<int>(coding.size()), coding.data(),
+        level,
+        static_cast<unsigned>(payload_buffer),
+        static_cast<unsigned>(coded),
+        t.seconds * 1e9,
+        static_cast<double>(size) / t.seconds / (1024 * 1024),
+        static_cast<unsigned>(c.prepares),
+        static_cast<double>(c.buffers) /
+            static_cast<double>(c.prepares),
+        t.cpu * 1e9 / static_cast<double>(coded));
+    std::fflush(stdout);
+}
+
+bool
+selected(std::string const& name)
+{
+    return filter.empty() ||
+        name.find(filter) != std::string::npos;
+}
+
+//------------------------------------------------
+
+void
+bench_style(std::vector<body> const& bodies)
+{
+    rts::context ctx;
+    http_proto::serializer::config cfg;
+    http_proto::install_serializer_service(ctx, cfg);
+    http_proto::serializer sr(ctx);
+
+    // only the header
+    if(selected("style/none/empty"))
+    {
+        http_proto::response res;
+        res.set_payload_size(0);
+        counts c;
+        auto const t = bench::measure([&]
+        {
+            c = drain(sr, [&]
+            {
+                sr.start(res);
+                return no_writer{};
+            });
+        });
+        report("style", { "none", {} }, "empty", "identity",
+            0, cfg.payload_buffer, c, t);
+    }
+
+    for(auto const& b : bodies)
+    {
+        string_view const data = b.data;
+        http_proto::response res;
+        res.set(http_proto::field::content_type,
+            "application/octet-stream");
+        res.set_payload_size(data.size());
+
+        auto const run = [&](
+            char const* style,
+            std::function<counts()> const& f)
+        {
+            if(! selected(std::string("style/") +
+                b.name + "/" + style))
+                return;
+            counts c;
+            auto const t = bench::measure([&]{ c = f(); });
+            report("style", b, style, "identity", 0,
+                cfg.payload_buffer, c, t);
+        };
+
+        run("buffers", [&]
+        {
+            return drain(sr, [&]
+            {
+                sr.start(res, buffers::const_buffer(
+                    data.data(), data.size()));
+                return no_writer{};
+            });
+        });
+        run("source", [&]
+        {
+            return drain(sr, [&]
+            {
+                sr.start<memory_source>(res, data);
+                return no_writer{};
+            });
+        });
+        run("stream", [&]
+        {
+            http_proto::serializer::stream st;
+            return drain(sr, [&]
+            {
+                st = sr.start_stream(res);
+                return stream_writer(st, data);
+            });
+        });
+    }
+}
+
+struct coding_case
+{
+    char const* coding;
+    int level;
+};
+
+void
+bench_coding(
+    std::vector<body> const& bodies,
+    coding_case const& cc,
+    std::size_t payload_buffer)
+{
+    std::string const name =
+        std::string("coding/") + cc.coding + "/" +
+        std::to_string(cc.level) + "/" +
+        std::to_string(payload_buffer);
+    if(! selected(name))
+        return;
+
+    rts::context ctx;
+    http_proto::serializer::config cfg;
+    cfg.payload_buffer = payload_buffer;
+    string_view const coding = cc.coding;
+
+#ifdef BOOST_RTS_HAS_ZLIB
+    rts::zlib::install_deflate_service(ctx);
+    cfg.apply_deflate_encoder = true;
+    cfg.apply_gzip_encoder = true;
+    if(coding == "deflate" || coding == "gzip")
+        cfg.zlib_comp_level = cc.level;
+#endif
+#ifdef BOOST_RTS_HAS_BROTLI
+    rts::brotli::install_encode_service(ctx);
+    cfg.apply_brotli_encoder = true;
+    if(coding == "br")
+        cfg.brotli_comp_quality =
+            static_cast<std::uint32_t>(cc.level);
+#endif
+#ifdef BOOST_HTTP_PROTO_HAS_ZSTD
+    http_proto::zstd::install_compress_service(ctx);
+    cfg.apply_zstd_encoder = true;
+    if(coding == "zstd")
+        cfg.zstd_comp_level = cc.level;
+#endif
+
+    http_proto::install_serializer_service(ctx, cfg);
+    http_proto::serializer sr(ctx);
+
+    for(auto const& b : bodies)
+    {
+        string_view const data = b.data;
+        http_proto::response res;
+        res.set(http_proto::field::content_type,
+            "application/octet-stream");
+        res.set(http_proto::field::content_encoding, coding);
+        res.set_chunked(true);
+
+        counts c;
+        auto const t = bench::measure([&]
+        {
+            c = drain(sr, [&]
+            {
+                sr.start(res, buffers::const_buffer(
+                    data.data(), data.size()));
+                return no_writer{};
+            });
+        });
+        report("coding", b, "buffers", coding,
+            cc.level, payload_buffer, c, t);
+    }
+}
+
+} // (anon)
+
+int
+main(int argc, char** argv)
+{
+    if(argc > 2)
+    {
+        std::fprintf(stderr, "usage: serializer [filter]\n");
+        return 2;
+    }
+    if(argc == 2)
+        filter = argv[1];
+
+    std::vector<body> bodies;
+    for(std::size_t n : {
+        std::size_t(16 * 1024),
+        std::size_t(1024 * 1024) })
+    {
+        bodies.push_back({ "html", make_html(n) });
+        bodies.push_back({ "json", bench::make_json(n) });
+        bodies.push_back({ "binary", make_binary(n) });
+    }
+
+    std::vector<coding_case> cases;
+#ifdef BOOST_RTS_HAS_ZLIB
+    for(int level : { 1, 6, 9 })
+    {
+        cases.push_back({ "deflate", level });
+        cases.push_back({ "gzip", level });
+    }
+#endif
+#ifdef BOOST_RTS_HAS_BROTLI
+    for(int quality : { 1, 5, 9, 11 })
+        cases.push_back({ "br", quality });
+#endif
+#ifdef BOOST_HTTP_PROTO_HAS_ZSTD
+    for(int level : { 1, 3, 9, 19 })
+        cases.push_back({ "zstd", level });
+#endif
+
+    std::printf(
+        "bench,body,size,style,coding,level,payload_buffer,"
+        "out_bytes,ns_per_msg,mb_per_sec,prepares,"
+        "buffers_per_prepare,process_cpu_ns_per_out_byte\n");
+
+    try
+    {
+        bench_style(bodies);
+        for(auto const& cc : cases)
+            for(std::size_t pb : {
+                std::size_t(8192),
+                std::size_t(64 * 1024) })
+                bench_coding(bodies, cc, pb);
+    }
+    catch(std::exception const& e)
+    {
+        std::fprintf(stderr, "error: %s\n", e.what());
+        return 1;
+    }
+    return 0;
+}
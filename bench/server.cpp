@@ -0,0 +1,760 @@
+//
+// Copyright (c) 2025 Mohammad Nejati
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+// Measures requests per second through request_parser
+// and serializer in a real event loop. The server runs
+// one epoll loop per thread, each with its own socket
+// bound to the same port with SO_REUSEPORT, so the
+// kernel spreads connections over the loops without
+// any locking between them.
+//
+// By default a built-in client on loopback keeps a
+// number of connections busy with pipelined requests
+// for a fixed time, and prints the rate. With --serve
+// the server runs until killed, for external clients.
+//
+// Targets:
+//   /fixed      a body from memory with Content-Length
+//   /file       a file, through file_cache and file_source
+//   /chunked    a body from memory with chunked encoding
+
+#include <boost/http_proto/connection_buffers.hpp>
+#include <boost/http_proto/date.hpp>
+#include <boost/http_proto/error.hpp>
+#include <boost/http_proto/file_cache.hpp>
+#include <boost/http_proto/file_source.hpp>
+#include <boost/http_proto/request_parser.hpp>
+#include <boost/http_proto/response.hpp>
+#include <boost/http_proto/response_parser.hpp>
+#include <boost/http_proto/serializer.hpp>
+
+#include <boost/buffers.hpp>
+#include <boost/core/detail/string_view.hpp>
+#include <boost/rts/context.hpp>
+
+#include <cstdio>
+
+#if defined(__linux__)
+
+#include "net.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <netinet/in.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace http_proto = boost::http_proto;
+namespace buffers = boost::buffers;
+namespace rts = boost::rts;
+using boost::core::string_view;
+
+namespace {
+
+struct options
+{
+    unsigned short port = 8080;
+    std::size_t threads = 0;
+    std::size_t clients = 0;
+    std::size_t connections = 64;
+    std::size_t depth = 1;
+    std::size_t size = 1024;
+    std::size_t seconds = 5;
+    std::string target = "/fixed";
+    std::string coding;
+    bool keep_alive = true;
+    bool serve = false;
+};
+
+std::atomic<bool> stop{false};
+
+//------------------------------------------------
+//
+// Server
+//
+//------------------------------------------------
+
+struct shared_state
+{
+    options opt;
+    std::string body;
+    std::string path;
+    http_proto::file_cache cache{ {} };
+};
+
+class connection
+{
+    int fd_;
+    shared_state& st_;
+    http_proto::connection_buffers cb_;
+    http_proto::response res_;
+    bool writing_ = false;
+    bool close_ = false;
+
+public:
+    connection(
+        int fd,
+        shared_state& st,
+        rts::context const& ctx)
+        : fd_(fd)
+        , st_(st)
+        , cb_(ctx)
+    {
+        cb_.parser().reset();
+        cb_.parser().start();
+    }
+
+    ~connection()
+    {
+        ::close(fd_);
+    }
+
+    int
+    fd() const noexcept
+    {
+        return fd_;
+    }
+
+    // Make all the progress possible without
+    // blocking. Returns false to close.
+    bool
+    on_ready()
+    {
+        auto& pr = cb_.parser();
+        auto& sr = cb_.serializer();
+        for(;;)
+        {
+            if(writing_)
+            {
+                while(! sr.is_done())
+                {
+                    auto cbs = sr.prepare();
+                    if(cbs.has_error())
+                        return false;
+                    auto const n = net::writev_some(
+                        fd_, cbs.value());
+                    if(n == -1)
+                        return net::would_block();
+                    sr.consume(static_cast<
+                        std::size_t>(n));
+                }
+                writing_ = false;
+                if(close_)
+                    return false;
+                pr.start();
+            }
+
+            boost::system::error_code ec;
+            pr.parse(ec);
+            // request bodies are discarded
+            if(pr.got_header())
+                pr.consume_body(
+                    buffers::size(pr.pull_body()));
+            if(ec == http_proto::error::need_data)
+            {
+                auto const n = net::readv_some(
+                    fd_, pr.prepare());
+                if(n == 0)
+                    return false;
+                if(n == -1)
+                    return net::would_block();
+                pr.commit(static_cast<
+                    std::size_t>(n));
+                continue;
+            }
+            if(ec.failed())
+                return false;
+            if(! pr.is_complete())
+                continue;
+
+            respond();
+            writing_ = true;
+        }
+    }
+
+private:
+    void
+    respond()
+    {
+        auto const& req = cb_.parser().get();
+        auto& sr = cb_.serializer();
+
+        res_.clear();
+        res_.set(http_proto::field::date,
+            http_proto::current_date());
+        res_.set(http_proto::field::server, "http_proto");
+        res_.set(http_proto::field::content_type, "text/plain");
+
+        close_ = ! req.keep_alive();
+        if(close_)
+            res_.set_keep_alive(false);
+
+        // compressed sizes are not known up front
+        bool coded = false;
+        if(! st_.opt.coding.empty())
+        {
+            auto it = req.find(
+                http_proto::field::accept_encoding);
+            coded = it != req.end() &&
+                it->value.find(st_.opt.coding) !=
+                    string_view::npos;
+            if(coded)
+                res_.set(
+                    http_proto::field::content_encoding,
+                    st_.opt.coding);
+        }
+
+        auto const target = req.target();
+        if(target == "/fixed")
+        {
+            if(coded)
+                res_.set_chunked(true);
+            else
+                res_.set_payload_size(st_.body.size());
+            sr.start(res_, buffers::const_buffer(
+                st_.body.data(), st_.body.size()));
+        }
+        else if(target == "/file")
+        {
+            auto e = st_.cache.open(st_.path);
+            if(coded)
+                res_.set_chunked(true);
+            else
+                res_.set_payload_size(e->size);
+            sr.start<http_proto::file_source>(
+                res_, std::move(e));
+        }
+        else if(target == "/chunked")
+        {
+            res_.set_chunked(true);
+            sr.start(res_, buffers::const_buffer(
+                st_.body.data(), st_.body.size()));
+        }
+        else
+        {
+            res_.set_start_line(
+                http_proto::status::not_found);
+            res_.set_payload_size(0);
+            sr.start(res_);
+        }
+    }
+};
+
+int
+make_listener(unsigned short port)
+{
+    int fd = ::socket(AF_INET,
+        SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if(fd == -1)
+        net::fail("socket");
+    int one = 1;
+    ::setsockopt(fd, SOL_SOCKET,
+        SO_REUSEADDR, &one, sizeof(one));
+    if(::setsockopt(fd, SOL_SOCKET,
+        SO_REUSEPORT, &one, sizeof(one)) != 0)
+        net::fail("SO_REUSEPORT");
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if(::bind(fd, reinterpret_cast<
+        sockaddr*>(&addr), sizeof(addr)) != 0)
+        net::fail("bind");
+    if(::listen(fd, SOMAXCONN) != 0)
+        net::fail("listen");
+    return fd;
+}
+
+void
+run_server(
+    shared_state& st,
+    int listener)
+{
+    rts::context ctx;
+    net::install_services(ctx, st.opt.coding, "");
+
+    int ep = ::epoll_create1(EPOLL_CLOEXEC);
+    if(ep == -1)
+        net::fail("epoll_create1");
+
+    epoll_event ev{};
+    ev.events = EPOLLIN;
+    ev.data.ptr = nullptr;
+    ::epoll_ctl(ep, EPOLL_CTL_ADD, listener, &ev);
+
+    std::unordered_map<
+        connection*,
+        std::unique_ptr<connection>> conns;
+
+    epoll_event events[256];
+    while(! stop.load(std::memory_order_relaxed))
+    {
+        int n = ::epoll_wait(ep, events, 256, 100);
+        for(int i = 0; i < n; ++i)
+        {
+            auto c = static_cast<
+                connection*>(events[i].data.ptr);
+            if(! c)
+            {
+                for(;;)
+                {
+                    int fd = ::accept4(listener, nullptr,
+                        nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+                    if(fd == -1)
+                        break;
+                    net::set_nodelay(fd);
+                    std::unique_ptr<connection> up(
+                        new connection(fd, st, ctx));
+                    epoll_event cev{};
+                    cev.events = EPOLLIN | EPOLLOUT | EPOLLET;
+                    cev.data.ptr = up.get();
+                    ::epoll_ctl(ep, EPOLL_CTL_ADD, fd, &cev);
+                    auto const p = up.get();
+                    conns.emplace(p, std::move(up));
+                }
+                continue;
+            }
+            if(! c->on_ready())
+                conns.erase(c);
+        }
+    }
+    conns.clear();
+    ::close(ep);
+}
+
+//------------------------------------------------
+//
+// Client
+//
+//------------------------------------------------
+
+// padded so that client threads
+// do not share a cache line
+struct counter
+{
+    std::atomic<std::uint64_t> responses{0};
+    std::atomic<std::uint64_t> errors{0};
+    char pad[64 - 2 * sizeof(std::uint64_t)];
+};
+
+class client_connection
+{
+    int fd_ = -1;
+    std::string const& batch_;
+    std::size_t depth_;
+    http_proto::response_parser pr_;
+    std::size_t sent_ = 0;
+    std::size_t inflight_ = 0;
+
+public:
+    client_connection(
+        rts::context const& ctx,
+        std::string const& batch,
+        std::size_t depth)
+        : batch_(batch)
+        , depth_(depth)
+        , pr_(ctx)
+    {
+    }
+
+    ~client_connection()
+    {
+        if(fd_ != -1)
+            ::close(fd_);
+    }
+
+    int
+    fd() const noexcept
+    {
+        return fd_;
+    }
+
+    void
+    connect(unsigned short port)
+    {
+        if(fd_ != -1)
+            ::close(fd_);
+        fd_ = ::socket(AF_INET,
+            SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if(fd_ == -1)
+            net::fail("socket");
+        net::set_nodelay(fd_);
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(port);
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        if(::connect(fd_, reinterpret_cast<
+            sockaddr*>(&addr), sizeof(addr)) != 0 &&
+                errno != EINPROGRESS)
+            net::fail("connect");
+        pr_.reset();
+        pr_.start();
+        sent_ = 0;
+        inflight_ = depth_;
+    }
+
+    // Returns false when the connection
+    // is closed, by either side.
+    bool
+    on_ready(counter& c)
+    {
+        for(;;)
+        {
+            while(sent_ < batch_.size())
+            {
+                auto const n = ::send(fd_,
+                    batch_.data() + sent_,
+                    batch_.size() - sent_,
+                    MSG_NOSIGNAL);
+                if(n == -1)
+                    return net::would_block();
+                sent_ += static_cast<std::size_t>(n);
+            }
+
+            boost::system::error_code ec;
+            pr_.parse(ec);
+            if(pr_.got_header())
+                pr_.consume_body(
+                    buffers::size(pr_.pull_body()));
+            if(ec == http_proto::error::need_data)
+            {
+                auto const n = net::readv_some(
+                    fd_, pr_.prepare());
+                if(n == 0)
+                    return false;
+                if(n == -1)
+                    return net::would_block();
+                pr_.commit(static_cast<
+                    std::size_t>(n));
+                continue;
+            }
+            if(ec.failed())
+            {
+                c.errors.fetch_add(1,
+                    std::memory_order_relaxed);
+                return false;
+            }
+            if(! pr_.is_complete())
+                continue;
+
+            c.responses.fetch_add(1,
+                std::memory_order_relaxed);
+            if(! pr_.get().keep_alive())
+                return false;
+            pr_.start();
+            if(--inflight_ == 0)
+            {
+                // send the next batch
+                sent_ = 0;
+                inflight_ = depth_;
+            }
+        }
+    }
+};
+
+void
+run_client(
+    options const& opt,
+    std::string const& batch,
+    std::size_t connections,
+    counter& c)
+{
+    rts::context ctx;
+    net::install_services(ctx, opt.coding, "");
+
+    int ep = ::epoll_create1(EPOLL_CLOEXEC);
+    if(ep == -1)
+        net::fail("epoll_create1");
+
+    auto const add = [&](client_connection& cc)
+    {
+        cc.connect(opt.port);
+        epoll_event ev{};
+        ev.events = EPOLLIN | EPOLLOUT | EPOLLET;
+        ev.data.ptr = &cc;
+        ::epoll_ctl(ep, EPOLL_CTL_ADD, cc.fd(), &ev);
+    };
+
+    std::vector<std::unique_ptr<client_connection>> v;
+    for(std::size_t i = 0; i < connections; ++i)
+    {
+        v.emplace_back(new client_connection(
+            ctx, batch, opt.keep_alive ? opt.depth : 1));
+        add(*v.back());
+    }
+
+    epoll_event events[256];
+    while(! stop.load(std::memory_order_relaxed))
+    {
+        int n = ::epoll_wait(ep, events, 256, 100);
+        for(int i = 0; i < n; ++i)
+        {
+            auto& cc = *static_cast<
+                client_connection*>(events[i].data.ptr);
+            if(! cc.on_ready(c))
+            {
+                // closing the descriptor
+                // removes it from the set
+                add(cc);
+            }
+        }
+    }
+    v.clear();
+    ::close(ep);
+}
+
+std::string
+make_batch(options const& opt)
+{
+    std::string req = "GET ";
+    req += opt.target;
+    req += " HTTP/1.1\r\nHost: localhost\r\n";
+    if(! opt.coding.empty())
+        req += "Accept-Encoding: " + opt.coding + "\r\n";
+    if(! opt.keep_alive)
+        req += "Connection: close\r\n";
+    req += "\r\n";
+
+    std::string batch;
+    auto const depth = opt.keep_alive ? opt.depth : 1;
+    for(std::size_t i = 0; i < depth; ++i)
+        batch += req;
+    return batch;
+}
+
+//------------------------------------------------
+
+void
+usage()
+{
+    std::fprintf(stderr,
+        "usage: server [options]\n"
+        "  --port N          port on 127.0.0.1 (8080)\n"
+        "  --threads N       server event loops (cores / 2)\n"
+        "  --serve           serve until killed, no built-in client\n"
+        "  --clients N       client threads (cores / 2)\n"
+        "  --connections N   client connections (64)\n"
+        "  --depth N         pipelined requests per connection (1)\n"
+        "  --close           one request per connection\n"
+        "  --target PATH     /fixed, /file or /chunked (/fixed)\n"
+        "  --size N          body size in bytes (1024)\n"
+        "  --coding NAME     deflate, gzip, br or zstd (none)\n"
+        "  --seconds N       duration of the measurement (5)\n");
+}
+
+bool
+parse_options(
+    int argc,
+    char** argv,
+    options& opt)
+{
+    for(int i = 1; i < argc; ++i)
+    {
+        string_view a = argv[i];
+        auto const next = [&]() -> char const*
+        {
+            if(i + 1 >= argc)
+                throw std::invalid_argument(
+                    "missing value");
+            return argv[++i];
+        };
+        auto const num = [&]
+        {
+            return static_cast<std::size_t>(
+                std::strtoull(next(), nullptr, 10));
+        };
+        if(a == "--port")
+            opt.port = static_cast<unsigned short>(num());
+        else if(a == "--threads")
+            opt.threads = num();
+        else if(a == "--serve")
+            opt.serve = true;
+        else if(a == "--clients")
+            opt.clients = num();
+        else if(a == "--connections")
+            opt.connections = num();
+        else if(a == "--depth")
+            opt.depth = num();
+        else if(a == "--close")
+            opt.keep_alive = false;
+        else if(a == "--target")
+            opt.target = next();
+        else if(a == "--size")
+            opt.size = num();
+        else if(a == "--coding")
+            opt.coding = next();
+        else if(a == "--seconds")
+            opt.seconds = num();
+        else
+            return false;
+    }
+    return opt.depth != 0 && opt.connections != 0;
+}
+
+} // (anon)
+
+int
+main(int argc, char** argv)
+{
+    try
+    {
+        shared_state st;
+        if(! parse_options(argc, argv, st.opt))
+        {
+            usage();
+            return 2;
+        }
+        auto& opt = st.opt;
+        if(! net::coding_supported(opt.coding))
+        {
+            std::fprintf(stderr,
+                "coding not available: %s\n",
+                opt.coding.c_str());
+            return 2;
+        }
+
+        auto const hc = std::thread::hardware_concurrency();
+        auto const half = hc > 1 ? hc / 2 : 1;
+        if(opt.threads == 0)
+            opt.threads = opt.serve ? (hc ? hc : 1) : half;
+        if(opt.clients == 0)
+            opt.clients = half;
+
+        // text compresses like typical content
+        for(std::size_t i = 0; st.body.size() < opt.size; ++i)
+            st.body += "line " + std::to_string(i) +
+                " of the response body\n";
+        st.body.resize(opt.size);
+
+        st.path = "/tmp/http_proto_bench_" +
+            std::to_string(::getpid());
+        {
+            std::ofstream f(st.path, std::ios::binary);
+            f << st.body;
+        }
+
+        std::vector<int> listeners;
+        for(std::size_t i = 0; i < opt.threads; ++i)
+            listeners.push_back(make_listener(opt.port));
+
+        std::vector<std::thread> servers;
+        for(auto fd : listeners)
+            servers.emplace_back([&st, fd]
+            {
+                run_server(st, fd);
+            });
+
+        if(opt.serve)
+        {
+            std::printf(
+                "serving on 127.0.0.1:%u with %u threads\n",
+                unsigned(opt.port),
+                unsigned(opt.threads));
+            for(auto& t : servers)
+                t.join();
+            return 0;
+        }
+
+        auto const batch = make_batch(opt);
+        std::unique_ptr<counter[]> counters(
+            new counter[opt.clients]);
+        std::vector<std::thread> clients;
+        for(std::size_t i = 0; i < opt.clients; ++i)
+        {
+            auto const n = opt.connections / opt.clients +
+                (i < opt.connections % opt.clients ? 1 : 0);
+            if(n == 0)
+                continue;
+            auto& c = counters[i];
+            clients.emplace_back([&opt, &batch, n, &c]
+            {
+                run_client(opt, batch, n, c);
+            });
+        }
+
+        auto const total = [&]
+        {
+            std::uint64_t r = 0;
+            for(std::size_t i = 0; i < opt.clients; ++i)
+                r += counters[i].responses.load();
+            return r;
+        };
+
+        // warm up, then measure
+        std::this_thread::sleep_for(
+            std::chrono::milliseconds(500));
+        auto const r0 = total();
+        auto const t0 = std::chrono::steady_clock::now();
+        std::this_thread::sleep_for(
+            std::chrono::seconds(opt.seconds));
+        auto const r1 = total();
+        auto const t1 = std::chrono::steady_clock::now();
+
+        stop = true;
+        for(auto& t : clients)
+            t.join();
+        for(auto& t : servers)
+            t.join();
+        for(auto fd : listeners)
+            ::close(fd);
+        std::remove(st.path.c_str());
+
+        std::uint64_t errors = 0;
+        for(std::size_t i = 0; i < opt.clients; ++i)
+            errors += counters[i].errors.load();
+
+        std::printf(
+            "%-9s %-8s %6s %6s %6s %7s %12s %7s\n",
+            "target", "coding", "loops", "conns",
+            "depth", "keep", "req/s", "errors");
+        std::printf(
+            "%-9s %-8s %6u %6u %6u %7s %12.0f %7u\n",
+            opt.target.c_str(),
+            opt.coding.empty() ? "-" : opt.coding.c_str(),
+            unsigned(opt.threads),
+            unsigned(opt.connections),
+            unsigned(opt.keep_alive ? opt.depth : 1),
+            opt.keep_alive ? "yes" : "no",
+            static_cast<double>(r1 - r0) /
+                std::chrono::duration<double>(t1 - t0).count(),
+            unsigned(errors));
+    }
+    catch(std::exception const& e)
+    {
+        std::fprintf(stderr, "error: %s\n", e.what());
+        return 1;
+    }
+    return 0;
+}
+
+#else
+
+int
+main()
+{
+    std::fprintf(stderr,
+        "this benchmark requires Linux\n");
+    return 0;
+}
+
+#endif
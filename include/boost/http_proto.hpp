@@ -10,15 +10,22 @@
 #ifndef BOOST_HTTP_PROTO_HPP
 #define BOOST_HTTP_PROTO_HPP
 
+#include <boost/http_proto/compression_dictionary.hpp>
+#include <boost/http_proto/connection_buffers.hpp>
+#include <boost/http_proto/date.hpp>
+#include <boost/http_proto/edit_batch.hpp>
 #include <boost/http_proto/error.hpp>
 #include <boost/http_proto/field.hpp>
+#include <boost/http_proto/field_registry.hpp>
 #include <boost/http_proto/fields.hpp>
 #include <boost/http_proto/fields_base.hpp>
 #include <boost/http_proto/file.hpp>
+#include <boost/http_proto/file_cache.hpp>
 #include <boost/http_proto/file_mode.hpp>
 #include <boost/http_proto/file_sink.hpp>
 #include <boost/http_proto/file_source.hpp>
 #include <boost/http_proto/header_limits.hpp>
+#include <boost/http_proto/memory_resource.hpp>
 #include <boost/http_proto/message_base.hpp>
 #include <boost/http_proto/method.hpp>
 #include <boost/http_proto/parser.hpp>
@@ -26,9 +33,15 @@
 #include <boost/http_proto/request_parser.hpp>
 #include <boost/http_proto/response.hpp>
 #include <boost/http_proto/response_parser.hpp>
+#include <boost/http_proto/response_template.hpp>
 #include <boost/http_proto/serializer.hpp>
 #include <boost/http_proto/sink.hpp>
+#include <boost/http_proto/small_fields.hpp>
+#include <boost/http_proto/small_request.hpp>
+#include <boost/http_proto/small_response.hpp>
 #include <boost/http_proto/source.hpp>
+#include <boost/http_proto/spool.hpp>
+#include <boost/http_proto/spool_sink.hpp>
 #include <boost/http_proto/static_request.hpp>
 #include <boost/http_proto/static_response.hpp>
 #include <boost/http_proto/status.hpp>
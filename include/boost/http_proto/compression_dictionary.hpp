@@ -0,0 +1,88 @@
+//
+// Copyright (c) 2025 Mohammad Nejati
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#ifndef BOOST_HTTP_PROTO_COMPRESSION_DICTIONARY_HPP
+#define BOOST_HTTP_PROTO_COMPRESSION_DICTIONARY_HPP
+
+#include <boost/http_proto/detail/config.hpp>
+
+#include <boost/core/detail/string_view.hpp>
+#include <boost/rts/context_fwd.hpp>
+
+#include <cstdint>
+
+namespace boost {
+namespace http_proto {
+
+/** Install a shared compression dictionary.
+
+    A dictionary holds content which is expected
+    to recur in message bodies, such as the field
+    names and common values of a JSON API. Small
+    bodies which barely compress on their own
+    may shrink considerably when coded against
+    a dictionary both peers have.
+
+    Once installed, the dictionary can be chosen
+    for a message by its id with
+    @ref serializer::set_dictionary and
+    @ref parser::set_dictionary. It applies to the
+    deflate, br and zstd content codings; the gzip
+    format has no means to signal a dictionary.
+    How peers agree on the id is up to the
+    application.
+
+    Serializers and parsers only see the
+    dictionaries installed before their service,
+    which digests them for the configured codecs.
+    For zstd, content in the format produced by
+    `zstd --train` is recognized, anything else is
+    used as raw content.
+
+    @par Example
+    @code
+    rts::context ctx;
+    rts::brotli::install_encode_service(ctx);
+    install_compression_dictionary(ctx, 1, json_dictionary);
+
+    serializer::config cfg;
+    cfg.apply_brotli_encoder = true;
+    install_serializer_service(ctx, cfg);
+
+    serializer sr(ctx);
+    sr.set_dictionary(1);
+    sr.start(res, body);
+    @endcode
+
+    @par Exception Safety
+    Strong guarantee.
+
+    @throw std::invalid_argument A dictionary with
+    the same id is already installed, or `data`
+    is empty.
+
+    @param ctx The context on which the dictionary
+    is installed.
+
+    @param id The id of the dictionary.
+
+    @param data The content of the dictionary,
+    which is copied.
+*/
+BOOST_HTTP_PROTO_DECL
+void
+install_compression_dictionary(
+    rts::context& ctx,
+    std::uint32_t id,
+    core::string_view data);
+
+} // http_proto
+} // boost
+
+#endif
@@ -0,0 +1,165 @@
+//
+// Copyright (c) 2025 Mohammad Nejati
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#ifndef BOOST_HTTP_PROTO_CONNECTION_BUFFERS_HPP
+#define BOOST_HTTP_PROTO_CONNECTION_BUFFERS_HPP
+
+#include <boost/http_proto/detail/config.hpp>
+#include <boost/http_proto/memory_resource.hpp>
+#include <boost/http_proto/request_parser.hpp>
+#include <boost/http_proto/serializer.hpp>
+
+#include <boost/rts/context_fwd.hpp>
+
+#include <cstddef>
+#include <new>
+
+namespace boost {
+namespace http_proto {
+
+/** The parser and serializer of a server connection.
+
+    This holds a @ref request_parser and a
+    @ref serializer whose states and buffers
+    live in one contiguous block of storage,
+    allocated once on construction:
+
+    @code
+    | parser | parser buffer | serializer | serializer buffer |
+    @endcode
+
+    Accepting a connection then costs a single
+    allocation, the memory of a connection is
+    kept together, and its footprint is known
+    from the installed services.
+
+    @par Example
+    @code
+    rts::context ctx;
+    install_parser_service(ctx, request_parser::config());
+    install_serializer_service(ctx, serializer::config());
+
+    // on accept
+    connection_buffers cb(ctx);
+    request_parser& pr = cb.parser();
+    serializer& sr = cb.serializer();
+    @endcode
+
+    @note The parser and serializer must not be
+    moved from, as their states are owned by the
+    connection_buffers.
+*/
+class connection_buffers
+{
+public:
+    /** Constructor.
+
+        @par Exception Safety
+        Calls to allocate may throw.
+
+        @param ctx Context from which the parser
+        and serializer will access registered
+        services. The caller is responsible for
+        ensuring that the provided ctx remains
+        valid for the lifetime of the object.
+
+        @param mr The resource from which the
+        storage is allocated, which must outlive
+        the object. If null, operator new is used.
+
+        @see
+            @ref install_parser_service,
+            @ref install_serializer_service.
+    */
+    BOOST_HTTP_PROTO_DECL
+    explicit
+    connection_buffers(
+        const rts::context& ctx,
+        memory_resource* mr = nullptr);
+
+    /** Constructor.
+    */
+    connection_buffers(
+        connection_buffers const&) = delete;
+
+    /** Assignment.
+    */
+    connection_buffers&
+    operator=(
+        connection_buffers const&) = delete;
+
+    /** Return the bytes allocated for a connection.
+
+        @param ctx The context on which the parser
+        and serializer services are installed.
+    */
+    BOOST_HTTP_PROTO_DECL
+    static
+    std::size_t
+    storage_needed(
+        const rts::context& ctx);
+
+    /** Return the size of the storage.
+    */
+    std::size_t
+    size() const noexcept
+    {
+        return storage_.n;
+    }
+
+    /** Return the request parser.
+    */
+    request_parser&
+    parser() noexcept
+    {
+        return pr_;
+    }
+
+    /** Return the serializer.
+    */
+    http_proto::serializer&
+    serializer() noexcept
+    {
+        return sr_;
+    }
+
+private:
+    struct storage
+    {
+        memory_resource* mr;
+        std::size_t n;
+        void* p;
+
+        storage(
+            memory_resource* mr_,
+            std::size_t n_)
+            : mr(mr_)
+            , n(n_)
+            , p(mr ? mr->allocate(n) : ::operator new(n))
+        {
+        }
+
+        ~storage()
+        {
+            if(mr)
+                mr->deallocate(p, n);
+            else
+                ::operator delete(p);
+        }
+    };
+
+    storage storage_;
+    request_parser pr_;
+    http_proto::serializer sr_;
+};
+
+} // http_proto
+} // boost
+
+#endif
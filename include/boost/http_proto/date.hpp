@@ -0,0 +1,107 @@
+//
+// Copyright (c) 2025 Mohammad Nejati
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#ifndef BOOST_HTTP_PROTO_DATE_HPP
+#define BOOST_HTTP_PROTO_DATE_HPP
+
+#include <boost/http_proto/detail/config.hpp>
+
+#include <boost/core/detail/string_view.hpp>
+
+#include <cstddef>
+#include <ctime>
+
+namespace boost {
+namespace http_proto {
+
+/** The size of a date in the IMF-fixdate format.
+
+    @see
+        @ref format_date,
+        @ref current_date.
+*/
+constexpr std::size_t date_size = 29;
+
+/** Format a time as an HTTP date.
+
+    The time is written to `dest` in the
+    IMF-fixdate format preferred for the Date
+    field, for example:
+
+    @code
+    Sun, 06 Nov 1994 08:49:37 GMT
+    @endcode
+
+    Times before 1970 or after 9999 are clamped
+    to the nearest representable date.
+
+    @par Example
+    @code
+    char buf[date_size];
+    res.set(field::last_modified,
+        format_date(mtime, buf));
+    @endcode
+
+    @par Exception Safety
+    Throws nothing.
+
+    @return A view of the formatted date within
+    `dest`.
+
+    @param t The time, in seconds since the epoch.
+
+    @param dest The destination, which must have
+    room for @ref date_size characters.
+
+    @see
+        <a href="https://www.rfc-editor.org/rfc/rfc9110#section-5.6.7"
+            >RFC 9110 Section 5.6.7: Date/Time Formats</a>.
+*/
+BOOST_HTTP_PROTO_DECL
+core::string_view
+format_date(
+    std::time_t t,
+    char* dest) noexcept;
+
+/** Return the current time as an HTTP date.
+
+    The date is formatted at most once per
+    second for the whole process and shared
+    between threads without locks; calls in the
+    same second only copy the cached value, or
+    return it directly when the calling thread
+    has seen it already. This makes it suitable
+    for setting the Date field of every
+    response.
+
+    @par Example
+    @code
+    res.set(field::date, current_date());
+    @endcode
+
+    @par Exception Safety
+    Throws nothing.
+
+    @return A view of the date in IMF-fixdate
+    format. The view is owned by the calling
+    thread and remains valid until the next call
+    to this function on the same thread.
+
+    @see
+        @ref format_date,
+        @ref response_template::set_date.
+*/
+BOOST_HTTP_PROTO_DECL
+core::string_view
+current_date() noexcept;
+
+} // http_proto
+} // boost
+
+#endif
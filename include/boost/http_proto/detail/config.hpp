@@ -33,6 +33,19 @@ namespace http_proto {
 #  define BOOST_HTTP_PROTO_DECL
 # endif
 
+// The optional zstd library
+# if (defined(BOOST_HTTP_PROTO_DYN_LINK) || defined(BOOST_ALL_DYN_LINK)) && !defined(BOOST_HTTP_PROTO_STATIC_LINK)
+#  if defined(BOOST_HTTP_PROTO_ZSTD_SOURCE)
+#   define BOOST_HTTP_PROTO_ZSTD_DECL   BOOST_SYMBOL_EXPORT
+#  else
+#   define BOOST_HTTP_PROTO_ZSTD_DECL   BOOST_SYMBOL_IMPORT
+#  endif
+# endif // shared lib
+
+# ifndef  BOOST_HTTP_PROTO_ZSTD_DECL
+#  define BOOST_HTTP_PROTO_ZSTD_DECL
+# endif
+
 # if !defined(BOOST_HTTP_PROTO_SOURCE) && !defined(BOOST_ALL_NO_LIB) && !defined(BOOST_HTTP_PROTO_NO_LIB)
 #  define BOOST_LIB_NAME boost_http_proto
 #  if defined(BOOST_ALL_DYN_LINK) || defined(BOOST_HTTP_PROTO_DYN_LINK)
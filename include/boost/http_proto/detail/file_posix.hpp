@@ -30,6 +30,8 @@
 
 #include <boost/http_proto/error.hpp>
 #include <boost/http_proto/file_mode.hpp>
+#include <boost/buffers/buffer.hpp>
+#include <boost/core/span.hpp>
 #include <boost/system/error_code.hpp>
 #include <cstdint>
 
@@ -86,6 +88,10 @@ public:
     void
     open(char const* path, file_mode mode, system::error_code& ec);
 
+    BOOST_HTTP_PROTO_DECL
+    void
+    open_temp(char const* dir, system::error_code& ec);
+
     BOOST_HTTP_PROTO_DECL
     std::uint64_t
     size(system::error_code& ec) const;
@@ -105,6 +111,30 @@ public:
     BOOST_HTTP_PROTO_DECL
     std::size_t
     write(void const* buffer, std::size_t n, system::error_code& ec);
+
+    BOOST_HTTP_PROTO_DECL
+    std::size_t
+    read_at(std::uint64_t offset, void* buffer, std::size_t n, system::error_code& ec);
+
+    BOOST_HTTP_PROTO_DECL
+    std::size_t
+    write_at(std::uint64_t offset, void const* buffer, std::size_t n, system::error_code& ec);
+
+    BOOST_HTTP_PROTO_DECL
+    std::size_t
+    read_at(std::uint64_t offset, boost::span<buffers::mutable_buffer const> bs, system::error_code& ec);
+
+    BOOST_HTTP_PROTO_DECL
+    std::size_t
+    write_at(std::uint64_t offset, boost::span<buffers::const_buffer const> bs, system::error_code& ec);
+
+    BOOST_HTTP_PROTO_DECL
+    void
+    allocate(std::uint64_t n, system::error_code& ec);
+
+    BOOST_HTTP_PROTO_DECL
+    void
+    sync(system::error_code& ec);
 };
 
 } // detail
@@ -32,6 +32,8 @@ struct header_limits;
 
 namespace detail {
 
+class field_registry;
+
 enum kind : unsigned char
 {
     fields = 0,
@@ -67,6 +69,13 @@ struct header
     field unknown_field =
         static_cast<field>(0);
 
+    // ids from here on are names
+    // registered on a context
+    static constexpr
+    field first_registered_field =
+        static_cast<field>(0x8000);
+
+
     struct entry
     {
         offset_type np;   // name pos
@@ -74,6 +83,7 @@ struct header
         offset_type vp;   // value pos
         offset_type vn;   // value size
         field id;
+        unsigned char flags; // see on_insert
 
         entry operator+(
             std::size_t dv) const noexcept;
@@ -104,6 +114,47 @@ struct header
         entry* p_;
     };
 
+    // What a field contributes to the
+    // metadata, kept in its entry so that
+    // erasing it does not re-parse the
+    // others. The bits depend on the id.
+    enum : unsigned char
+    {
+        flag_bad = 0x01,
+
+        // Connection
+        flag_close = 0x02,
+        flag_keep_alive = 0x04,
+        flag_upgrade = 0x08,
+
+        // Expect
+        flag_100_continue = 0x02,
+
+        // Transfer-Encoding, ends in chunked
+        flag_chunked = 0x02,
+
+        // Upgrade
+        flag_websocket = 0x02
+
+        // Content-Encoding keeps the
+        // content_coding in the upper bits
+    };
+
+    // number of fields with each flag
+    struct flag_count_t
+    {
+        offset_type bad_connection = 0;
+        offset_type close = 0;
+        offset_type keep_alive = 0;
+        offset_type upgrade = 0;
+        offset_type bad_content_encoding = 0;
+        offset_type bad_content_length = 0;
+        offset_type bad_transfer_encoding = 0;
+        offset_type chunked = 0;
+        offset_type bad_upgrade = 0;
+        offset_type websocket = 0;
+    };
+
     struct fld_t
     {
     };
@@ -127,6 +178,7 @@ struct header
     char const* cbuf = nullptr;
     char* buf = nullptr;
     std::size_t cap = 0;
+    std::size_t slack = 0; // free bytes before buf
 
     offset_type size = 0;
     offset_type count = 0;
@@ -135,6 +187,7 @@ struct header
     http_proto::version version =
         http_proto::version::http_1_1;
     metadata md;
+    flag_count_t nf;
 
     union
     {
@@ -193,22 +246,30 @@ public:
 
     std::size_t maybe_count(field) const noexcept;
     bool is_special(field) const noexcept;
+    static bool is_enumerated(field) noexcept;
     void on_start_line();
-    void on_insert(field, core::string_view);
-    void on_erase(field);
-    void on_insert_connection(core::string_view);
-    void on_insert_content_length(core::string_view);
-    void on_insert_expect(core::string_view);
-    void on_insert_transfer_encoding(core::string_view);
-    void on_insert_content_encoding(core::string_view);
-    void on_insert_upgrade(core::string_view);
-    void on_erase_connection();
-    void on_erase_content_length();
-    void on_erase_expect();
-    void on_erase_transfer_encoding();
-    void on_erase_content_encoding();
-    void on_erase_upgrade();
+    unsigned char on_insert(field, core::string_view);
+    void on_erase(field, unsigned char);
+    unsigned char on_insert_connection(core::string_view);
+    unsigned char on_insert_content_length(core::string_view);
+    unsigned char on_insert_expect(core::string_view);
+    unsigned char on_insert_transfer_encoding(core::string_view);
+    unsigned char on_insert_content_encoding(core::string_view);
+    unsigned char on_insert_upgrade(core::string_view);
+    void on_erase_connection(unsigned char);
+    void on_erase_content_length(unsigned char);
+    void on_erase_expect(unsigned char);
+    void on_erase_transfer_encoding(unsigned char);
+    void on_erase_content_encoding(unsigned char);
+    void on_erase_upgrade(unsigned char);
     void on_erase_all(field);
+    void update_connection();
+    void update_content_encoding(unsigned char);
+    void update_content_length();
+    void update_expect(unsigned char);
+    void update_transfer_encoding(bool);
+    void update_upgrade();
+    entry const* find_last(field) const noexcept;
     void update_payload() noexcept;
 
     // parsing
@@ -219,7 +280,8 @@ public:
     void parse(
         std::size_t,
         header_limits const&,
-        system::error_code&) noexcept;
+        system::error_code&,
+        field_registry const* = nullptr) noexcept;
 };
 
 } // detail
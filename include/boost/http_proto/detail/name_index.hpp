@@ -0,0 +1,91 @@
+//
+// Copyright (c) 2025 Mohammad Nejati
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#ifndef BOOST_HTTP_PROTO_DETAIL_NAME_INDEX_HPP
+#define BOOST_HTTP_PROTO_DETAIL_NAME_INDEX_HPP
+
+#include <boost/http_proto/detail/config.hpp>
+#include <boost/core/detail/string_view.hpp>
+
+#include <cstdint>
+
+namespace boost {
+namespace http_proto {
+namespace detail {
+
+struct header;
+
+// A case-insensitive hash index from field
+// names to the first field with that name,
+// used by containers with many fields. It
+// uses open addressing with linear probing,
+// each slot holding the field index plus one,
+// or zero when empty. The slot storage is
+// owned by the container.
+struct name_index
+{
+    using slot_type = std::uint32_t;
+
+    // field count at which
+    // the index is built
+    static constexpr
+    std::size_t threshold = 32;
+
+    slot_type* slots = nullptr;
+    std::size_t size = 0; // zero or a power of 2
+
+    // return the number of slots
+    // needed to index n fields
+    static
+    std::size_t
+    slots_needed(
+        std::size_t n) noexcept;
+
+    // return the index of the first field
+    // named name, or h.count if there is none
+    std::size_t
+    find(
+        header const& h,
+        core::string_view name) const noexcept;
+
+    // index all the fields of h
+    void
+    rebuild(
+        header const& h) noexcept;
+
+    // field i was inserted into h
+    void
+    on_insert(
+        header const& h,
+        std::size_t i) noexcept;
+
+    // field i is about to
+    // be erased from h
+    void
+    on_erase(
+        header const& h,
+        std::size_t i) noexcept;
+
+private:
+    std::size_t
+    probe(
+        header const& h,
+        core::string_view name) const noexcept;
+
+    void
+    erase_slot(
+        header const& h,
+        std::size_t s) noexcept;
+};
+
+} // detail
+} // http_proto
+} // boost
+
+#endif
@@ -52,6 +52,7 @@ class workspace
     unsigned char* head_ = nullptr;
     unsigned char* back_ = nullptr;
     unsigned char* end_ = nullptr;
+    bool external_ = false;
 
     template<class>
     struct any_impl;
@@ -59,6 +60,18 @@ class workspace
     struct undo;
 
 public:
+    /** Return n rounded up to the alignment of any type
+    */
+    static
+    constexpr
+    std::size_t
+    aligned_size(
+        std::size_t n) noexcept
+    {
+        return (n + alignof(::max_align_t) - 1) &
+            ~(alignof(::max_align_t) - 1);
+    }
+
     /** Return the number of aligned bytes required for T
     */
     template<class T>
@@ -80,6 +93,21 @@ public:
     workspace(
         std::size_t n);
 
+    /** Constructor.
+
+        The workspace uses the storage at `p`
+        without taking ownership. The storage
+        must outlive the workspace and be aligned
+        for any type.
+
+        @param p A pointer to the storage.
+
+        @param n The size of the storage.
+    */
+    workspace(
+        void* p,
+        std::size_t n) noexcept;
+
     /** Constructor.
     */
     workspace() = default;
@@ -0,0 +1,302 @@
+//
+// Copyright (c) 2025 Mohammad Nejati
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#ifndef BOOST_HTTP_PROTO_EDIT_BATCH_HPP
+#define BOOST_HTTP_PROTO_EDIT_BATCH_HPP
+
+#include <boost/http_proto/detail/config.hpp>
+#include <boost/http_proto/field.hpp>
+#include <boost/http_proto/fields_base.hpp>
+
+#include <boost/core/detail/string_view.hpp>
+#include <boost/system/error_code.hpp>
+
+#include <vector>
+
+namespace boost {
+namespace http_proto {
+
+/** A set of field edits applied to a container at once.
+
+    Each call to @ref fields_base::set,
+    @ref fields_base::append or
+    @ref fields_base::erase moves the text
+    after the field, rewrites the field table
+    and updates the metadata of the message.
+    A batch records a sequence of such edits
+    and applies them in @ref commit with a
+    single pass over the container: the final
+    size is computed first, the buffer is
+    reallocated at most once, the fields are
+    compacted in one go and the metadata of
+    each special field which was touched is
+    rebuilt once.
+
+    The result is the same as making the
+    equivalent calls on the container in the
+    order they were recorded.
+
+    The batch refers to the names and values
+    it is given without copying them; they must
+    remain valid until @ref commit returns.
+    The recorded edits are cleared on commit,
+    and the batch may be reused.
+
+    @par Example
+    @code
+    edit_batch b(req);
+    b.erase(field::connection)
+     .erase(field::keep_alive)
+     .erase(field::proxy_authorization)
+     .set(field::via, "1.1 proxy")
+     .append("X-Forwarded-For", client_addr);
+    b.commit();
+    @endcode
+
+    @see
+        @ref fields_base.
+*/
+class edit_batch
+{
+public:
+    /** Constructor.
+
+        The batch is empty.
+
+        @param f The container to which the
+        edits are applied. Ownership is not
+        transferred; the caller is responsible
+        for ensuring that the lifetime of the
+        container extends until the batch is
+        destroyed.
+    */
+    explicit
+    edit_batch(
+        fields_base& f) noexcept
+        : f_(f)
+    {
+    }
+
+    /** Constructor (deleted)
+    */
+    edit_batch(
+        edit_batch const&) = delete;
+
+    /** Assignment (deleted)
+    */
+    edit_batch&
+    operator=(
+        edit_batch const&) = delete;
+
+    /** Return the number of recorded edits.
+    */
+    std::size_t
+    size() const noexcept
+    {
+        return ops_.size();
+    }
+
+    /** Discard the recorded edits.
+    */
+    void
+    clear() noexcept
+    {
+        ops_.clear();
+    }
+
+    /** Record appending a field.
+
+        @see
+            @ref fields_base::append.
+
+        @return A reference to this object.
+
+        @param id The field name constant.
+
+        @param value The value.
+    */
+    BOOST_HTTP_PROTO_DECL
+    edit_batch&
+    append(
+        field id,
+        core::string_view value);
+
+    /** Record appending a field.
+
+        @see
+            @ref fields_base::append.
+
+        @return A reference to this object.
+
+        @param name The field name.
+
+        @param value The value.
+    */
+    BOOST_HTTP_PROTO_DECL
+    edit_batch&
+    append(
+        core::string_view name,
+        core::string_view value);
+
+    /** Record setting a field.
+
+        All fields with the same name are
+        erased, and the field is appended.
+
+        @see
+            @ref fields_base::set.
+
+        @return A reference to this object.
+
+        @param id The field name constant.
+
+        @param value The value.
+    */
+    BOOST_HTTP_PROTO_DECL
+    edit_batch&
+    set(
+        field id,
+        core::string_view value);
+
+    /** Record setting a field.
+
+        All fields with the same name are
+        erased, and the field is appended.
+
+        @see
+            @ref fields_base::set.
+
+        @return A reference to this object.
+
+        @param name The field name.
+
+        @param value The value.
+    */
+    BOOST_HTTP_PROTO_DECL
+    edit_batch&
+    set(
+        core::string_view name,
+        core::string_view value);
+
+    /** Record erasing all fields with a name.
+
+        @see
+            @ref fields_base::erase.
+
+        @return A reference to this object.
+
+        @param id The field name constant.
+    */
+    BOOST_HTTP_PROTO_DECL
+    edit_batch&
+    erase(
+        field id);
+
+    /** Record erasing all fields with a name.
+
+        @see
+            @ref fields_base::erase.
+
+        @return A reference to this object.
+
+        @param name The field name.
+    */
+    BOOST_HTTP_PROTO_DECL
+    edit_batch&
+    erase(
+        core::string_view name);
+
+    /** Apply the recorded edits.
+
+        All names and values are validated
+        before the container is modified.
+
+        @par Complexity
+        Linear in `f.buffer().size()` plus the
+        size of the edits, times the number of
+        erasing edits.
+
+        @par Exception Safety
+        Strong guarantee.
+        Calls to allocate may throw.
+        Exception thrown on invalid input.
+        Exception thrown if max capacity exceeded.
+
+        @throw system_error
+        Input is invalid.
+
+        @throw std::length_error
+        Max capacity would be exceeded.
+    */
+    BOOST_HTTP_PROTO_DECL
+    void
+    commit();
+
+    /** Apply the recorded edits.
+
+        All names and values are validated
+        before the container is modified. On
+        error the container is unchanged and
+        the edits are kept.
+
+        @par Complexity
+        Linear in `f.buffer().size()` plus the
+        size of the edits, times the number of
+        erasing edits.
+
+        @par Exception Safety
+        Strong guarantee.
+        Calls to allocate may throw.
+        Exception thrown if max capacity exceeded.
+
+        @throw std::length_error
+        Max capacity would be exceeded.
+
+        @param ec Set to the error if input is
+        invalid.
+    */
+    BOOST_HTTP_PROTO_DECL
+    void
+    commit(
+        system::error_code& ec);
+
+private:
+    friend class fields_base;
+
+    enum class op_kind : unsigned char
+    {
+        append,
+        set,
+        erase
+    };
+
+    struct op
+    {
+        op_kind kind;
+        bool has_obs_fold;
+        field id;
+        core::string_view name;
+        core::string_view value;
+    };
+
+    edit_batch&
+    push(
+        op_kind kind,
+        field id,
+        core::string_view name,
+        core::string_view value);
+
+    fields_base& f_;
+    std::vector<op> ops_;
+};
+
+} // http_proto
+} // boost
+
+#endif
@@ -0,0 +1,123 @@
+//
+// Copyright (c) 2025 Mohammad Nejati
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#ifndef BOOST_HTTP_PROTO_FIELD_REGISTRY_HPP
+#define BOOST_HTTP_PROTO_FIELD_REGISTRY_HPP
+
+#include <boost/http_proto/detail/config.hpp>
+#include <boost/http_proto/field.hpp>
+
+#include <boost/core/detail/string_view.hpp>
+#include <boost/optional.hpp>
+#include <boost/rts/context_fwd.hpp>
+
+namespace boost {
+namespace http_proto {
+
+/** Register an application-specific field name.
+
+    Fields whose names are not in the @ref field
+    enumeration have no id, and are found by
+    comparing strings. A name registered on a
+    context is given an id above the enumerated
+    constants, which parsers created from the
+    context store with every field of that name.
+    Such fields can then be found by id, for
+    example with @ref fields_base::find or
+    @ref fields_base::count, at the cost of an
+    integer comparison per field.
+
+    Names must be registered before any parser
+    is created from the context. Containers have
+    no context, so fields inserted by name are
+    not given registered ids, and the overloads
+    of container modifiers which take a @ref field
+    only accept enumerated constants.
+
+    @par Example
+    @code
+    rts::context ctx;
+    field const request_id =
+        register_field(ctx, "X-Request-Id");
+    install_parser_service(ctx, request_parser::config());
+
+    request_parser pr(ctx);
+    // ...
+    auto it = pr.get().find(request_id);
+    @endcode
+
+    @par Exception Safety
+    Strong guarantee.
+
+    @return The id for the name. This is the
+    enumerated constant if there is one, or the
+    id given when the name was first registered.
+
+    @throw std::invalid_argument `name` is not
+    a valid field name.
+
+    @throw std::length_error Too many names
+    are registered.
+
+    @param ctx The context on which the name
+    is registered.
+
+    @param name The name to register, which
+    is copied.
+*/
+BOOST_HTTP_PROTO_DECL
+field
+register_field(
+    rts::context& ctx,
+    core::string_view name);
+
+/** Return the field id for a header name.
+
+    This is the enumerated constant for the
+    name if there is one, or the id of the name
+    if it is registered on `ctx`.
+
+    The string comparison is case-insensitive.
+
+    @param ctx The context to use.
+
+    @param s The string representing a header name.
+
+    @see
+        @ref register_field.
+*/
+BOOST_HTTP_PROTO_DECL
+boost::optional<field>
+string_to_field(
+    rts::context const& ctx,
+    core::string_view s) noexcept;
+
+/** Return the header name for a field id.
+
+    @throw std::invalid_argument `f` is above
+    the enumerated constants and not registered
+    on `ctx`.
+
+    @param ctx The context to use.
+
+    @param f The field id to convert.
+
+    @see
+        @ref register_field.
+*/
+BOOST_HTTP_PROTO_DECL
+core::string_view
+to_string(
+    rts::context const& ctx,
+    field f);
+
+} // http_proto
+} // boost
+
+#endif
@@ -80,6 +80,37 @@ public:
     {
     }
 
+    /** Constructor.
+
+        Constructs an empty fields container
+        whose storage is allocated from `mr`. The
+        resource moves with the storage when the
+        container is moved or swapped, while
+        copies of the container use operator new.
+
+        @par Example
+        @code
+        fields fs(mr);
+        @endcode
+
+        @par Postconditions
+        @code
+        this->buffer() == "\r\n"
+        @endcode
+
+        @par Complexity
+        Constant.
+
+        @param mr The memory resource, which
+        must outlive the container.
+    */
+    explicit
+    fields(
+        memory_resource& mr) noexcept
+        : fields_base(detail::kind::fields, &mr)
+    {
+    }
+
 
     /** Constructor.
 
@@ -298,6 +329,8 @@ public:
     {
         h_.swap(other.h_);
         std::swap(max_cap_, other.max_cap_);
+        std::swap(mr_, other.mr_);
+        std::swap(ix_, other.ix_);
     }
 
     /** Swap.
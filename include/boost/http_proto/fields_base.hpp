@@ -15,6 +15,8 @@
 #include <boost/http_proto/detail/config.hpp>
 #include <boost/http_proto/detail/except.hpp>
 #include <boost/http_proto/detail/header.hpp>
+#include <boost/http_proto/detail/name_index.hpp>
+#include <boost/http_proto/memory_resource.hpp>
 #include <boost/core/detail/string_view.hpp>
 
 #include <iosfwd>
@@ -22,6 +24,11 @@
 namespace boost {
 namespace http_proto {
 
+class edit_batch;
+template<std::size_t> class small_fields;
+template<std::size_t> class small_request;
+template<std::size_t> class small_response;
+
 /** Mixin for modifiable HTTP fields.
 
     @par Iterators
@@ -37,6 +44,9 @@ class fields_base
     detail::header h_;
     std::size_t max_cap_ =
         std::numeric_limits<std::size_t>::max();
+    std::size_t start_line_slack_ = 0;
+    memory_resource* mr_ = nullptr;
+    detail::name_index ix_;
     bool external_storage_ = false;
 
     using entry =
@@ -52,6 +62,8 @@ class fields_base
         fields_base& self_;
         offset_type new_prefix_;
         char* buf_ = nullptr;
+        std::size_t cap_ = 0;
+        bool external_ = false;
 
     public:
         prefix_op_t(
@@ -63,6 +75,7 @@ class fields_base
         ~prefix_op_t();
     };
 
+    friend class edit_batch;
     friend class fields;
     friend class message_base;
     friend class request_base;
@@ -70,15 +83,24 @@ class fields_base
     friend class static_request;
     friend class response_base;
     friend class response;
+    friend class response_template;
     friend class static_response;
     friend class parser;
     friend class serializer;
+    template<std::size_t> friend class small_fields;
+    template<std::size_t> friend class small_request;
+    template<std::size_t> friend class small_response;
 
     BOOST_HTTP_PROTO_DECL
     explicit
     fields_base(
         detail::kind k) noexcept;
 
+    BOOST_HTTP_PROTO_DECL
+    fields_base(
+        detail::kind k,
+        memory_resource* mr) noexcept;
+
     BOOST_HTTP_PROTO_DECL
     fields_base(
         detail::kind k,
@@ -93,7 +115,8 @@ class fields_base
     BOOST_HTTP_PROTO_DECL
     explicit
     fields_base(
-        detail::header const& h);
+        detail::header const& h,
+        memory_resource* mr = nullptr);
 
     BOOST_HTTP_PROTO_DECL
     fields_base(
@@ -502,7 +525,7 @@ public:
     std::size_t
     capacity_in_bytes() const noexcept
     {
-        return h_.cap;
+        return h_.cap + h_.slack;
     }
 
     /** Clear contents while preserving the capacity.
@@ -1349,6 +1372,24 @@ private:
     copy_impl(
         detail::header const&);
 
+    void
+    commit_batch(
+        edit_batch& b,
+        system::error_code& ec);
+
+    BOOST_HTTP_PROTO_DECL
+    void
+    reset_inline(
+        void* storage,
+        std::size_t cap) noexcept;
+
+    BOOST_HTTP_PROTO_DECL
+    void
+    take_inline(
+        fields_base& other,
+        void* other_storage,
+        std::size_t cap) noexcept;
+
     BOOST_HTTP_PROTO_DECL
     void
     insert_impl(
@@ -1390,6 +1431,22 @@ private:
     std::size_t
     length(
         std::size_t i) const noexcept;
+
+    void
+    index_reserve(
+        std::size_t n);
+
+    void
+    index_release() noexcept;
+
+    char*
+    allocate(
+        std::size_t n);
+
+    void
+    deallocate(
+        char* p,
+        std::size_t n) noexcept;
 };
 
 } // http_proto
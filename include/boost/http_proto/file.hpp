@@ -215,6 +215,49 @@ public:
             detail::throw_system_error(ec);
     }
 
+    /** Open a new temporary file.
+
+        The file is created for reading and writing
+        with no other name in use, and is removed
+        by the system when it is closed, or when
+        the process exits. On Linux this uses
+        `O_TMPFILE` where the file system supports
+        it.
+
+        @param dir The UTF-8 encoded path to the
+        directory to create the file in, or `nullptr`
+        or an empty string for the system default.
+        The stdio implementation ignores this.
+
+        @param ec Set to the error, if any occurred.
+    */
+    void
+    open_temp(char const* dir, system::error_code& ec)
+    {
+        impl_.open_temp(dir, ec);
+    }
+
+    /** Open a new temporary file.
+
+        @param dir The UTF-8 encoded path to the
+        directory to create the file in, or `nullptr`
+        for the system default.
+
+        @par Exception Safety
+        Exception thrown if operation fails.
+
+        @throw system_error
+        Operation fails.
+    */
+    void
+    open_temp(char const* dir = nullptr)
+    {
+        system::error_code ec;
+        impl_.open_temp(dir, ec);
+        if(ec.failed())
+            detail::throw_system_error(ec);
+    }
+
     /** Return the size of the open file in bytes.
 
         @param ec Set to the error, if any occurred.
@@ -386,6 +429,248 @@ public:
             detail::throw_system_error(ec);
         return r;
     }
+
+    /** Read data from the file at an offset.
+
+        Unlike @ref read, the data is read from the
+        given offset rather than the current
+        position, so that one file can be shared by
+        readers of different ranges. On POSIX the
+        current position is left unchanged, other
+        platforms may move it.
+
+        @return The number of bytes read. Returns
+        0 on end-of-file or if an error occurs (in
+        which case @p ec is set).
+
+        @param offset The byte offset from the beginning of the file.
+
+        @param buffer The buffer to store the read data.
+
+        @param n The number of bytes to read.
+
+        @param ec Set to the error, if any occurred.
+    */
+    std::size_t
+    read_at(
+        std::uint64_t offset,
+        void* buffer,
+        std::size_t n,
+        system::error_code& ec)
+    {
+        return impl_.read_at(offset, buffer, n, ec);
+    }
+
+    /** Read data from the file at an offset.
+
+        @par Exception Safety
+        Exception thrown if operation fails.
+
+        @throw system_error
+        Operation fails.
+
+        @return The number of bytes read. Returns
+        0 on end-of-file.
+
+        @param offset The byte offset from the beginning of the file.
+
+        @param buffer The buffer to store the read data.
+
+        @param n The number of bytes to read.
+    */
+    std::size_t
+    read_at(
+        std::uint64_t offset,
+        void* buffer,
+        std::size_t n)
+    {
+        system::error_code ec;
+        auto r = impl_.read_at(offset, buffer, n, ec);
+        if(ec.failed())
+            detail::throw_system_error(ec);
+        return r;
+    }
+
+    /** Read data from the file at an offset into several buffers.
+
+        The buffers are filled in order, with a
+        single `preadv` call for up to 16 buffers
+        where available.
+
+        @return The number of bytes read, which is
+        less than the size of the buffers only on
+        end-of-file or if an error occurs (in which
+        case @p ec is set).
+
+        @param offset The byte offset from the beginning of the file.
+
+        @param bs The buffers to store the read data.
+
+        @param ec Set to the error, if any occurred.
+    */
+    std::size_t
+    read_at(
+        std::uint64_t offset,
+        boost::span<buffers::mutable_buffer const> bs,
+        system::error_code& ec)
+    {
+        return impl_.read_at(offset, bs, ec);
+    }
+
+    /** Write data to the file at an offset.
+
+        Unlike @ref write, the data is written at
+        the given offset rather than the current
+        position. On POSIX the current position is
+        left unchanged, other platforms may move it.
+
+        @return The number of bytes written.
+        Returns 0 on error (in which case @p ec is
+        set).
+
+        @param offset The byte offset from the beginning of the file.
+
+        @param buffer The buffer containing the data to write.
+
+        @param n The number of bytes to write.
+
+        @param ec Set to the error, if any occurred.
+    */
+    std::size_t
+    write_at(
+        std::uint64_t offset,
+        void const* buffer,
+        std::size_t n,
+        system::error_code& ec)
+    {
+        return impl_.write_at(offset, buffer, n, ec);
+    }
+
+    /** Write data to the file at an offset.
+
+        @par Exception Safety
+        Exception thrown if operation fails.
+
+        @throw system_error
+        Operation fails.
+
+        @return The number of bytes written.
+
+        @param offset The byte offset from the beginning of the file.
+
+        @param buffer The buffer containing the data to write.
+
+        @param n The number of bytes to write.
+    */
+    std::size_t
+    write_at(
+        std::uint64_t offset,
+        void const* buffer,
+        std::size_t n)
+    {
+        system::error_code ec;
+        auto r = impl_.write_at(offset, buffer, n, ec);
+        if(ec.failed())
+            detail::throw_system_error(ec);
+        return r;
+    }
+
+    /** Write data from several buffers to the file at an offset.
+
+        The buffers are written in order, with a
+        single `pwritev` call for up to 16 buffers
+        where available.
+
+        @return The number of bytes written.
+
+        @param offset The byte offset from the beginning of the file.
+
+        @param bs The buffers containing the data to write.
+
+        @param ec Set to the error, if any occurred.
+    */
+    std::size_t
+    write_at(
+        std::uint64_t offset,
+        boost::span<buffers::const_buffer const> bs,
+        system::error_code& ec)
+    {
+        return impl_.write_at(offset, bs, ec);
+    }
+
+    /** Reserve storage for the file.
+
+        The system is asked to allocate blocks for
+        the first `n` bytes of the file up front,
+        so that writing them later does not run out
+        of space midway or fragment the file. The
+        size of the file is left unchanged.
+
+        This has an effect on Linux only, elsewhere
+        and on file systems without support it
+        succeeds without doing anything.
+
+        @param n The number of bytes to reserve.
+
+        @param ec Set to the error, if any occurred.
+    */
+    void
+    allocate(std::uint64_t n, system::error_code& ec)
+    {
+        impl_.allocate(n, ec);
+    }
+
+    /** Reserve storage for the file.
+
+        @par Exception Safety
+        Exception thrown if operation fails.
+
+        @throw system_error
+        Operation fails.
+
+        @param n The number of bytes to reserve.
+    */
+    void
+    allocate(std::uint64_t n)
+    {
+        system::error_code ec;
+        impl_.allocate(n, ec);
+        if(ec.failed())
+            detail::throw_system_error(ec);
+    }
+
+    /** Write the file data through to the device.
+
+        This returns once the data written so far
+        is stored on the device, using `fdatasync`
+        on POSIX and `FlushFileBuffers` on Win32.
+        The stdio implementation only flushes its
+        own buffer to the system.
+
+        @param ec Set to the error, if any occurred.
+    */
+    void
+    sync(system::error_code& ec)
+    {
+        impl_.sync(ec);
+    }
+
+    /** Write the file data through to the device.
+
+        @par Exception Safety
+        Exception thrown if operation fails.
+
+        @throw system_error
+        Operation fails.
+    */
+    void
+    sync()
+    {
+        system::error_code ec;
+        impl_.sync(ec);
+        if(ec.failed())
+            detail::throw_system_error(ec);
+    }
 };
 
 } // http_proto
@@ -0,0 +1,206 @@
+//
+// Copyright (c) 2025 Mohammad Nejati
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#ifndef BOOST_HTTP_PROTO_FILE_CACHE_HPP
+#define BOOST_HTTP_PROTO_FILE_CACHE_HPP
+
+#include <boost/http_proto/detail/config.hpp>
+#include <boost/http_proto/file.hpp>
+#include <boost/core/detail/string_view.hpp>
+#include <boost/system/error_code.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+
+namespace boost {
+namespace http_proto {
+
+/** A cache of open files.
+
+    This keeps up to a configured number of files
+    open, together with their size, modification
+    time and file id, so that serving the same
+    files again does not open, stat and close
+    them each time. The least recently used file
+    is closed when the cache is full.
+
+    Entries are shared with the @ref file_source
+    objects reading them, which use positional
+    reads so that one open file serves any number
+    of responses. An entry stays open while it is
+    in use, even after leaving the cache.
+
+    An entry is checked against the file system
+    at most once per @ref config::check_interval,
+    and replaced when the file is gone or its
+    size, modification time or id changed.
+
+    @par Thread Safety
+    Member functions may be called concurrently.
+    Positional reads of a shared entry are safe
+    to perform concurrently on POSIX and Win32.
+
+    @par Example
+    @code
+    file_cache cache({});
+
+    auto e = cache.open("index.html");
+    response.set_payload_size(e->size);
+    serializer.start<file_source>(response, std::move(e));
+    @endcode
+
+    @see
+        @ref file_source,
+        @ref file.
+*/
+class file_cache
+{
+public:
+    struct config;
+    struct entry;
+
+    /** Constructor.
+
+        @param cfg The configuration settings.
+    */
+    BOOST_HTTP_PROTO_DECL
+    explicit
+    file_cache(config const& cfg);
+
+    file_cache(file_cache const&) = delete;
+    file_cache& operator=(file_cache const&) = delete;
+
+    /** Destructor.
+
+        Entries in use remain open until
+        they are released.
+    */
+    BOOST_HTTP_PROTO_DECL
+    ~file_cache();
+
+    /** Return an open file.
+
+        If the file is in the cache, and is still
+        current, the cached entry is returned.
+        Otherwise the file is opened for reading
+        and added to the cache.
+
+        @return The entry, or `nullptr` if the file
+        could not be opened (in which case @p ec
+        is set).
+
+        @param path The path of the file.
+
+        @param ec Set to the error, if any occurred.
+    */
+    BOOST_HTTP_PROTO_DECL
+    std::shared_ptr<entry>
+    open(
+        core::string_view path,
+        system::error_code& ec);
+
+    /** Return an open file.
+
+        @par Exception Safety
+        Exception thrown if operation fails.
+
+        @throw system_error
+        Operation fails.
+
+        @return The entry.
+
+        @param path The path of the file.
+    */
+    BOOST_HTTP_PROTO_DECL
+    std::shared_ptr<entry>
+    open(core::string_view path);
+
+    /** Remove a file from the cache.
+
+        @param path The path of the file.
+    */
+    BOOST_HTTP_PROTO_DECL
+    void
+    erase(core::string_view path);
+
+    /** Remove all files from the cache.
+    */
+    BOOST_HTTP_PROTO_DECL
+    void
+    clear() noexcept;
+
+    /** Return the number of files in the cache.
+    */
+    BOOST_HTTP_PROTO_DECL
+    std::size_t
+    size() const noexcept;
+
+private:
+    class impl;
+    impl* impl_;
+};
+
+//------------------------------------------------
+
+/** File cache configuration settings.
+
+    @see
+        @ref file_cache.
+*/
+struct file_cache::config
+{
+    /** Maximum number of files kept open.
+    */
+    std::size_t max_files = 1024;
+
+    /** Interval between checks of an entry against the file system.
+
+        Zero checks every time the file is opened.
+    */
+    std::chrono::milliseconds check_interval{ 1000 };
+};
+
+//------------------------------------------------
+
+/** An open file held by a @ref file_cache.
+*/
+struct file_cache::entry
+{
+    /** The open file.
+
+        The file is shared by all users of the
+        entry, which must only read from it with
+        @ref file::read_at.
+    */
+    file f;
+
+    /** The size of the file.
+    */
+    std::uint64_t size = 0;
+
+    /** The last modification time of the file.
+
+        The units are platform-specific. This is
+        zero where the time is not available.
+    */
+    std::uint64_t mtime = 0;
+
+    /** The id of the file.
+
+        This is the inode number on POSIX and the
+        file index on Win32, and zero elsewhere.
+    */
+    std::uint64_t id = 0;
+};
+
+} // http_proto
+} // boost
+
+#endif
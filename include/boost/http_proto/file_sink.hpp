@@ -15,6 +15,10 @@
 #include <boost/http_proto/file.hpp>
 #include <boost/http_proto/sink.hpp>
 
+#include <chrono>
+#include <cstdint>
+#include <memory>
+
 namespace boost {
 namespace http_proto {
 
@@ -30,6 +34,19 @@ namespace http_proto {
     parser.set_body<file_sink>("example.zip", file_mode::write_new);
     @endcode
 
+    For large uploads, a @ref config gathers the
+    buffers from the parser into large blocks, and
+    can reserve space for the body up front, see
+    @ref config::size:
+
+    @code
+    file_sink::config cfg;
+    if(parser.get().payload() == payload::size)
+        cfg.size = parser.get().payload_size();
+    cfg.sync = file_sink::sync_mode::at_end;
+    parser.set_body<file_sink>(std::move(f), cfg);
+    @endcode
+
     @see
         @ref file_source,
         @ref file,
@@ -39,11 +56,49 @@ namespace http_proto {
 class file_sink
     : public sink
 {
+public:
+    struct config;
+
+    /** When written data is synced to the device.
+
+        @see
+            @ref config::sync,
+            @ref file::sync.
+    */
+    enum class sync_mode
+    {
+        /** Never, the system writes the data back when it chooses.
+        */
+        none,
+
+        /** Once, after the last of the body is written.
+        */
+        at_end,
+
+        /** After a write, once the sync interval elapsed since the last sync.
+        */
+        interval
+    };
+
+private:
     file f_;
+    std::unique_ptr<char[]> storage_;
+    char* buf_ = nullptr;
+    std::size_t block_ = 0;
+    std::size_t used_ = 0;
+    std::uint64_t size_ = 0;
+    sync_mode sync_ = sync_mode::none;
+    std::chrono::milliseconds interval_{};
+    std::chrono::steady_clock::time_point synced_;
+    bool direct_ = false;
+    bool started_ = false;
 
 public:
     /** Constructor.
 
+        Each buffer is written to the file as it
+        arrives.
+
         @param f An open @ref file object that
         will receive the body data.
     */
@@ -51,6 +106,22 @@ public:
     explicit
     file_sink(file&& f) noexcept;
 
+    /** Constructor.
+
+        @par Exception Safety
+        Exception thrown if the block cannot be
+        allocated.
+
+        @param f An open @ref file object that
+        will receive the body data.
+
+        @param cfg The configuration settings.
+    */
+    BOOST_HTTP_PROTO_DECL
+    file_sink(
+        file&& f,
+        config const& cfg);
+
     file_sink() = delete;
     file_sink(file_sink const&) = delete;
 
@@ -64,13 +135,115 @@ public:
     BOOST_HTTP_PROTO_DECL
     ~file_sink();
 
+    /** Write the gathered data to the file.
+
+        Any partial block is written, then the file
+        is synced unless the mode is
+        @ref sync_mode::none. Writes bypassing the
+        page cache are not used after this call.
+
+        @param ec Set to the error, if any occurred.
+    */
+    BOOST_HTTP_PROTO_DECL
+    void
+    flush(system::error_code& ec);
+
+    /** Write the gathered data to the file.
+
+        @par Exception Safety
+        Exception thrown if operation fails.
+
+        @throw system_error
+        Operation fails.
+    */
+    BOOST_HTTP_PROTO_DECL
+    void
+    flush();
+
 private:
+    void start(system::error_code&);
+    void write_buf(system::error_code&);
+    void maybe_sync(system::error_code&);
+    void set_direct(bool) noexcept;
+
     BOOST_HTTP_PROTO_DECL
     results
     on_write(
         buffers::const_buffer, bool) override;
 };
 
+//------------------------------------------------
+
+/** File sink configuration settings.
+
+    @see
+        @ref file_sink.
+*/
+struct file_sink::config
+{
+    /** The expected size of the body.
+
+        When not zero, storage for this many bytes
+        past the current position is reserved with
+        @ref file::allocate before the first write.
+        This is usually the Content-Length of the
+        message, taken from the parser once the
+        header is parsed. When the parser decodes
+        a Content-Encoding, the Content-Length is
+        the coded size, which does not match the
+        body written to the file.
+
+        @par Example
+        @code
+        pr.parse(ec);
+        if(pr.got_header())
+        {
+            file_sink::config cfg;
+            if(pr.get().payload() == payload::size &&
+                pr.get().metadata().content_encoding.coding ==
+                    content_coding::identity)
+                cfg.size = pr.get().payload_size();
+            pr.set_body<file_sink>(std::move(f), cfg);
+        }
+        @endcode
+    */
+    std::uint64_t size = 0;
+
+    /** The size of the blocks written to the file.
+
+        Buffers are gathered until a block is full,
+        so that the file receives few large writes
+        instead of one per parser buffer. Zero
+        writes each buffer as it arrives.
+    */
+    std::size_t block_size = 1024 * 1024;
+
+    /** Bypass the page cache.
+
+        When `true`, blocks are written with
+        `O_DIRECT` where the platform supports it,
+        which keeps a large upload from evicting
+        other files from the cache. The block size
+        is rounded up to a multiple of 4096, and the
+        last partial block is written normally. This
+        is ignored when the current position of the
+        file is not aligned.
+    */
+    bool direct = false;
+
+    /** When written data is synced to the device.
+    */
+    sync_mode sync = sync_mode::none;
+
+    /** The interval for @ref sync_mode::interval.
+
+        Writes within the interval share a single
+        sync, which bounds the data lost on a crash
+        without syncing every block.
+    */
+    std::chrono::milliseconds sync_interval{ 1000 };
+};
+
 } // http_proto
 } // boost
 
@@ -13,8 +13,11 @@
 
 #include <boost/http_proto/detail/config.hpp>
 #include <boost/http_proto/file.hpp>
+#include <boost/http_proto/file_cache.hpp>
 #include <boost/http_proto/source.hpp>
+#include <cstddef>
 #include <cstdint>
+#include <memory>
 
 namespace boost {
 namespace http_proto {
@@ -25,6 +28,11 @@ namespace http_proto {
     and can be used with a @ref serializer to send
     the contents of a file as the HTTP message body.
 
+    The file can also be mapped into
+    memory, in which case the source lends the
+    mapped pages to the serializer, and the body
+    is sent without being copied.
+
     @par Example
     @code
     file f("example.zip", file_mode::scan);
@@ -42,7 +50,14 @@ class file_source
     : public source
 {
     file f_;
+    std::shared_ptr<file_cache::entry> entry_;
+    file* shared_ = nullptr;
+    std::uint64_t off_ = 0;
     std::uint64_t n_;
+    char const* map_ = nullptr;
+    std::size_t map_size_ = 0;
+    std::size_t map_pos_ = 0;
+    std::size_t released_ = 0;
 
 public:
     /** Constructor.
@@ -61,6 +76,130 @@ public:
         std::uint64_t limit =
             std::uint64_t(-1)) noexcept;
 
+    /** Constructor.
+
+        When `map` is true, the part of the file
+        to be read is mapped into memory, with the
+        system advised that it is read in order.
+        The mapped pages are then lent to the
+        serializer through @ref source::borrow,
+        and dropped from the mapping once the
+        serializer has consumed them. If the file
+        cannot be mapped, or mapping is not
+        supported on the platform, the file is
+        read as if `map` was false.
+
+        The mapping reflects later changes to
+        the file. If the file is truncated while
+        the source or the serializer still refers
+        to the mapped pages, reading those pages
+        raises `SIGBUS` on POSIX systems, which
+        terminates the process unless handled.
+        Only map files which are not truncated
+        or rewritten while they are being sent.
+
+        @par Example
+        @code
+        file f("example.zip", file_mode::scan);
+        response.set_payload_size(f.size());
+        serializer.start<file_source>(
+            response, std::move(f), std::uint64_t(-1), true);
+        @endcode
+
+        @param f An open @ref file from which the
+        body will be read.
+
+        @param limit An upper bound on the number
+        of bytes to read from the file. If `limit`
+        exceeds the size of the file, the entire
+        file will be read.
+
+        @param map Whether to map the file
+        into memory.
+    */
+    BOOST_HTTP_PROTO_DECL
+    file_source(
+        file&& f,
+        std::uint64_t limit,
+        bool map) noexcept;
+
+    /** Constructor.
+
+        The source reads a range of a file which
+        it does not own, using positional reads
+        which leave the position of the file
+        unchanged. This allows one open file to
+        be shared by several sources, serving
+        different ranges of it at the same time.
+        The file must remain open until the
+        source is destroyed.
+
+        @par Example
+        @code
+        // f is shared by all requests for the asset
+        response.set_payload_size(size);
+        serializer.start<file_source>(response, f, offset, size);
+        @endcode
+
+        @param f The open @ref file from which the
+        body will be read.
+
+        @param offset The offset of the first byte
+        of the range.
+
+        @param size The number of bytes in the
+        range. If the range extends past the end
+        of the file, the body ends at the end of
+        the file.
+    */
+    BOOST_HTTP_PROTO_DECL
+    file_source(
+        file& f,
+        std::uint64_t offset,
+        std::uint64_t size) noexcept;
+
+    /** Constructor.
+
+        The source reads the whole of a file
+        held by a @ref file_cache, which it keeps
+        open until the source is destroyed.
+
+        @par Example
+        @code
+        auto e = cache.open("index.html");
+        response.set_payload_size(e->size);
+        serializer.start<file_source>(response, std::move(e));
+        @endcode
+
+        @param e The cache entry to read.
+    */
+    BOOST_HTTP_PROTO_DECL
+    explicit
+    file_source(
+        std::shared_ptr<file_cache::entry> e) noexcept;
+
+    /** Constructor.
+
+        The source reads a range of a file held
+        by a @ref file_cache, which it keeps open
+        until the source is destroyed.
+
+        @param e The cache entry to read.
+
+        @param offset The offset of the first byte
+        of the range.
+
+        @param size The number of bytes in the
+        range. If the range extends past the end
+        of the file, the body ends at the end of
+        the file.
+    */
+    BOOST_HTTP_PROTO_DECL
+    file_source(
+        std::shared_ptr<file_cache::entry> e,
+        std::uint64_t offset,
+        std::uint64_t size) noexcept;
+
     file_source() = delete;
     file_source(file_source const&) = delete;
 
@@ -79,6 +218,28 @@ private:
     results
     on_read(
         buffers::mutable_buffer b) override;
+
+    BOOST_HTTP_PROTO_DECL
+    results
+    on_read(
+        boost::span<buffers::mutable_buffer const> bs) override;
+
+    BOOST_HTTP_PROTO_DECL
+    bool
+    on_can_borrow() const noexcept override;
+
+    BOOST_HTTP_PROTO_DECL
+    results
+    on_borrow(
+        buffers::const_buffer& b) override;
+
+    BOOST_HTTP_PROTO_DECL
+    void
+    on_release(
+        std::size_t n) noexcept override;
+
+    void
+    map_file() noexcept;
 };
 
 } // http_proto
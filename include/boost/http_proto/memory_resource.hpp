@@ -0,0 +1,156 @@
+//
+// Copyright (c) 2025 Mohammad Nejati
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#ifndef BOOST_HTTP_PROTO_MEMORY_RESOURCE_HPP
+#define BOOST_HTTP_PROTO_MEMORY_RESOURCE_HPP
+
+#include <boost/http_proto/detail/config.hpp>
+
+#include <cstddef>
+#include <stddef.h> // ::max_align_t
+
+namespace boost {
+namespace http_proto {
+
+/** An abstract interface to a source of memory.
+
+    This has the same interface as
+    `std::pmr::memory_resource`, which is not
+    available in C++11. A resource can be given
+    to the parser and serializer services and to
+    @ref fields, @ref request and @ref response
+    containers, so that their memory comes from
+    an allocator chosen by the application, such
+    as a per-thread slab, an arena or one which
+    accounts the memory of each tenant.
+
+    When no resource is given, memory is
+    allocated with the global operator new.
+
+    @par Example
+    Forwarding to a `std::pmr::memory_resource`:
+    @code
+    class pmr_resource : public memory_resource
+    {
+        std::pmr::memory_resource* r_;
+
+    public:
+        explicit
+        pmr_resource(std::pmr::memory_resource* r) noexcept
+            : r_(r)
+        {
+        }
+
+    private:
+        void*
+        do_allocate(std::size_t n, std::size_t align) override
+        {
+            return r_->allocate(n, align);
+        }
+
+        void
+        do_deallocate(void* p, std::size_t n, std::size_t align) override
+        {
+            r_->deallocate(p, n, align);
+        }
+
+        bool
+        do_is_equal(memory_resource const& other) const noexcept override
+        {
+            return this == &other;
+        }
+    };
+    @endcode
+
+    @see
+        @ref parser::config_base::resource,
+        @ref serializer::config::resource.
+*/
+class memory_resource
+{
+public:
+    /** Destructor.
+    */
+    virtual
+    ~memory_resource() = default;
+
+    /** Allocate memory.
+
+        @throw std::bad_alloc
+        The memory could not be allocated.
+
+        @return A pointer to at least `bytes`
+        bytes aligned to `align`.
+
+        @param bytes The number of bytes.
+
+        @param align The alignment.
+    */
+    void*
+    allocate(
+        std::size_t bytes,
+        std::size_t align = alignof(::max_align_t))
+    {
+        return do_allocate(bytes, align);
+    }
+
+    /** Deallocate memory.
+
+        @param p A pointer returned by
+        @ref allocate on an equal resource.
+
+        @param bytes The number of bytes passed
+        to @ref allocate.
+
+        @param align The alignment passed to
+        @ref allocate.
+    */
+    void
+    deallocate(
+        void* p,
+        std::size_t bytes,
+        std::size_t align = alignof(::max_align_t))
+    {
+        do_deallocate(p, bytes, align);
+    }
+
+    /** Return true if memory allocated by one
+        resource can be deallocated by the other.
+    */
+    bool
+    is_equal(
+        memory_resource const& other) const noexcept
+    {
+        return do_is_equal(other);
+    }
+
+private:
+    virtual
+    void*
+    do_allocate(
+        std::size_t bytes,
+        std::size_t align) = 0;
+
+    virtual
+    void
+    do_deallocate(
+        void* p,
+        std::size_t bytes,
+        std::size_t align) = 0;
+
+    virtual
+    bool
+    do_is_equal(
+        memory_resource const& other) const noexcept = 0;
+};
+
+} // http_proto
+} // boost
+
+#endif
@@ -185,6 +185,43 @@ public:
     BOOST_HTTP_PROTO_DECL
     void
     set_keep_alive(bool value);
+
+    /** Set the slack kept in front of the start line.
+
+        Changing the method, target, version or
+        status can change the length of the start
+        line. When it becomes shorter, the fields
+        stay where they are and the bytes freed
+        in front of the start line become slack.
+        When it becomes longer and there is enough
+        slack, only the start line is copied.
+        Otherwise the fields are moved, and `n`
+        bytes of slack are left in front of the
+        start line if the capacity allows it.
+
+        The slack is part of
+        @ref capacity_in_bytes, and is given back
+        when the message is cleared or assigned.
+
+        @par Example
+        @code
+        // rewrite the target of each request
+        // without moving the fields
+        req.set_start_line_slack(64);
+        req.set_target(rewrite(req.target()));
+        @endcode
+
+        @par Complexity
+        Constant.
+
+        @param n The number of bytes.
+    */
+    void
+    set_start_line_slack(
+        std::size_t n) noexcept
+    {
+        start_line_slack_ = n;
+    }
 };
 
 } // http_proto
@@ -16,6 +16,7 @@
 #include <boost/http_proto/detail/type_traits.hpp>
 #include <boost/http_proto/detail/workspace.hpp>
 #include <boost/http_proto/header_limits.hpp>
+#include <boost/http_proto/memory_resource.hpp>
 #include <boost/http_proto/sink.hpp>
 
 #include <boost/buffers/dynamic_buffer.hpp>
@@ -497,6 +498,40 @@ public:
     void
     set_body_limit(std::uint64_t n);
 
+    /** Set the dictionary used to decompress the body.
+
+        The dictionary applies to the deflate, br
+        and zstd content codings of the current
+        message, and is cleared when the next
+        message is started. It must be the one
+        the body was compressed with; a deflate
+        body which names a different dictionary
+        fails with an error.
+
+        @par Exception Safety
+        Strong guarantee.
+
+        @par Preconditions
+        Can be called after @ref start and before
+        parsing the message body. It can be called
+        right after `this->got_header() == true`.
+
+        @throw std::logic_error The body is
+        already being parsed.
+
+        @throw std::invalid_argument No dictionary
+        with the id was installed before the
+        parser service.
+
+        @param id The id of the dictionary.
+
+        @see
+            @ref install_compression_dictionary.
+    */
+    BOOST_HTTP_PROTO_DECL
+    void
+    set_dictionary(std::uint32_t id);
+
     /** Return the available body data.
 
         The returned buffer may become invalid if
@@ -612,12 +647,20 @@ public:
 private:
     friend class request_parser;
     friend class response_parser;
+    friend class connection_buffers;
     class impl;
 
     BOOST_HTTP_PROTO_DECL
     parser(
         const rts::context&,
-        detail::kind);
+        detail::kind,
+        void* storage = nullptr);
+
+    BOOST_HTTP_PROTO_DECL
+    static
+    std::size_t
+    storage_needed(
+        const rts::context&);
 
     BOOST_HTTP_PROTO_DECL
     parser(parser&& other) noexcept;
@@ -692,6 +735,13 @@ struct parser::config_base
     */
     bool apply_gzip_decoder = false;
 
+    /** Enable Zstandard Content-Encoding decoding.
+
+        Requires `boost::http_proto::zstd::decompress_service`
+        to be installed, otherwise an exception is thrown.
+    */
+    bool apply_zstd_decoder = false;
+
     /** Zlib window bits (9–15).
 
         Must be >= the value used during compression.
@@ -702,6 +752,18 @@ struct parser::config_base
     */
     int zlib_window_bits = 15;
 
+    /** Zstandard maximum window log (10–31).
+
+        The base 2 logarithm of the largest window
+        accepted. RFC 9659 limits the window of
+        zstd content coding to 8MB, a log of 23.
+        The decompression context is placed in the
+        parser's workspace, and its size grows with
+        the window. Frames needing a larger window
+        fail to decode.
+    */
+    int zstd_window_log_max = 23;
+
     /** Minimum space for payload buffering.
 
         This value controls the following
@@ -717,7 +779,11 @@ struct parser::config_base
         @li The largest size used to reserve
             space in dynamic buffer bodies
             when the payload size is not
-            known ahead of time.
+            known ahead of time. A coded
+            payload which is received in full
+            is instead decoded in one call
+            when the capacity of the buffer
+            already has room for it.
 
         This cannot be zero.
     */
@@ -741,6 +807,16 @@ struct parser::config_base
             ElasticBuffer.
     */
     std::size_t max_type_erase = 1024;
+
+    /** Memory resource for parsers.
+
+        When not null, the state and buffers of
+        each parser, and the memory of Brotli
+        decoders, are allocated from this resource,
+        which must outlive the context. Otherwise
+        operator new is used.
+    */
+    memory_resource* resource = nullptr;
 };
 
 /** Install the parser service.
@@ -75,6 +75,37 @@ public:
     */
     request() noexcept = default;
 
+    /** Constructor.
+
+        Constructs a default request whose
+        storage is allocated from `mr`. The
+        resource moves with the storage when the
+        container is moved or swapped, while
+        copies of the container use operator new.
+
+        @par Example
+        @code
+        request req(mr);
+        @endcode
+
+        @par Postconditions
+        @code
+        this->buffer() == "GET / HTTP/1.1\r\n\r\n"
+        @endcode
+
+        @par Complexity
+        Constant.
+
+        @param mr The memory resource, which
+        must outlive the container.
+    */
+    explicit
+    request(
+        memory_resource& mr) noexcept
+        : request_base(&mr)
+    {
+    }
+
     /** Constructor.
 
         Constructs a request from the string `s`,
@@ -409,6 +440,9 @@ public:
     {
         h_.swap(other.h_);
         std::swap(max_cap_, other.max_cap_);
+        std::swap(start_line_slack_, other.start_line_slack_);
+        std::swap(mr_, other.mr_);
+        std::swap(ix_, other.ix_);
     }
 
     /** Swap.
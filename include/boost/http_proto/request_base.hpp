@@ -29,6 +29,7 @@ class request_base
 {
     friend class request;
     friend class static_request;
+    template<std::size_t> friend class small_request;
 
     request_base() noexcept
         : message_base(detail::kind::request)
@@ -41,6 +42,12 @@ class request_base
     {
     }
 
+    explicit
+    request_base(memory_resource* mr) noexcept
+        : message_base(detail::kind::request, mr)
+    {
+    }
+
     request_base(
         void* storage,
         std::size_t cap) noexcept
@@ -135,6 +135,14 @@ public:
     BOOST_HTTP_PROTO_DECL
     static_request const&
     get() const;
+
+private:
+    friend class connection_buffers;
+
+    BOOST_HTTP_PROTO_DECL
+    request_parser(
+        const rts::context&,
+        void*);
 };
 
 } // http_proto
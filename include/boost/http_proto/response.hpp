@@ -77,6 +77,37 @@ public:
     */
     response() noexcept = default;
 
+    /** Constructor.
+
+        Constructs a default response whose
+        storage is allocated from `mr`. The
+        resource moves with the storage when the
+        container is moved or swapped, while
+        copies of the container use operator new.
+
+        @par Example
+        @code
+        response res(mr);
+        @endcode
+
+        @par Postconditions
+        @code
+        this->buffer() == "HTTP/1.1 200 OK\r\n\r\n"
+        @endcode
+
+        @par Complexity
+        Constant.
+
+        @param mr The memory resource, which
+        must outlive the container.
+    */
+    explicit
+    response(
+        memory_resource& mr) noexcept
+        : response_base(&mr)
+    {
+    }
+
     /** Constructor.
 
         Constructs a response from the string `s`,
@@ -405,6 +436,9 @@ public:
     {
         h_.swap(other.h_);
         std::swap(max_cap_, other.max_cap_);
+        std::swap(start_line_slack_, other.start_line_slack_);
+        std::swap(mr_, other.mr_);
+        std::swap(ix_, other.ix_);
     }
 
     /** Swap.
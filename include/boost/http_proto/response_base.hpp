@@ -31,6 +31,7 @@ class response_base
 {
     friend class response;
     friend class static_response;
+    template<std::size_t> friend class small_response;
 
     response_base() noexcept
         : message_base(detail::kind::response)
@@ -43,6 +44,12 @@ class response_base
     {
     }
 
+    explicit
+    response_base(memory_resource* mr) noexcept
+        : message_base(detail::kind::response, mr)
+    {
+    }
+
     response_base(
         void* storage,
         std::size_t cap) noexcept
@@ -0,0 +1,263 @@
+//
+// Copyright (c) 2025 Mohammad Nejati
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#ifndef BOOST_HTTP_PROTO_RESPONSE_TEMPLATE_HPP
+#define BOOST_HTTP_PROTO_RESPONSE_TEMPLATE_HPP
+
+#include <boost/http_proto/detail/config.hpp>
+#include <boost/http_proto/date.hpp>
+#include <boost/http_proto/field.hpp>
+#include <boost/http_proto/response.hpp>
+
+#include <boost/core/detail/string_view.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace boost {
+namespace http_proto {
+
+/** A pre-serialized response with patchable slots.
+
+    A response template is built once from a
+    response which has all the fields that do
+    not change between requests. Fields which do
+    change, such as Date, Content-Length, ETag or
+    a request id, are registered as slots of a
+    fixed width. Each slot occupies `width`
+    characters in the serialized header, so
+    setting its value overwrites those bytes in
+    place without moving the rest of the header
+    or touching the other fields.
+
+    Values shorter than the width of the slot
+    are padded with trailing whitespace, which is
+    permitted after any field value.
+
+    The patched message is obtained with
+    @ref message and can be passed to
+    @ref serializer::start like any other
+    response.
+
+    @par Example
+    @code
+    response res(status::ok);
+    res.set(field::server, "example");
+    res.set(field::content_type, "application/json");
+
+    response_template rt(res);
+    rt.add_slot(field::date, date_size);
+    auto const rid = rt.add_slot("X-Request-Id", 16);
+    rt.add_slot(field::content_length, 20);
+
+    // on each request
+    rt.set_date();
+    rt.set(rid, request_id);
+    rt.set_content_length(body.size());
+    sr.start(rt.message(), buffers::const_buffer(
+        body.data(), body.size()));
+    @endcode
+
+    @note The slots must not be patched while a
+    serializer is using the message.
+*/
+class response_template
+{
+public:
+    /** Constructor.
+
+        The template contains a copy of `res`
+        and no slots.
+
+        @par Exception Safety
+        Calls to allocate may throw.
+
+        @param res The response to copy.
+    */
+    BOOST_HTTP_PROTO_DECL
+    explicit
+    response_template(
+        response_base const& res);
+
+    /** Return the patched message.
+    */
+    response const&
+    message() const noexcept
+    {
+        return res_;
+    }
+
+    /** Return the number of slots.
+    */
+    std::size_t
+    slot_count() const noexcept
+    {
+        return slots_.size();
+    }
+
+    /** Add a slot for a field.
+
+        Any fields with the same name are
+        replaced by a single field, whose value
+        can be set later with @ref set. The
+        initial value of the slot is the value
+        of the first field replaced, or empty.
+
+        @par Exception Safety
+        Strong guarantee.
+        Calls to allocate may throw.
+
+        @throw std::invalid_argument
+        A slot for the field already exists, or
+        `width` is zero.
+
+        @throw std::length_error
+        The initial value is wider than `width`.
+
+        @return The index of the slot.
+
+        @param id The field id.
+
+        @param width The number of characters
+        reserved for the value.
+    */
+    BOOST_HTTP_PROTO_DECL
+    std::size_t
+    add_slot(
+        field id,
+        std::size_t width);
+
+    /** Add a slot for a field.
+
+        Any fields with the same name are
+        replaced by a single field, whose value
+        can be set later with @ref set. The
+        initial value of the slot is the value
+        of the first field replaced, or empty.
+
+        @par Exception Safety
+        Strong guarantee.
+        Calls to allocate may throw.
+
+        @throw std::invalid_argument
+        A slot for the field already exists, or
+        `width` is zero.
+
+        @throw system_error
+        The name is invalid.
+
+        @throw std::length_error
+        The initial value is wider than `width`.
+
+        @return The index of the slot.
+
+        @param name The field name.
+
+        @param width The number of characters
+        reserved for the value.
+    */
+    BOOST_HTTP_PROTO_DECL
+    std::size_t
+    add_slot(
+        core::string_view name,
+        std::size_t width);
+
+    /** Set the value of a slot.
+
+        The value overwrites the bytes reserved
+        for the slot and the metadata of the
+        message is updated to match.
+
+        @par Complexity
+        Linear in the width of the slot.
+
+        @par Exception Safety
+        Strong guarantee.
+
+        @throw std::out_of_range
+        `slot >= this->slot_count()`.
+
+        @throw std::length_error
+        `value.size()` is larger than the width of
+        the slot.
+
+        @throw std::invalid_argument
+        The value contains invalid characters.
+
+        @param slot The index of the slot.
+
+        @param value The value to set.
+    */
+    BOOST_HTTP_PROTO_DECL
+    void
+    set(
+        std::size_t slot,
+        core::string_view value);
+
+    /** Set the value of the Content-Length slot.
+
+        @par Exception Safety
+        Strong guarantee.
+
+        @throw std::logic_error
+        There is no slot for Content-Length.
+
+        @throw std::length_error
+        The decimal value is larger than the
+        width of the slot.
+
+        @param n The payload size.
+    */
+    BOOST_HTTP_PROTO_DECL
+    void
+    set_content_length(
+        std::uint64_t n);
+
+    /** Set the value of the Date slot.
+
+        The slot is set to the value of
+        @ref current_date, which costs a copy of
+        29 bytes in most calls.
+
+        @par Exception Safety
+        Strong guarantee.
+
+        @throw std::logic_error
+        There is no slot for Date.
+
+        @throw std::length_error
+        The width of the slot is less than
+        @ref date_size.
+    */
+    BOOST_HTTP_PROTO_DECL
+    void
+    set_date();
+
+private:
+    struct slot_t
+    {
+        std::size_t index = 0;
+        std::size_t width = 0;
+        field id = field{};
+        std::string name;
+    };
+
+    std::size_t add_slot_impl(
+        field, core::string_view, std::size_t);
+    void reindex() noexcept;
+
+    response res_;
+    std::vector<slot_t> slots_;
+};
+
+} // http_proto
+} // boost
+
+#endif
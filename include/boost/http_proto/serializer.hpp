@@ -13,6 +13,7 @@
 
 #include <boost/http_proto/detail/config.hpp>
 #include <boost/http_proto/detail/workspace.hpp>
+#include <boost/http_proto/memory_resource.hpp>
 #include <boost/http_proto/source.hpp>
 
 #include <boost/buffers/buffer_pair.hpp>
@@ -20,8 +21,12 @@
 #include <boost/rts/context_fwd.hpp>
 #include <boost/system/result.hpp>
 
+#include <chrono>
+#include <cstdint>
+#include <string>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 namespace boost {
 namespace http_proto {
@@ -158,6 +163,39 @@ public:
     void
     reset() noexcept;
 
+    /** Set the dictionary used to compress the next message.
+
+        The dictionary applies to the deflate,
+        br and zstd content codings of the next
+        message to be started, and is cleared
+        once that message is done or the
+        serializer is reset. Bodies compressed
+        with zstd use the configured level rather
+        than one lowered by the time budget.
+
+        @par Preconditions
+        @code
+        this->is_done() == true
+        @endcode
+
+        @par Exception Safety
+        Strong guarantee.
+
+        @throw std::logic_error `this->is_done() == false`.
+
+        @throw std::invalid_argument No dictionary
+        with the id was installed before the
+        serializer service.
+
+        @param id The id of the dictionary.
+
+        @see
+            @ref install_compression_dictionary.
+    */
+    BOOST_HTTP_PROTO_DECL
+    void
+    set_dictionary(std::uint32_t id);
+
     /** Start serializing a message with an empty body
 
         This function prepares the serializer to create a message which
@@ -427,6 +465,12 @@ public:
         that additional input is required to
         produce output.
 
+        When parallel compression is in use, the
+        output area may be empty while the next
+        block is still being compressed. The
+        caller should call @ref prepare again
+        later.
+
         If a @ref source object is in use and a
         call to @ref source::read returns an
         error, the serializer enters a faulted
@@ -510,11 +554,23 @@ public:
     is_done() const noexcept;
 
 private:
+    friend class connection_buffers;
     class impl;
     class cbs_gen;
     template<class>
     class cbs_gen_impl;
 
+    BOOST_HTTP_PROTO_DECL
+    serializer(
+        const rts::context&,
+        void*);
+
+    BOOST_HTTP_PROTO_DECL
+    static
+    std::size_t
+    storage_needed(
+        const rts::context&);
+
     BOOST_HTTP_PROTO_DECL
     detail::workspace&
     ws();
@@ -568,6 +624,13 @@ struct serializer::config
     */
     bool apply_gzip_encoder = false;
 
+    /** Enable Zstandard Content-Encoding.
+
+        Requires `boost::http_proto::zstd::compress_service`
+        to be installed, otherwise an exception is thrown.
+    */
+    bool apply_zstd_encoder = false;
+
     /** Brotli compression quality (0–11).
 
         Higher values yield better but slower compression.
@@ -602,7 +665,30 @@ struct serializer::config
     */
     int zlib_mem_level = 8;
 
-    /** Minimum buffer size for payloads (must be > 0). */
+    /** Zstandard compression level (1–22).
+
+        Higher values yield better but slower
+        compression. The compression context is
+        placed in the serializer's workspace, and
+        its size grows with the level.
+    */
+    int zstd_comp_level = 3;
+
+    /** Zstandard window log (10–23).
+
+        The base 2 logarithm of the window size.
+        0 selects the default for the compression
+        level, limited to 23 as required by RFC 9659.
+    */
+    int zstd_window_log = 0;
+
+    /** Minimum buffer size for payloads (must be > 0).
+
+        A body given as a single buffer is compressed
+        in one call when its compressed form is certain
+        to fit in this space; larger bodies are
+        compressed in pieces.
+    */
     std::size_t payload_buffer = 8192;
 
     /** Reserved space for type-erasure storage.
@@ -612,6 +698,117 @@ struct serializer::config
         @li User-defined ConstBufferSequence instances.
     */
     std::size_t max_type_erase = 1024;
+
+    /** Minimum body size for applying compression.
+
+        When the size of the body is known in advance,
+        either from the buffer sequence passed to
+        @ref serializer::start or from the
+        Content-Length field, and it is smaller than
+        this value, the body is sent without
+        compression and the Content-Encoding field
+        is omitted from the serialized header.
+
+        The header without the field is copied into
+        the workspace. If there is no room left for
+        the copy, the body is compressed anyway. The
+        same applies to @ref compressible_types and
+        @ref incompressible_types.
+    */
+    std::size_t min_compression_size = 0;
+
+    /** Media types eligible for compression.
+
+        When not empty, only bodies whose Content-Type
+        matches one of the entries are compressed.
+        Entries are either a full media type such as
+        `"application/json"`, or a type followed by
+        a wildcard such as `"text/*"`. Matching is
+        case-insensitive.
+    */
+    std::vector<std::string> compressible_types;
+
+    /** Media types excluded from compression.
+
+        Bodies whose Content-Type matches one of the
+        entries are never compressed. The syntax is
+        the same as @ref compressible_types, and this
+        list takes precedence over it.
+    */
+    std::vector<std::string> incompressible_types;
+
+    /** Size of the body prefix used to probe compressibility.
+
+        When not zero, up to this many bytes at the
+        start of the body are compressed and flushed
+        before the header is sent. If the compressed
+        size exceeds @ref compression_probe_ratio
+        percent of the input, compression is abandoned
+        and the body is sent as-is, with the
+        Content-Encoding field omitted.
+    */
+    std::size_t compression_probe_size = 0;
+
+    /** Maximum compressed size, in percent of the input,
+        accepted by the compressibility probe.
+    */
+    unsigned compression_probe_ratio = 90;
+
+    /** Compression time budget per second.
+
+        When not zero, the time spent compressing by
+        all serializers sharing the context is
+        measured. While it exceeds this budget, the
+        zlib compression level and the Brotli quality
+        used for new messages are lowered one step per
+        second, and raised back once the load drops
+        below half of the budget.
+
+        The load is evaluated only while compressing,
+        so the levels stay lowered while idle: the
+        first messages compressed after an idle period
+        use the lowered levels, which then recover by
+        one step per second.
+    */
+    std::chrono::microseconds compression_time_budget{ 0 };
+
+    /** Number of threads used for parallel compression.
+
+        When not zero, the serializer service starts
+        this many worker threads, shared by all
+        serializers on the context. Deflate and Gzip
+        bodies provided as a buffer sequence of at
+        least @ref parallel_compression_min_size bytes
+        are cut into blocks which are compressed
+        concurrently and emitted in order.
+
+        Blocks are compressed independently, which
+        slightly lowers the compression ratio, and
+        their output is held in memory allocated
+        outside of the workspace. The serializer
+        never waits for a worker: @ref
+        serializer::prepare returns an empty output
+        area while the next block is in progress.
+    */
+    std::size_t parallel_compression_threads = 0;
+
+    /** Minimum body size for parallel compression.
+    */
+    std::size_t parallel_compression_min_size = 1024 * 1024;
+
+    /** Size of the blocks compressed in parallel.
+    */
+    std::size_t parallel_compression_block_size = 128 * 1024;
+
+    /** Memory resource for serializers.
+
+        When not null, the state and buffers of
+        each serializer, and the memory of Brotli
+        encoders, are allocated from this resource,
+        which must outlive the context. Otherwise
+        operator new is used.
+    */
+    memory_resource* resource = nullptr;
 };
 
 /** Install the serializer service.
@@ -0,0 +1,261 @@
+//
+// Copyright (c) 2025 Mohammad Nejati
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#ifndef BOOST_HTTP_PROTO_SMALL_REQUEST_HPP
+#define BOOST_HTTP_PROTO_SMALL_REQUEST_HPP
+
+#include <boost/http_proto/request_base.hpp>
+
+#include <limits>
+
+namespace boost {
+namespace http_proto {
+
+/** A modifiable container for HTTP requests with inline storage.
+
+    This container keeps its contents in a
+    buffer of `Capacity` bytes inside the
+    object, and moves them to the heap only
+    when they no longer fit. Building a typical
+    request therefore performs no allocation.
+    The contents may be inspected and modified,
+    and the implementation maintains a useful
+    invariant: changes to the request always
+    leave it in a valid state.
+
+    @par Example
+    @code
+    small_request<> req;
+
+    req.set_start_line(method::get, "/");
+    req.set(field::host, "example.com");
+    req.set(field::accept_encoding, "gzip, deflate, br");
+    req.set(field::cache_control, "no-cache");
+
+    assert(req.is_inline());
+    @endcode
+
+    @tparam Capacity The size of the inline
+    storage in bytes, which holds both the
+    serialized header and the field table.
+
+    @see
+        @ref request,
+        @ref static_request,
+        @ref request_base.
+*/
+template<std::size_t Capacity = 512>
+class small_request
+    : public request_base
+{
+    static_assert(Capacity >= 64,
+        "Capacity is too small");
+
+    alignas(detail::header::entry)
+        char buf_[Capacity];
+
+public:
+    //--------------------------------------------
+    //
+    // Special Members
+    //
+    //--------------------------------------------
+
+    /** Constructor.
+
+        A default-constructed request contains
+        a valid HTTP GET request with no
+        headers, in the inline storage.
+
+        @par Postconditions
+        @code
+        this->is_inline() == true
+        @endcode
+
+        @par Complexity
+        Constant.
+    */
+    small_request() noexcept
+        : request_base(buf_, Capacity)
+    {
+        max_cap_ = (std::numeric_limits<
+            std::size_t>::max)();
+    }
+
+    /** Constructor.
+
+        The newly constructed object contains
+        a copy of `r`.
+
+        @par Complexity
+        Linear in `r.size()`.
+
+        @par Exception Safety
+        Strong guarantee.
+        Calls to allocate may throw.
+
+        @param r The request to copy.
+    */
+    small_request(
+        small_request const& r)
+        : small_request()
+    {
+        copy_impl(r.h_);
+    }
+
+    /** Constructor.
+
+        The newly constructed object contains
+        a copy of `r`.
+
+        @par Complexity
+        Linear in `r.size()`.
+
+        @par Exception Safety
+        Strong guarantee.
+        Calls to allocate may throw.
+
+        @param r The request to copy.
+    */
+    small_request(
+        request_base const& r)
+        : small_request()
+    {
+        copy_impl(r.h_);
+    }
+
+    /** Constructor.
+
+        The contents of `r` are transferred to
+        the newly constructed object. Inline
+        contents are copied, while a heap buffer
+        is transferred.
+        After construction, the moved-from
+        object is as if default-constructed.
+
+        @par Complexity
+        Linear in `r.size()` if `r.is_inline()`,
+        otherwise constant.
+
+        @param r The request to move from.
+    */
+    small_request(
+        small_request&& r) noexcept
+        : small_request()
+    {
+        take_inline(r, r.buf_, Capacity);
+    }
+
+    /** Assignment.
+
+        The contents of `r` are copied and
+        the previous contents of `this` are
+        discarded.
+
+        @par Complexity
+        Linear in `r.size()`.
+
+        @par Exception Safety
+        Strong guarantee.
+        Calls to allocate may throw.
+        Exception thrown if max capacity exceeded.
+
+        @throw std::length_error
+        Max capacity would be exceeded.
+
+        @param r The request to copy.
+
+        @return A reference to this object.
+    */
+    small_request&
+    operator=(
+        small_request const& r)
+    {
+        copy_impl(r.h_);
+        return *this;
+    }
+
+    /** Assignment.
+
+        The contents of `r` are copied and
+        the previous contents of `this` are
+        discarded.
+
+        @par Complexity
+        Linear in `r.size()`.
+
+        @par Exception Safety
+        Strong guarantee.
+        Calls to allocate may throw.
+        Exception thrown if max capacity exceeded.
+
+        @throw std::length_error
+        Max capacity would be exceeded.
+
+        @param r The request to copy.
+
+        @return A reference to this object.
+    */
+    small_request&
+    operator=(
+        request_base const& r)
+    {
+        copy_impl(r.h_);
+        return *this;
+    }
+
+    /** Assignment.
+
+        The contents of `r` are transferred to
+        `this`, and the previous contents of
+        `this` are destroyed. Inline contents are
+        copied, while a heap buffer is
+        transferred.
+        After assignment, the moved-from
+        object is as if default-constructed.
+
+        @par Complexity
+        Linear in `r.size()` if `r.is_inline()`,
+        otherwise constant.
+
+        @param r The request to move from.
+
+        @return A reference to this object.
+    */
+    small_request&
+    operator=(
+        small_request&& r) noexcept
+    {
+        if(this != &r)
+        {
+            reset_inline(buf_, Capacity);
+            take_inline(r, r.buf_, Capacity);
+        }
+        return *this;
+    }
+
+    //--------------------------------------------
+    //
+    // Observers
+    //
+    //--------------------------------------------
+
+    /** Return true if the contents are in the inline storage.
+    */
+    bool
+    is_inline() const noexcept
+    {
+        return external_storage_;
+    }
+};
+
+} // http_proto
+} // boost
+
+#endif
@@ -0,0 +1,261 @@
+//
+// Copyright (c) 2025 Mohammad Nejati
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#ifndef BOOST_HTTP_PROTO_SMALL_RESPONSE_HPP
+#define BOOST_HTTP_PROTO_SMALL_RESPONSE_HPP
+
+#include <boost/http_proto/response_base.hpp>
+
+#include <limits>
+
+namespace boost {
+namespace http_proto {
+
+/** A modifiable container for HTTP responses with inline storage.
+
+    This container keeps its contents in a
+    buffer of `Capacity` bytes inside the
+    object, and moves them to the heap only
+    when they no longer fit. Building a typical
+    response therefore performs no allocation.
+    The contents may be inspected and modified,
+    and the implementation maintains a useful
+    invariant: changes to the response always
+    leave it in a valid state.
+
+    @par Example
+    @code
+    small_response<> res;
+
+    res.set_start_line(status::not_found);
+    res.set(field::server, "Boost.HttpProto");
+    res.set(field::content_type, "text/plain");
+    res.set_content_length(80);
+
+    assert(res.is_inline());
+    @endcode
+
+    @tparam Capacity The size of the inline
+    storage in bytes, which holds both the
+    serialized header and the field table.
+
+    @see
+        @ref response,
+        @ref static_response,
+        @ref response_base.
+*/
+template<std::size_t Capacity = 512>
+class small_response
+    : public response_base
+{
+    static_assert(Capacity >= 64,
+        "Capacity is too small");
+
+    alignas(detail::header::entry)
+        char buf_[Capacity];
+
+public:
+    //--------------------------------------------
+    //
+    // Special Members
+    //
+    //--------------------------------------------
+
+    /** Constructor.
+
+        A default-constructed response contains
+        a valid HTTP 200 OK response with no
+        headers, in the inline storage.
+
+        @par Postconditions
+        @code
+        this->is_inline() == true
+        @endcode
+
+        @par Complexity
+        Constant.
+    */
+    small_response() noexcept
+        : response_base(buf_, Capacity)
+    {
+        max_cap_ = (std::numeric_limits<
+            std::size_t>::max)();
+    }
+
+    /** Constructor.
+
+        The newly constructed object contains
+        a copy of `r`.
+
+        @par Complexity
+        Linear in `r.size()`.
+
+        @par Exception Safety
+        Strong guarantee.
+        Calls to allocate may throw.
+
+        @param r The response to copy.
+    */
+    small_response(
+        small_response const& r)
+        : small_response()
+    {
+        copy_impl(r.h_);
+    }
+
+    /** Constructor.
+
+        The newly constructed object contains
+        a copy of `r`.
+
+        @par Complexity
+        Linear in `r.size()`.
+
+        @par Exception Safety
+        Strong guarantee.
+        Calls to allocate may throw.
+
+        @param r The response to copy.
+    */
+    small_response(
+        response_base const& r)
+        : small_response()
+    {
+        copy_impl(r.h_);
+    }
+
+    /** Constructor.
+
+        The contents of `r` are transferred to
+        the newly constructed object. Inline
+        contents are copied, while a heap buffer
+        is transferred.
+        After construction, the moved-from
+        object is as if default-constructed.
+
+        @par Complexity
+        Linear in `r.size()` if `r.is_inline()`,
+        otherwise constant.
+
+        @param r The response to move from.
+    */
+    small_response(
+        small_response&& r) noexcept
+        : small_response()
+    {
+        take_inline(r, r.buf_, Capacity);
+    }
+
+    /** Assignment.
+
+        The contents of `r` are copied and
+        the previous contents of `this` are
+        discarded.
+
+        @par Complexity
+        Linear in `r.size()`.
+
+        @par Exception Safety
+        Strong guarantee.
+        Calls to allocate may throw.
+        Exception thrown if max capacity exceeded.
+
+        @throw std::length_error
+        Max capacity would be exceeded.
+
+        @param r The response to copy.
+
+        @return A reference to this object.
+    */
+    small_response&
+    operator=(
+        small_response const& r)
+    {
+        copy_impl(r.h_);
+        return *this;
+    }
+
+    /** Assignment.
+
+        The contents of `r` are copied and
+        the previous contents of `this` are
+        discarded.
+
+        @par Complexity
+        Linear in `r.size()`.
+
+        @par Exception Safety
+        Strong guarantee.
+        Calls to allocate may throw.
+        Exception thrown if max capacity exceeded.
+
+        @throw std::length_error
+        Max capacity would be exceeded.
+
+        @param r The response to copy.
+
+        @return A reference to this object.
+    */
+    small_response&
+    operator=(
+        response_base const& r)
+    {
+        copy_impl(r.h_);
+        return *this;
+    }
+
+    /** Assignment.
+
+        The contents of `r` are transferred to
+        `this`, and the previous contents of
+        `this` are destroyed. Inline contents are
+        copied, while a heap buffer is
+        transferred.
+        After assignment, the moved-from
+        object is as if default-constructed.
+
+        @par Complexity
+        Linear in `r.size()` if `r.is_inline()`,
+        otherwise constant.
+
+        @param r The response to move from.
+
+        @return A reference to this object.
+    */
+    small_response&
+    operator=(
+        small_response&& r) noexcept
+    {
+        if(this != &r)
+        {
+            reset_inline(buf_, Capacity);
+            take_inline(r, r.buf_, Capacity);
+        }
+        return *this;
+    }
+
+    //--------------------------------------------
+    //
+    // Observers
+    //
+    //--------------------------------------------
+
+    /** Return true if the contents are in the inline storage.
+    */
+    bool
+    is_inline() const noexcept
+    {
+        return external_storage_;
+    }
+};
+
+} // http_proto
+} // boost
+
+#endif
@@ -118,6 +118,68 @@ struct BOOST_SYMBOL_VISIBLE
         return read_impl(bs);
     }
 
+    /** Return true if the source lends its buffers.
+
+        A source which holds its data in memory
+        may lend buffers referring to that memory
+        with @ref borrow, instead of copying it
+        with @ref read. The @ref serializer then
+        uses @ref borrow for a body sent without
+        a content coding or chunked encoding.
+
+        @see
+            @ref borrow,
+            @ref release.
+    */
+    bool
+    can_borrow() const noexcept
+    {
+        return on_can_borrow();
+    }
+
+    /** Lend data.
+
+        This function sets `b` to a buffer owned
+        by the source holding the next part of the
+        data. The buffer remains valid until the
+        bytes in it are passed to @ref release, or
+        the source is destroyed.
+
+        @par Preconditions
+        @code
+        this->can_borrow() == true
+        @endcode
+
+        @par Postconditions
+        @code
+        rv.ec.failed() == true || rv.finished == true || rv.bytes != 0
+        @endcode
+
+        @return The result of the operation,
+        where `rv.bytes` equals `b.size()`.
+
+        @param b The buffer to set.
+    */
+    results
+    borrow(buffers::const_buffer& b)
+    {
+        return on_borrow(b);
+    }
+
+    /** Release lent data.
+
+        This function is called when the first `n`
+        of the bytes lent and not yet released
+        are no longer used.
+
+        @param n The number of bytes to release.
+    */
+    void
+    release(std::size_t n) noexcept
+    {
+        on_release(n);
+    }
+
 protected:
     /** Derived class override.
 
@@ -197,6 +259,67 @@ protected:
     on_read(
         boost::span<buffers::mutable_buffer const> bs);
 
+    /** Derived class override.
+
+        This virtual function is called by the
+        implementation, and returns true if the
+        source lends buffers with @ref on_borrow.
+        The default returns false.
+    */
+    virtual
+    bool
+    on_can_borrow() const noexcept
+    {
+        return false;
+    }
+
+    /** Derived class override.
+
+        This virtual function is called by the
+        implementation when @ref on_can_borrow
+        returns true. The callee should set `b`
+        to a buffer holding the next part of the
+        data, which must remain valid until its
+        bytes are passed to @ref on_release.
+        The return value must be set to indicate
+        the number of bytes in `b`, the error if
+        any occurred, and a `bool` indicating
+        whether or not there is more data
+        remaining in the source.
+        The default throws `std::logic_error`.
+
+        @par Postconditions
+        @code
+        rv.ec.failed() == true || rv.finished == true || rv.bytes != 0
+        @endcode
+
+        @return The result of the operation.
+
+        @param b The buffer to set.
+    */
+    BOOST_HTTP_PROTO_DECL
+    virtual
+    results
+    on_borrow(
+        buffers::const_buffer& b);
+
+    /** Derived class override.
+
+        This virtual function is called by the
+        implementation when the first `n` of the
+        bytes lent and not yet released are no
+        longer used. The default does nothing.
+
+        @param n The number of bytes released.
+    */
+    virtual
+    void
+    on_release(
+        std::size_t n) noexcept
+    {
+        (void)n;
+    }
+
 private:
     results
     read_impl(
@@ -0,0 +1,212 @@
+//
+// Copyright (c) 2025 Mohammad Nejati
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#ifndef BOOST_HTTP_PROTO_SPOOL_HPP
+#define BOOST_HTTP_PROTO_SPOOL_HPP
+
+#include <boost/http_proto/detail/config.hpp>
+#include <boost/http_proto/file.hpp>
+#include <boost/buffers/buffer.hpp>
+#include <boost/system/error_code.hpp>
+
+#include <cstdint>
+#include <string>
+
+namespace boost {
+namespace http_proto {
+
+/** Storage for a body of unknown size.
+
+    The data is kept in memory until it grows
+    past a configured threshold, then it is moved
+    to a temporary file which is removed when the
+    spool is destroyed. Small bodies thus cost no
+    file system operations, and large ones do not
+    exhaust memory.
+
+    The data is read back with @ref read_at in
+    either case. While in memory, @ref data also
+    provides it directly, without a copy.
+
+    @par Example
+    @code
+    spool body;
+    parser.set_body<spool_sink>(body);
+    read(stream, parser);
+
+    if(body.in_memory())
+        handle(body.data());
+    @endcode
+
+    @see
+        @ref spool_sink,
+        @ref file.
+*/
+class spool
+{
+public:
+    struct config;
+
+private:
+    std::string buf_;
+    file f_;
+    std::uint64_t size_ = 0;
+    std::size_t threshold_;
+    std::string dir_;
+
+public:
+    /** Constructor.
+
+        The default configuration is used.
+    */
+    BOOST_HTTP_PROTO_DECL
+    spool();
+
+    /** Constructor.
+
+        @param cfg The configuration settings.
+    */
+    BOOST_HTTP_PROTO_DECL
+    explicit
+    spool(config const& cfg);
+
+    spool(spool const&) = delete;
+    spool& operator=(spool const&) = delete;
+
+    /** Constructor.
+    */
+    BOOST_HTTP_PROTO_DECL
+    spool(spool&&) noexcept;
+
+    /** Destructor.
+    */
+    BOOST_HTTP_PROTO_DECL
+    ~spool();
+
+    /** Return true if the data is in memory.
+    */
+    bool
+    in_memory() const noexcept
+    {
+        return ! f_.is_open();
+    }
+
+    /** Return the number of bytes stored.
+    */
+    std::uint64_t
+    size() const noexcept
+    {
+        return size_;
+    }
+
+    /** Return the data stored in memory.
+
+        @par Preconditions
+        @code
+        this->in_memory() == true
+        @endcode
+    */
+    buffers::const_buffer
+    data() const noexcept
+    {
+        return { buf_.data(), buf_.size() };
+    }
+
+    /** Read stored data.
+
+        @return The number of bytes read, which is
+        less than the size of the buffer only at the
+        end of the data or if an error occurs (in
+        which case @p ec is set).
+
+        @param offset The offset of the first byte to read.
+
+        @param b The buffer to store the data.
+
+        @param ec Set to the error, if any occurred.
+    */
+    BOOST_HTTP_PROTO_DECL
+    std::size_t
+    read_at(
+        std::uint64_t offset,
+        buffers::mutable_buffer b,
+        system::error_code& ec);
+
+    /** Prepare to store a number of bytes.
+
+        When the total would exceed the threshold,
+        the data is moved to the file now, and
+        storage for it is reserved with
+        @ref file::allocate. Otherwise memory is
+        reserved. This is usually called with the
+        Content-Length of the message.
+
+        @param n The number of bytes to be appended.
+
+        @param ec Set to the error, if any occurred.
+    */
+    BOOST_HTTP_PROTO_DECL
+    void
+    reserve(
+        std::uint64_t n,
+        system::error_code& ec);
+
+    /** Append data.
+
+        @param b The data to append.
+
+        @param ec Set to the error, if any occurred.
+        Data which was not stored is not included in
+        @ref size.
+    */
+    BOOST_HTTP_PROTO_DECL
+    void
+    append(
+        buffers::const_buffer b,
+        system::error_code& ec);
+
+    /** Remove all data.
+
+        The temporary file, if any, is closed.
+    */
+    BOOST_HTTP_PROTO_DECL
+    void
+    clear() noexcept;
+
+private:
+    void spill(system::error_code&);
+};
+
+//------------------------------------------------
+
+/** Spool configuration settings.
+
+    @see
+        @ref spool.
+*/
+struct spool::config
+{
+    /** The largest number of bytes kept in memory.
+    */
+    std::size_t threshold = 64 * 1024;
+
+    /** The directory for the temporary file.
+
+        Empty uses the system default.
+
+        @see
+            @ref file::open_temp.
+    */
+    std::string directory;
+};
+
+} // http_proto
+} // boost
+
+#endif
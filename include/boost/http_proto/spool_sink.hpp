@@ -0,0 +1,89 @@
+//
+// Copyright (c) 2025 Mohammad Nejati
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#ifndef BOOST_HTTP_PROTO_SPOOL_SINK_HPP
+#define BOOST_HTTP_PROTO_SPOOL_SINK_HPP
+
+#include <boost/http_proto/detail/config.hpp>
+#include <boost/http_proto/sink.hpp>
+#include <boost/http_proto/spool.hpp>
+
+namespace boost {
+namespace http_proto {
+
+/** Writes a message body to a spool.
+
+    This class implements the @ref sink interface,
+    storing the body in memory when it is small and
+    in a temporary file when it is large, for
+    handlers which do not know the size of the
+    body in advance.
+
+    The spool is referenced and must outlive
+    the sink. It holds the body after the
+    parser destroys the sink.
+
+    @par Example
+    @code
+    spool body;
+    auto& sink = parser.set_body<spool_sink>(body);
+    if(parser.get().payload() == payload::size)
+        sink.reserve(parser.get().payload_size());
+    read(stream, parser);
+    @endcode
+
+    @see
+        @ref spool,
+        @ref file_sink,
+        @ref parser,
+        @ref sink.
+*/
+class spool_sink
+    : public sink
+{
+    spool& sp_;
+
+public:
+    /** Constructor.
+
+        @param sp The spool which receives
+        the body data.
+    */
+    BOOST_HTTP_PROTO_DECL
+    explicit
+    spool_sink(spool& sp) noexcept;
+
+    /** Prepare to receive a number of bytes.
+
+        @par Exception Safety
+        Exception thrown if operation fails.
+
+        @throw system_error
+        Operation fails.
+
+        @param n The expected size of the body.
+
+        @see
+            @ref spool::reserve.
+    */
+    BOOST_HTTP_PROTO_DECL
+    void
+    reserve(std::uint64_t n);
+
+private:
+    BOOST_HTTP_PROTO_DECL
+    results
+    on_write(
+        buffers::const_buffer, bool) override;
+};
+
+} // http_proto
+} // boost
+
+#endif
@@ -0,0 +1,17 @@
+//
+// Copyright (c) 2025 Mohammad Nejati
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#ifndef BOOST_HTTP_PROTO_ZSTD_HPP
+#define BOOST_HTTP_PROTO_ZSTD_HPP
+
+#include <boost/http_proto/zstd/compress.hpp>
+#include <boost/http_proto/zstd/decompress.hpp>
+#include <boost/http_proto/zstd/stream.hpp>
+
+#endif
@@ -0,0 +1,159 @@
+//
+// Copyright (c) 2025 Mohammad Nejati
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#ifndef BOOST_HTTP_PROTO_ZSTD_COMPRESS_HPP
+#define BOOST_HTTP_PROTO_ZSTD_COMPRESS_HPP
+
+#include <boost/http_proto/detail/config.hpp>
+#include <boost/http_proto/zstd/stream.hpp>
+
+#include <boost/rts/context_fwd.hpp>
+#include <boost/rts/service.hpp>
+#include <boost/system/error_code.hpp>
+
+namespace boost {
+namespace http_proto {
+namespace zstd {
+
+/** Provides the zstd compression API.
+
+    Compression contexts are placed in caller
+    provided memory, so that no allocations take
+    place while a body is compressed.
+
+    @see
+        @ref install_compress_service.
+*/
+struct BOOST_SYMBOL_VISIBLE
+    compress_service
+    : public rts::service
+{
+    /** Return the memory needed by a context.
+
+        @param level The compression level.
+
+        @param window_log The base 2 logarithm of
+        the window size, or 0 to use the default
+        for `level` limited to 23.
+    */
+    virtual
+    std::size_t
+    space_needed(
+        int level,
+        int window_log) const noexcept = 0;
+
+    /** Create a context in the given memory.
+
+        The memory must be aligned to 8 bytes and
+        at least as large as @ref space_needed
+        returns for the same arguments. The context
+        is not destroyed, the memory may be
+        reused once it is no longer needed.
+
+        @return The context, or `nullptr` if the
+        memory or the arguments are unsuitable.
+    */
+    virtual
+    cstream*
+    init_static(
+        void* p,
+        std::size_t n,
+        int level,
+        int window_log) const noexcept = 0;
+
+    /** Compress data.
+
+        @return A lower bound on the number of
+        octets which remain to be flushed, which is
+        zero once a flush or end is complete.
+    */
+    virtual
+    std::size_t
+    compress_stream(
+        cstream& cs,
+        out_buffer& out,
+        in_buffer& in,
+        end_directive directive,
+        system::error_code& ec) const noexcept = 0;
+
+    /** Digest a dictionary for compression.
+
+        The dictionary is referenced, not copied,
+        so `data` must remain valid until the
+        result is passed to @ref free_dictionary.
+        Content in the format produced by
+        `zstd --train` is recognized, anything
+        else is used as raw content.
+
+        @return The dictionary, or `nullptr` if
+        allocation fails.
+
+        @param data The dictionary content.
+
+        @param size The size of the content.
+
+        @param level The compression level, which
+        overrides the one of the contexts the
+        dictionary is used with.
+    */
+    virtual
+    cdict*
+    create_dictionary(
+        void const* data,
+        std::size_t size,
+        int level) const noexcept = 0;
+
+    /** Free a dictionary.
+    */
+    virtual
+    void
+    free_dictionary(
+        cdict* cd) const noexcept = 0;
+
+    /** Use a dictionary for the next frame.
+
+        The dictionary must outlive its use by
+        the context. The memory of the context
+        must be large enough for the level the
+        dictionary was created with.
+
+        @return `false` on failure.
+    */
+    virtual
+    bool
+    ref_dictionary(
+        cstream& cs,
+        cdict const* cd) const noexcept = 0;
+
+#ifndef BOOST_HTTP_PROTO_MRDOCS
+    using key_type = compress_service;
+#endif
+};
+
+/** Install the zstd compression service.
+
+    @par Exception Safety
+    Strong guarantee.
+
+    @throw std::invalid_argument If the service is
+    already installed on the context.
+
+    @param ctx Reference to the context on which
+    the service should be installed.
+*/
+BOOST_HTTP_PROTO_ZSTD_DECL
+void
+install_compress_service(
+    rts::context& ctx);
+
+} // zstd
+} // http_proto
+} // boost
+
+#endif
@@ -0,0 +1,139 @@
+//
+// Copyright (c) 2025 Mohammad Nejati
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#ifndef BOOST_HTTP_PROTO_ZSTD_DECOMPRESS_HPP
+#define BOOST_HTTP_PROTO_ZSTD_DECOMPRESS_HPP
+
+#include <boost/http_proto/detail/config.hpp>
+#include <boost/http_proto/zstd/stream.hpp>
+
+#include <boost/rts/context_fwd.hpp>
+#include <boost/rts/service.hpp>
+#include <boost/system/error_code.hpp>
+
+namespace boost {
+namespace http_proto {
+namespace zstd {
+
+/** Provides the zstd decompression API.
+
+    Decompression contexts are placed in caller
+    provided memory, so that no allocations take
+    place while a body is decompressed.
+
+    @see
+        @ref install_decompress_service.
+*/
+struct BOOST_SYMBOL_VISIBLE
+    decompress_service
+    : public rts::service
+{
+    /** Return the memory needed by a context.
+
+        @param window_log_max The base 2 logarithm
+        of the largest window size accepted.
+    */
+    virtual
+    std::size_t
+    space_needed(
+        int window_log_max) const noexcept = 0;
+
+    /** Create a context in the given memory.
+
+        The memory must be aligned to 8 bytes and
+        at least as large as @ref space_needed
+        returns for the same argument. The context
+        is not destroyed, the memory may be
+        reused once it is no longer needed.
+
+        @return The context, or `nullptr` if the
+        memory or the argument is unsuitable.
+    */
+    virtual
+    dstream*
+    init_static(
+        void* p,
+        std::size_t n,
+        int window_log_max) const noexcept = 0;
+
+    /** Decompress data.
+
+        @return Zero when a frame is completely
+        decoded and flushed, otherwise a hint for
+        the size of the next input.
+    */
+    virtual
+    std::size_t
+    decompress_stream(
+        dstream& ds,
+        out_buffer& out,
+        in_buffer& in,
+        system::error_code& ec) const noexcept = 0;
+
+    /** Digest a dictionary for decompression.
+
+        The dictionary is referenced, not copied,
+        so `data` must remain valid until the
+        result is passed to @ref free_dictionary.
+
+        @return The dictionary, or `nullptr` if
+        allocation fails.
+    */
+    virtual
+    ddict*
+    create_dictionary(
+        void const* data,
+        std::size_t size) const noexcept = 0;
+
+    /** Free a dictionary.
+    */
+    virtual
+    void
+    free_dictionary(
+        ddict* dd) const noexcept = 0;
+
+    /** Use a dictionary for the following frames.
+
+        The dictionary must outlive its use by
+        the context.
+
+        @return `false` on failure.
+    */
+    virtual
+    bool
+    ref_dictionary(
+        dstream& ds,
+        ddict const* dd) const noexcept = 0;
+
+#ifndef BOOST_HTTP_PROTO_MRDOCS
+    using key_type = decompress_service;
+#endif
+};
+
+/** Install the zstd decompression service.
+
+    @par Exception Safety
+    Strong guarantee.
+
+    @throw std::invalid_argument If the service is
+    already installed on the context.
+
+    @param ctx Reference to the context on which
+    the service should be installed.
+*/
+BOOST_HTTP_PROTO_ZSTD_DECL
+void
+install_decompress_service(
+    rts::context& ctx);
+
+} // zstd
+} // http_proto
+} // boost
+
+#endif
@@ -0,0 +1,82 @@
+//
+// Copyright (c) 2025 Mohammad Nejati
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#ifndef BOOST_HTTP_PROTO_ZSTD_STREAM_HPP
+#define BOOST_HTTP_PROTO_ZSTD_STREAM_HPP
+
+#include <boost/http_proto/detail/config.hpp>
+
+#include <cstddef>
+
+namespace boost {
+namespace http_proto {
+namespace zstd {
+
+/** An opaque zstd compression context.
+*/
+struct cstream;
+
+/** An opaque zstd decompression context.
+*/
+struct dstream;
+
+/** An opaque digested dictionary for compression.
+*/
+struct cdict;
+
+/** An opaque digested dictionary for decompression.
+*/
+struct ddict;
+
+/** Input of a streaming zstd operation.
+
+    On return, `pos` holds the offset of the
+    first octet which was not consumed.
+*/
+struct in_buffer
+{
+    void const* src;
+    std::size_t size;
+    std::size_t pos;
+};
+
+/** Output of a streaming zstd operation.
+
+    On return, `pos` holds the offset one past
+    the last octet which was written.
+*/
+struct out_buffer
+{
+    void* dst;
+    std::size_t size;
+    std::size_t pos;
+};
+
+/** What a compression call does with buffered data.
+*/
+enum class end_directive
+{
+    /** Consume input, output may be delayed.
+    */
+    continue_,
+
+    /** Write out all buffered data, ending a block.
+    */
+    flush,
+
+    /** Write out all buffered data, ending the frame.
+    */
+    end
+};
+
+} // zstd
+} // http_proto
+} // boost
+
+#endif
@@ -0,0 +1,44 @@
+//
+// Copyright (c) 2025 Mohammad Nejati
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#include <boost/http_proto/compression_dictionary.hpp>
+#include <boost/http_proto/detail/except.hpp>
+
+#include "src/detail/dictionary_service.hpp"
+
+namespace boost {
+namespace http_proto {
+
+void
+install_compression_dictionary(
+    rts::context& ctx,
+    std::uint32_t id,
+    core::string_view data)
+{
+    if(data.empty())
+        detail::throw_invalid_argument();
+
+    auto* svc = ctx.find_service<
+        detail::dictionary_service>();
+    if(! svc)
+        svc = &ctx.make_service<
+            detail::dictionary_service>();
+
+    for(auto const& e : svc->entries)
+    {
+        if(e.id == id)
+            detail::throw_invalid_argument();
+    }
+
+    svc->entries.push_back({ id,
+        std::string(data.data(), data.size()) });
+}
+
+} // http_proto
+} // boost
@@ -0,0 +1,40 @@
+//
+// Copyright (c) 2025 Mohammad Nejati
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#include <boost/http_proto/connection_buffers.hpp>
+
+namespace boost {
+namespace http_proto {
+
+connection_buffers::
+connection_buffers(
+    const rts::context& ctx,
+    memory_resource* mr)
+    : storage_(mr, storage_needed(ctx))
+    , pr_(ctx, storage_.p)
+    , sr_(ctx,
+        static_cast<unsigned char*>(storage_.p) +
+            http_proto::parser::storage_needed(ctx))
+{
+}
+
+std::size_t
+connection_buffers::
+storage_needed(
+    const rts::context& ctx)
+{
+    // both are multiples of the
+    // alignment of any type
+    return
+        http_proto::parser::storage_needed(ctx) +
+        http_proto::serializer::storage_needed(ctx);
+}
+
+} // http_proto
+} // boost
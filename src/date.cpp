@@ -0,0 +1,98 @@
+//
+// Copyright (c) 2025 Mohammad Nejati
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#include <boost/http_proto/date.hpp>
+
+#include "src/detail/date_cache.hpp"
+
+#include <cstdint>
+#include <cstring>
+
+namespace boost {
+namespace http_proto {
+
+namespace {
+
+// 9999-12-31T23:59:59Z
+constexpr std::int64_t max_time = 253402300799;
+
+void
+put2(char* p, unsigned v) noexcept
+{
+    p[0] = static_cast<char>('0' + v / 10);
+    p[1] = static_cast<char>('0' + v % 10);
+}
+
+detail::date_cache cache_;
+
+} // (anon)
+
+core::string_view
+format_date(
+    std::time_t t,
+    char* dest) noexcept
+{
+    static constexpr char const wdays[] =
+        "SunMonTueWedThuFriSat";
+    static constexpr char const months[] =
+        "JanFebMarAprMayJunJulAugSepOctNovDec";
+
+    std::int64_t s = static_cast<std::int64_t>(t);
+    if(s < 0)
+        s = 0;
+    else if(s > max_time)
+        s = max_time;
+
+    auto const days = s / 86400;
+    auto const secs = static_cast<unsigned>(s % 86400);
+
+    // civil_from_days, for days since 1970-01-01
+    // https://howardhinnant.github.io/date_algorithms.html
+    auto const z = days + 719468;
+    auto const era = z / 146097;
+    auto const doe = static_cast<unsigned>(z - era * 146097);
+    auto const yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    auto const doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    auto const mp = (5 * doy + 2) / 153;
+    auto const d = doy - (153 * mp + 2) / 5 + 1;
+    auto const m = mp < 10 ? mp + 3 : mp - 9;
+    auto const y = static_cast<unsigned>(
+        yoe + era * 400 + (m <= 2));
+    auto const wd = static_cast<unsigned>((days + 4) % 7);
+
+    char* p = dest;
+    std::memcpy(p, &wdays[wd * 3], 3);
+    p[3] = ',';
+    p[4] = ' ';
+    put2(p + 5, d);
+    p[7] = ' ';
+    std::memcpy(p + 8, &months[(m - 1) * 3], 3);
+    p[11] = ' ';
+    put2(p + 12, y / 100);
+    put2(p + 14, y % 100);
+    p[16] = ' ';
+    put2(p + 17, secs / 3600);
+    p[19] = ':';
+    put2(p + 20, secs / 60 % 60);
+    p[22] = ':';
+    put2(p + 23, secs % 60);
+    std::memcpy(p + 25, " GMT", 4);
+    return core::string_view(dest, date_size);
+}
+
+core::string_view
+current_date() noexcept
+{
+    static thread_local detail::date_cache::local local;
+    return cache_.get(static_cast<
+        std::int64_t>(std::time(nullptr)), local);
+}
+
+} // http_proto
+} // boost
@@ -0,0 +1,108 @@
+//
+// Copyright (c) 2025 Mohammad Nejati
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#ifndef BOOST_HTTP_PROTO_DETAIL_COMPRESSION_BUDGET_HPP
+#define BOOST_HTTP_PROTO_DETAIL_COMPRESSION_BUDGET_HPP
+
+#include <atomic>
+#include <chrono>
+
+namespace boost {
+namespace http_proto {
+namespace detail {
+
+/** Lowers compression levels to keep within a time budget
+
+    Time spent compressing is accumulated over
+    windows of one second. When a window closes
+    above the budget the level drop is raised by
+    one step, and when it closes below half of the
+    budget it is lowered by one step.
+
+    A window closes only when time is reported,
+    so the drop is not lowered while nothing is
+    being compressed. After an idle period, the
+    first messages are still compressed with the
+    lowered level, and the drop recovers by one
+    step per window once compression resumes.
+
+    All members are safe to call concurrently.
+*/
+class compression_budget
+{
+public:
+    using clock = std::chrono::steady_clock;
+
+    static constexpr int max_level_drop = 9;
+
+    explicit
+    compression_budget(
+        std::chrono::microseconds budget) noexcept
+        : budget_(std::chrono::duration_cast<
+            clock::duration>(budget).count())
+    {
+    }
+
+    // Number of steps by which compression
+    // levels are to be lowered.
+    int
+    level_drop() const noexcept
+    {
+        return level_drop_.load(
+            std::memory_order_relaxed);
+    }
+
+    // Account for time spent compressing, and adjust
+    // the level drop once per second of wall-clock time.
+    void
+    on_compress_time(
+        clock::duration d,
+        clock::time_point tp = clock::now()) noexcept
+    {
+        auto const now = tp.time_since_epoch().count();
+        auto const second =
+            std::chrono::duration_cast<clock::duration>(
+                std::chrono::seconds(1)).count();
+        auto start = window_start_.load(
+            std::memory_order_relaxed);
+        if(now - start >= second &&
+            window_start_.compare_exchange_strong(
+                start, now, std::memory_order_relaxed))
+        {
+            auto const spent = window_spent_.exchange(
+                0, std::memory_order_relaxed);
+            // normalize to the length of the window
+            auto const load =
+                static_cast<double>(spent) * second /
+                static_cast<double>(now - start);
+            auto drop = level_drop_.load(
+                std::memory_order_relaxed);
+            if(load > budget_ && drop < max_level_drop)
+                ++drop;
+            else if(load < budget_ / 2.0 && drop > 0)
+                --drop;
+            level_drop_.store(
+                drop, std::memory_order_relaxed);
+        }
+        window_spent_.fetch_add(
+            d.count(), std::memory_order_relaxed);
+    }
+
+private:
+    clock::rep budget_;
+    std::atomic<clock::rep> window_start_{ 0 };
+    std::atomic<clock::rep> window_spent_{ 0 };
+    std::atomic<int> level_drop_{ 0 };
+};
+
+} // detail
+} // http_proto
+} // boost
+
+#endif
@@ -0,0 +1,133 @@
+//
+// Copyright (c) 2025 Mohammad Nejati
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#ifndef BOOST_HTTP_PROTO_DETAIL_DATE_CACHE_HPP
+#define BOOST_HTTP_PROTO_DETAIL_DATE_CACHE_HPP
+
+#include <boost/http_proto/date.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+
+namespace boost {
+namespace http_proto {
+namespace detail {
+
+/*  The process-wide cache is a seqlock. The
+    first thread to notice a new second formats
+    it while readers copy the last value out,
+    retrying on their own if a write overlaps.
+    The words are atomics so that the racing
+    copy is well-defined.
+*/
+class date_cache
+{
+    static constexpr std::size_t n_words =
+        (date_size + 7) / 8;
+
+    std::atomic<std::uint32_t> seq_{0};
+    std::atomic<std::int64_t> time_{-1};
+    std::atomic<std::uint64_t> words_[n_words];
+
+public:
+    // The last date seen by one thread, so that
+    // calls within the same second are a clock
+    // read and a comparison.
+    struct local
+    {
+        std::int64_t time = -1;
+        char buf[date_size];
+    };
+
+    date_cache() noexcept
+    {
+        for(auto& w : words_)
+            w.store(0, std::memory_order_relaxed);
+    }
+
+    // Number of times a date was formatted
+    // and published.
+    std::uint32_t
+    formats() const noexcept
+    {
+        return seq_.load(
+            std::memory_order_acquire) / 2;
+    }
+
+    // Return the date for t, updating the
+    // thread's copy if it is for another time.
+    core::string_view
+    get(std::int64_t t, local& l) noexcept
+    {
+        if(t != l.time)
+        {
+            get(t, l.buf);
+            l.time = t;
+        }
+        return core::string_view(
+            l.buf, date_size);
+    }
+
+    // Copy the date for t into dest, formatting
+    // and publishing it if it is not cached.
+    void
+    get(std::int64_t t, char* dest) noexcept
+    {
+        std::uint64_t tmp[n_words] = {};
+        auto s0 = seq_.load(
+            std::memory_order_acquire);
+        if((s0 & 1) == 0)
+        {
+            if(time_.load(
+                std::memory_order_relaxed) == t)
+            {
+                for(std::size_t i = 0; i < n_words; ++i)
+                    tmp[i] = words_[i].load(
+                        std::memory_order_relaxed);
+                std::atomic_thread_fence(
+                    std::memory_order_acquire);
+                if(seq_.load(
+                    std::memory_order_relaxed) == s0)
+                {
+                    std::memcpy(dest, tmp, date_size);
+                    return;
+                }
+            }
+            else if(seq_.compare_exchange_strong(
+                s0, s0 + 1,
+                std::memory_order_relaxed))
+            {
+                std::atomic_thread_fence(
+                    std::memory_order_release);
+                format_date(
+                    static_cast<std::time_t>(t),
+                    reinterpret_cast<char*>(tmp));
+                for(std::size_t i = 0; i < n_words; ++i)
+                    words_[i].store(tmp[i],
+                        std::memory_order_relaxed);
+                time_.store(t,
+                    std::memory_order_relaxed);
+                seq_.store(s0 + 2,
+                    std::memory_order_release);
+                std::memcpy(dest, tmp, date_size);
+                return;
+            }
+        }
+        // a write is in progress
+        format_date(
+            static_cast<std::time_t>(t), dest);
+    }
+};
+
+} // detail
+} // http_proto
+} // boost
+
+#endif
@@ -0,0 +1,68 @@
+//
+// Copyright (c) 2025 Mohammad Nejati
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#ifndef BOOST_HTTP_PROTO_DETAIL_DICTIONARY_SERVICE_HPP
+#define BOOST_HTTP_PROTO_DETAIL_DICTIONARY_SERVICE_HPP
+
+#include <boost/rts/context.hpp>
+#include <boost/rts/service.hpp>
+
+#include <cstdint>
+#include <deque>
+#include <string>
+
+namespace boost {
+namespace http_proto {
+namespace detail {
+
+/** Shared compression dictionaries of a context
+
+    The serializer and parser services digest
+    the dictionaries when they are constructed,
+    referencing the content held here.
+*/
+class dictionary_service
+    : public rts::service
+{
+public:
+    struct entry
+    {
+        std::uint32_t id;
+        std::string data;
+    };
+
+    // deque keeps the content in place
+    // as dictionaries are added
+    std::deque<entry> entries;
+
+    explicit
+    dictionary_service(
+        const rts::context&) noexcept
+    {
+    }
+
+    // Return the dictionaries installed on
+    // the context, or nullptr if there are none.
+    static
+    std::deque<entry> const*
+    find(const rts::context& ctx) noexcept
+    {
+        auto* svc = ctx.find_service<
+            dictionary_service>();
+        if(! svc)
+            return nullptr;
+        return &svc->entries;
+    }
+};
+
+} // detail
+} // http_proto
+} // boost
+
+#endif
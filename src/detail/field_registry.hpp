@@ -0,0 +1,80 @@
+//
+// Copyright (c) 2025 Mohammad Nejati
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#ifndef BOOST_HTTP_PROTO_DETAIL_FIELD_REGISTRY_HPP
+#define BOOST_HTTP_PROTO_DETAIL_FIELD_REGISTRY_HPP
+
+#include <boost/http_proto/detail/header.hpp>
+#include <boost/http_proto/field.hpp>
+
+#include <boost/rts/context.hpp>
+#include <boost/rts/service.hpp>
+#include <boost/url/grammar/ci_string.hpp>
+
+#include <deque>
+#include <string>
+#include <unordered_map>
+
+namespace boost {
+namespace http_proto {
+namespace detail {
+
+/** Field names registered on a context
+
+    The name with id `first_registered_field + i`
+    is `names[i]`. Parsers look names up here
+    when they are not in the field enumeration.
+*/
+class field_registry
+    : public rts::service
+{
+public:
+    // deque keeps the names in place
+    // as more are registered
+    std::deque<std::string> names;
+    std::unordered_map<
+        core::string_view,
+        field,
+        grammar::ci_hash,
+        grammar::ci_equal> ids;
+
+    explicit
+    field_registry(
+        const rts::context&) noexcept
+    {
+    }
+
+    // Return the id of name, or
+    // unknown_field if it is not registered.
+    field
+    string_to_field(
+        core::string_view name) const noexcept
+    {
+        auto const it = ids.find(name);
+        if(it == ids.end())
+            return header::unknown_field;
+        return it->second;
+    }
+
+    // Return the registry of the context,
+    // or nullptr if no name is registered.
+    static
+    field_registry const*
+    find(const rts::context& ctx) noexcept
+    {
+        return ctx.find_service<
+            field_registry>();
+    }
+};
+
+} // detail
+} // http_proto
+} // boost
+
+#endif
@@ -13,7 +13,9 @@
 
 #include <boost/core/exchange.hpp>
 #include <limits>
+#include <string>
 #include <fcntl.h>
+#include <stdlib.h>
 #include <sys/types.h>
 #include <sys/uio.h>
 #include <sys/stat.h>
@@ -26,6 +28,26 @@
 # endif
 #endif
 
+#if ! defined(BOOST_HTTP_PROTO_NO_POSIX_PREADV)
+# if defined(__APPLE__) || (defined(__ANDROID__) && (__ANDROID_API__ < 24))
+#  define BOOST_HTTP_PROTO_NO_POSIX_PREADV
+# endif
+#endif
+
+#if ! defined(BOOST_HTTP_PROTO_NO_POSIX_FALLOCATE)
+# if ! defined(__linux__)
+#  define BOOST_HTTP_PROTO_NO_POSIX_FALLOCATE
+# endif
+#endif
+
+#if ! defined(BOOST_HTTP_PROTO_USE_POSIX_PREADV)
+# if ! defined(BOOST_HTTP_PROTO_NO_POSIX_PREADV)
+#  define BOOST_HTTP_PROTO_USE_POSIX_PREADV 1
+# else
+#  define BOOST_HTTP_PROTO_USE_POSIX_PREADV 0
+# endif
+#endif
+
 #if ! defined(BOOST_HTTP_PROTO_USE_POSIX_FADVISE)
 # if ! defined(BOOST_HTTP_PROTO_NO_POSIX_FADVISE)
 #  define BOOST_HTTP_PROTO_USE_POSIX_FADVISE 1
@@ -34,6 +56,14 @@
 # endif
 #endif
 
+#if ! defined(BOOST_HTTP_PROTO_USE_POSIX_FALLOCATE)
+# if ! defined(BOOST_HTTP_PROTO_NO_POSIX_FALLOCATE)
+#  define BOOST_HTTP_PROTO_USE_POSIX_FALLOCATE 1
+# else
+#  define BOOST_HTTP_PROTO_USE_POSIX_FALLOCATE 0
+# endif
+#endif
+
 namespace boost {
 namespace http_proto {
 namespace detail {
@@ -207,6 +237,65 @@ open(char const* path, file_mode mode, system::error_code& ec)
     ec = {};
 }
 
+// Open a new file with no name, which is
+// removed when closed, even if the process
+// dies. O_TMPFILE does this in one call on
+// Linux, elsewhere the file is unlinked
+// right after it is created.
+void
+file_posix::
+open_temp(char const* dir, system::error_code& ec)
+{
+    auto const ev = native_close(fd_);
+    if(ev)
+    {
+        ec.assign(ev,
+            system::system_category());
+        return;
+    }
+    if(! dir || ! *dir)
+    {
+        dir = ::getenv("TMPDIR");
+        if(! dir || ! *dir)
+            dir = "/tmp";
+    }
+#ifdef O_TMPFILE
+    for(;;)
+    {
+        fd_ = ::open(dir, O_TMPFILE | O_RDWR, 0600);
+        if(fd_ != -1)
+        {
+            ec = {};
+            return;
+        }
+        auto const ev = errno;
+        if(ev == EINTR)
+            continue;
+        // the file system has no support
+        if( ev != EOPNOTSUPP &&
+            ev != EISDIR &&
+            ev != EINVAL)
+        {
+            ec.assign(ev,
+                system::system_category());
+            return;
+        }
+        break;
+    }
+#endif
+    std::string path(dir);
+    path += "/http_proto-XXXXXX";
+    fd_ = ::mkstemp(&path[0]);
+    if(fd_ == -1)
+    {
+        ec.assign(errno,
+            system::system_category());
+        return;
+    }
+    ::unlink(path.c_str());
+    ec = {};
+}
+
 std::uint64_t
 file_posix::
 size(
@@ -351,6 +440,306 @@ write(void const* buffer, std::size_t n,
     return nwritten;
 }
 
+std::size_t
+file_posix::
+read_at(std::uint64_t offset, void* buffer, std::size_t n,
+    system::error_code& ec)
+{
+    if(fd_ == -1)
+    {
+        ec = make_error_code(
+            system::errc::bad_file_descriptor);
+        return 0;
+    }
+    std::size_t nread = 0;
+    while(n > 0)
+    {
+        // <limits> not required to define SSIZE_MAX so we avoid it
+        constexpr auto ssmax =
+            static_cast<std::size_t>((std::numeric_limits<
+                decltype(::pread(fd_, buffer, n, 0))>::max)());
+        auto const amount = (std::min)(
+            n, ssmax);
+        auto const result = ::pread(fd_, buffer, amount,
+            static_cast<::off_t>(offset));
+        if(result == -1)
+        {
+            auto const ev = errno;
+            if(ev == EINTR)
+                continue;
+            ec.assign(ev,
+                system::system_category());
+            return nread;
+        }
+        if(result == 0)
+        {
+            // short read
+            return nread;
+        }
+        n -= result;
+        nread += result;
+        offset += result;
+        buffer = static_cast<char*>(buffer) + result;
+    }
+    return nread;
+}
+
+std::size_t
+file_posix::
+write_at(std::uint64_t offset, void const* buffer, std::size_t n,
+    system::error_code& ec)
+{
+    if(fd_ == -1)
+    {
+        ec = make_error_code(
+            system::errc::bad_file_descriptor);
+        return 0;
+    }
+    std::size_t nwritten = 0;
+    while(n > 0)
+    {
+        // <limits> not required to define SSIZE_MAX so we avoid it
+        constexpr auto ssmax =
+            static_cast<std::size_t>((std::numeric_limits<
+                decltype(::pwrite(fd_, buffer, n, 0))>::max)());
+        auto const amount = (std::min)(
+            n, ssmax);
+        auto const result = ::pwrite(fd_, buffer, amount,
+            static_cast<::off_t>(offset));
+        if(result == -1)
+        {
+            auto const ev = errno;
+            if(ev == EINTR)
+                continue;
+            ec.assign(ev,
+                system::system_category());
+            return nwritten;
+        }
+        n -= result;
+        nwritten += result;
+        offset += result;
+        buffer = static_cast<char const*>(buffer) + result;
+    }
+    return nwritten;
+}
+
+#if BOOST_HTTP_PROTO_USE_POSIX_PREADV
+
+namespace {
+
+// Fill iov with the unfinished part of the
+// buffers, skipping the first `done` bytes,
+// and return the number of entries used.
+template<class Buffers>
+int
+make_iovecs(
+    ::iovec (&iov)[16],
+    Buffers const& bs,
+    std::size_t done) noexcept
+{
+    int n = 0;
+    for(auto const& b : bs)
+    {
+        if(done >= b.size())
+        {
+            done -= b.size();
+            continue;
+        }
+        iov[n].iov_base = const_cast<void*>(
+            static_cast<void const*>(
+                static_cast<char const*>(b.data()) + done));
+        iov[n].iov_len = b.size() - done;
+        done = 0;
+        if(++n == 16)
+            break;
+    }
+    return n;
+}
+
+} // (anon)
+
+std::size_t
+file_posix::
+read_at(std::uint64_t offset,
+    boost::span<buffers::mutable_buffer const> bs,
+    system::error_code& ec)
+{
+    if(fd_ == -1)
+    {
+        ec = make_error_code(
+            system::errc::bad_file_descriptor);
+        return 0;
+    }
+    std::size_t nread = 0;
+    for(;;)
+    {
+        ::iovec iov[16];
+        auto const n = make_iovecs(iov, bs, nread);
+        if(n == 0)
+            break;
+        auto const result = ::preadv(fd_, iov, n,
+            static_cast<::off_t>(offset + nread));
+        if(result == -1)
+        {
+            auto const ev = errno;
+            if(ev == EINTR)
+                continue;
+            ec.assign(ev,
+                system::system_category());
+            return nread;
+        }
+        if(result == 0)
+        {
+            // short read
+            return nread;
+        }
+        nread += result;
+    }
+    return nread;
+}
+
+std::size_t
+file_posix::
+write_at(std::uint64_t offset,
+    boost::span<buffers::const_buffer const> bs,
+    system::error_code& ec)
+{
+    if(fd_ == -1)
+    {
+        ec = make_error_code(
+            system::errc::bad_file_descriptor);
+        return 0;
+    }
+    std::size_t nwritten = 0;
+    for(;;)
+    {
+        ::iovec iov[16];
+        auto const n = make_iovecs(iov, bs, nwritten);
+        if(n == 0)
+            break;
+        auto const result = ::pwritev(fd_, iov, n,
+            static_cast<::off_t>(offset + nwritten));
+        if(result == -1)
+        {
+            auto const ev = errno;
+            if(ev == EINTR)
+                continue;
+            ec.assign(ev,
+                system::system_category());
+            return nwritten;
+        }
+        nwritten += result;
+    }
+    return nwritten;
+}
+
+#else
+
+std::size_t
+file_posix::
+read_at(std::uint64_t offset,
+    boost::span<buffers::mutable_buffer const> bs,
+    system::error_code& ec)
+{
+    std::size_t nread = 0;
+    for(auto const& b : bs)
+    {
+        auto const n = read_at(
+            offset + nread, b.data(), b.size(), ec);
+        nread += n;
+        if(ec.failed() || n != b.size())
+            break;
+    }
+    return nread;
+}
+
+std::size_t
+file_posix::
+write_at(std::uint64_t offset,
+    boost::span<buffers::const_buffer const> bs,
+    system::error_code& ec)
+{
+    std::size_t nwritten = 0;
+    for(auto const& b : bs)
+    {
+        auto const n = write_at(
+            offset + nwritten, b.data(), b.size(), ec);
+        nwritten += n;
+        if(ec.failed() || n != b.size())
+            break;
+    }
+    return nwritten;
+}
+
+#endif
+
+// Reserve blocks for the first n bytes without
+// changing the size of the file, so that a
+// truncated upload does not leave zeros at the
+// end. posix_fallocate is not used because it
+// extends the file, and falls back to writing
+// zeros where the file system has no support.
+void
+file_posix::
+allocate(std::uint64_t n,
+    system::error_code& ec)
+{
+    if(fd_ == -1)
+    {
+        ec = make_error_code(
+            system::errc::bad_file_descriptor);
+        return;
+    }
+#if BOOST_HTTP_PROTO_USE_POSIX_FALLOCATE
+    constexpr auto max = static_cast<std::uint64_t>(
+        (std::numeric_limits<::off_t>::max)());
+    if(n > max)
+        n = max;
+    while(n > 0 && ::fallocate(fd_, FALLOC_FL_KEEP_SIZE,
+        0, static_cast<::off_t>(n)) != 0)
+    {
+        auto const ev = errno;
+        if(ev == EINTR)
+            continue;
+        // the file system has no support
+        if(ev == EOPNOTSUPP || ev == ENOSYS)
+            break;
+        ec.assign(ev,
+            system::system_category());
+        return;
+    }
+#else
+    (void)n;
+#endif
+    ec = {};
+}
+
+void
+file_posix::
+sync(system::error_code& ec)
+{
+    if(fd_ == -1)
+    {
+        ec = make_error_code(
+            system::errc::bad_file_descriptor);
+        return;
+    }
+#if defined(__APPLE__)
+    auto const result = ::fsync(fd_);
+#else
+    // metadata not needed to read the
+    // data back, such as times, is skipped
+    auto const result = ::fdatasync(fd_);
+#endif
+    if(result != 0)
+    {
+        ec.assign(errno,
+            system::system_category());
+        return;
+    }
+    ec = {};
+}
+
 } // detail
 } // http_proto
 } // boost
@@ -220,6 +220,27 @@ open(char const* path, file_mode mode,
 #endif
 }
 
+// The directory is not used, tmpfile
+// picks the location itself
+void
+file_stdio::
+open_temp(char const*, system::error_code& ec)
+{
+    if(f_)
+    {
+        fclose(f_);
+        f_ = nullptr;
+    }
+    f_ = std::tmpfile();
+    if(! f_)
+    {
+        ec.assign(errno,
+            system::generic_category());
+        return;
+    }
+    ec = {};
+}
+
 std::uint64_t
 file_stdio::
 size(
@@ -352,6 +373,103 @@ write(void const* buffer, std::size_t n,
     return nwritten;
 }
 
+// stdio has no positional I/O,
+// so the position is moved instead
+
+std::size_t
+file_stdio::
+read_at(std::uint64_t offset, void* buffer, std::size_t n,
+    system::error_code& ec)
+{
+    seek(offset, ec);
+    if(ec.failed())
+        return 0;
+    return read(buffer, n, ec);
+}
+
+std::size_t
+file_stdio::
+write_at(std::uint64_t offset, void const* buffer, std::size_t n,
+    system::error_code& ec)
+{
+    seek(offset, ec);
+    if(ec.failed())
+        return 0;
+    return write(buffer, n, ec);
+}
+
+std::size_t
+file_stdio::
+read_at(std::uint64_t offset,
+    boost::span<buffers::mutable_buffer const> bs,
+    system::error_code& ec)
+{
+    std::size_t nread = 0;
+    for(auto const& b : bs)
+    {
+        auto const n = read_at(
+            offset + nread, b.data(), b.size(), ec);
+        nread += n;
+        if(ec.failed() || n != b.size())
+            break;
+    }
+    return nread;
+}
+
+std::size_t
+file_stdio::
+write_at(std::uint64_t offset,
+    boost::span<buffers::const_buffer const> bs,
+    system::error_code& ec)
+{
+    std::size_t nwritten = 0;
+    for(auto const& b : bs)
+    {
+        auto const n = write_at(
+            offset + nwritten, b.data(), b.size(), ec);
+        nwritten += n;
+        if(ec.failed() || n != b.size())
+            break;
+    }
+    return nwritten;
+}
+
+// stdio has no way to reserve blocks
+void
+file_stdio::
+allocate(std::uint64_t,
+    system::error_code& ec)
+{
+    if(! f_)
+    {
+        ec = make_error_code(
+            system::errc::bad_file_descriptor);
+        return;
+    }
+    ec = {};
+}
+
+// This only hands the data to the system,
+// stdio cannot ask for it to reach the device
+void
+file_stdio::
+sync(system::error_code& ec)
+{
+    if(! f_)
+    {
+        ec = make_error_code(
+            system::errc::bad_file_descriptor);
+        return;
+    }
+    if(std::fflush(f_) != 0)
+    {
+        ec.assign(errno,
+            system::generic_category());
+        return;
+    }
+    ec = {};
+}
+
 } // detail
 } // http_proto
 } // boost
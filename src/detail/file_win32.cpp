@@ -15,11 +15,27 @@
 #include <boost/core/exchange.hpp>
 #include <boost/system/errc.hpp>
 #include <boost/winapi/access_rights.hpp>
+#include <boost/winapi/directory_management.hpp>
 #include <boost/winapi/error_codes.hpp>
 #include <boost/winapi/get_last_error.hpp>
+#include <boost/winapi/overlapped.hpp>
 #include <limits>
 #include <utility>
 
+#if ! defined(BOOST_USE_WINDOWS_H)
+extern "C" {
+BOOST_WINAPI_IMPORT boost::winapi::BOOL_ BOOST_WINAPI_WINAPI_CC
+FlushFileBuffers(boost::winapi::HANDLE_ hFile);
+
+BOOST_WINAPI_IMPORT boost::winapi::UINT_ BOOST_WINAPI_WINAPI_CC
+GetTempFileNameW(
+    boost::winapi::LPCWSTR_ lpPathName,
+    boost::winapi::LPCWSTR_ lpPrefixString,
+    boost::winapi::UINT_ uUnique,
+    boost::winapi::LPWSTR_ lpTempFileName);
+}
+#endif
+
 namespace boost {
 namespace http_proto {
 namespace detail {
@@ -222,6 +238,63 @@ open(char const* path, file_mode mode,
     ec = {};
 }
 
+// Open a new file which is deleted when the
+// handle is closed. GetTempFileNameW creates
+// it under a unique name, which is then
+// reopened with FILE_FLAG_DELETE_ON_CLOSE.
+void
+file_win32::
+open_temp(char const* dir, system::error_code& ec)
+{
+    if(h_ != winapi::INVALID_HANDLE_VALUE_)
+    {
+        winapi::CloseHandle(h_);
+        h_ = winapi::INVALID_HANDLE_VALUE_;
+    }
+    winapi::WCHAR_ temp_dir[winapi::MAX_PATH_ + 1];
+    winapi::WCHAR_ const* d = temp_dir;
+    detail::win32_unicode_path unicode_path(
+        dir && *dir ? dir : "", ec);
+    if(ec)
+        return;
+    if(dir && *dir)
+    {
+        d = unicode_path.c_str();
+    }
+    else if(! winapi::GetTempPathW(
+        winapi::MAX_PATH_ + 1, temp_dir))
+    {
+        ec.assign(winapi::GetLastError(),
+            system::system_category());
+        return;
+    }
+    winapi::WCHAR_ name[winapi::MAX_PATH_];
+    if(! ::GetTempFileNameW(d, L"hp", 0, name))
+    {
+        ec.assign(winapi::GetLastError(),
+            system::system_category());
+        return;
+    }
+    h_ = ::CreateFileW(
+        name,
+        winapi::GENERIC_READ_ |
+            winapi::GENERIC_WRITE_,
+        0,
+        NULL,
+        winapi::CREATE_ALWAYS_,
+        0x00000100 | // FILE_ATTRIBUTE_TEMPORARY
+        0x04000000,  // FILE_FLAG_DELETE_ON_CLOSE
+        NULL);
+    if(h_ == winapi::INVALID_HANDLE_VALUE_)
+    {
+        ec.assign(winapi::GetLastError(),
+            system::system_category());
+        winapi::DeleteFileW(name);
+        return;
+    }
+    ec = {};
+}
+
 std::uint64_t
 file_win32::
 size(
@@ -378,6 +451,176 @@ write(void const* buffer, std::size_t n,
     return nwritten;
 }
 
+std::size_t
+file_win32::
+read_at(std::uint64_t offset, void* buffer, std::size_t n,
+    system::error_code& ec)
+{
+    if(h_ == winapi::INVALID_HANDLE_VALUE_)
+    {
+        ec = make_error_code(
+            system::errc::bad_file_descriptor);
+        return 0;
+    }
+    std::size_t nread = 0;
+    while(n > 0)
+    {
+        winapi::DWORD_ amount;
+        if(n > (std::numeric_limits<
+                winapi::DWORD_>::max)())
+            amount = (std::numeric_limits<
+                winapi::DWORD_>::max)();
+        else
+            amount = static_cast<
+                winapi::DWORD_>(n);
+        // the offset of a synchronous
+        // read is taken from the overlapped
+        winapi::OVERLAPPED_ ov = {};
+        ov.Offset = static_cast<winapi::DWORD_>(offset);
+        ov.OffsetHigh = static_cast<winapi::DWORD_>(offset >> 32);
+        winapi::DWORD_ bytesRead;
+        if(! ::ReadFile(h_, buffer, amount, &bytesRead,
+            reinterpret_cast<::_OVERLAPPED*>(&ov)))
+        {
+            auto const dwError = winapi::GetLastError();
+            if(dwError != winapi::ERROR_HANDLE_EOF_)
+                ec.assign(dwError,
+                    system::system_category());
+            else
+                ec = {};
+            return nread;
+        }
+        if(bytesRead == 0)
+            return nread;
+        n -= bytesRead;
+        nread += bytesRead;
+        offset += bytesRead;
+        buffer = static_cast<char*>(buffer) + bytesRead;
+    }
+    ec = {};
+    return nread;
+}
+
+std::size_t
+file_win32::
+write_at(std::uint64_t offset, void const* buffer, std::size_t n,
+    system::error_code& ec)
+{
+    if(h_ == winapi::INVALID_HANDLE_VALUE_)
+    {
+        ec = make_error_code(
+            system::errc::bad_file_descriptor);
+        return 0;
+    }
+    std::size_t nwritten = 0;
+    while(n > 0)
+    {
+        winapi::DWORD_ amount;
+        if(n > (std::numeric_limits<
+                winapi::DWORD_>::max)())
+            amount = (std::numeric_limits<
+                winapi::DWORD_>::max)();
+        else
+            amount = static_cast<
+                winapi::DWORD_>(n);
+        winapi::OVERLAPPED_ ov = {};
+        ov.Offset = static_cast<winapi::DWORD_>(offset);
+        ov.OffsetHigh = static_cast<winapi::DWORD_>(offset >> 32);
+        winapi::DWORD_ bytesWritten;
+        if(! ::WriteFile(h_, buffer, amount, &bytesWritten,
+            reinterpret_cast<::_OVERLAPPED*>(&ov)))
+        {
+            auto const dwError = winapi::GetLastError();
+            if(dwError != winapi::ERROR_HANDLE_EOF_)
+                ec.assign(dwError,
+                    system::system_category());
+            else
+                ec = {};
+            return nwritten;
+        }
+        if(bytesWritten == 0)
+            return nwritten;
+        n -= bytesWritten;
+        nwritten += bytesWritten;
+        offset += bytesWritten;
+        buffer = static_cast<char const*>(buffer) + bytesWritten;
+    }
+    ec = {};
+    return nwritten;
+}
+
+std::size_t
+file_win32::
+read_at(std::uint64_t offset,
+    boost::span<buffers::mutable_buffer const> bs,
+    system::error_code& ec)
+{
+    std::size_t nread = 0;
+    for(auto const& b : bs)
+    {
+        auto const n = read_at(
+            offset + nread, b.data(), b.size(), ec);
+        nread += n;
+        if(ec.failed() || n != b.size())
+            break;
+    }
+    return nread;
+}
+
+std::size_t
+file_win32::
+write_at(std::uint64_t offset,
+    boost::span<buffers::const_buffer const> bs,
+    system::error_code& ec)
+{
+    std::size_t nwritten = 0;
+    for(auto const& b : bs)
+    {
+        auto const n = write_at(
+            offset + nwritten, b.data(), b.size(), ec);
+        nwritten += n;
+        if(ec.failed() || n != b.size())
+            break;
+    }
+    return nwritten;
+}
+
+// NTFS has no way to reserve blocks without
+// changing the size of the file, the large
+// writes of the caller keep it contiguous
+void
+file_win32::
+allocate(std::uint64_t,
+    system::error_code& ec)
+{
+    if(h_ == winapi::INVALID_HANDLE_VALUE_)
+    {
+        ec = make_error_code(
+            system::errc::bad_file_descriptor);
+        return;
+    }
+    ec = {};
+}
+
+void
+file_win32::
+sync(system::error_code& ec)
+{
+    if(h_ == winapi::INVALID_HANDLE_VALUE_)
+    {
+        ec = make_error_code(
+            system::errc::bad_file_descriptor);
+        return;
+    }
+    if(! ::FlushFileBuffers(h_))
+    {
+        ec.assign(winapi::GetLastError(),
+            system::system_category());
+        return;
+    }
+    ec = {};
+}
+
 } // detail
 } // http_proto
 } // boost
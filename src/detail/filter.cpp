@@ -57,6 +57,10 @@ process(
             return rv;
         }
 
+        // no progress, e.g. while waiting on a worker
+        if(rs.in_bytes == 0 && rs.out_bytes == 0)
+            return rv;
+
         buffers::remove_prefix(out, rs.out_bytes);
         buffers::remove_prefix(in, rs.in_bytes);
 
@@ -8,6 +8,7 @@
 // Official repository: https://github.com/cppalliance/http_proto
 //
 
+#include "src/detail/field_registry.hpp"
 #include "src/rfc/detail/rules.hpp"
 #include "src/rfc/detail/transfer_coding_rule.hpp"
 
@@ -48,7 +49,8 @@ operator+(
         static_cast<
             offset_type>(vp + dv),
         vn,
-        id };
+        id,
+        flags };
 }
 
 auto
@@ -65,12 +67,14 @@ operator-(
         static_cast<
             offset_type>(vp - dv),
         vn,
-        id };
+        id,
+        flags };
 }
 
 //------------------------------------------------
 
 constexpr field header::unknown_field;
+constexpr field header::first_registered_field;
 
 //------------------------------------------------
 
@@ -140,11 +144,13 @@ swap(header& h) noexcept
     std::swap(cbuf, h.cbuf);
     std::swap(buf, h.buf);
     std::swap(cap, h.cap);
+    std::swap(slack, h.slack);
     std::swap(size, h.size);
     std::swap(count, h.count);
     std::swap(prefix, h.prefix);
     std::swap(version, h.version);
     std::swap(md, h.md);
+    std::swap(nf, h.nf);
     switch(kind)
     {
     default:
@@ -341,10 +347,12 @@ assign_to(
     auto const buf_ = dest.buf;
     auto const cbuf_ = dest.cbuf;
     auto const cap_ = dest.cap;
+    auto const slack_ = dest.slack;
     dest = *this;
     dest.buf = buf_;
     dest.cbuf = cbuf_;
     dest.cap = cap_;
+    dest.slack = slack_;
 }
 
 //------------------------------------------------
@@ -380,6 +388,19 @@ maybe_count(
     return std::size_t(-1);
 }
 
+// true if id is a constant of the
+// field enumeration, rather than
+// unknown or registered on a context
+bool
+header::
+is_enumerated(
+    field id) noexcept
+{
+    return
+        id != unknown_field &&
+        id < first_registered_field;
+}
+
 bool
 header::
 is_special(
@@ -418,15 +439,16 @@ on_start_line()
     update_payload();
 }
 
-// called after a field is inserted
-void
+// called after a field is inserted,
+// returns the flags for its entry
+unsigned char
 header::
 on_insert(
     field id,
     core::string_view v)
 {
     if(kind == detail::kind::fields)
-        return;
+        return 0;
     switch(id)
     {
     case field::content_encoding:
@@ -444,29 +466,33 @@ on_insert(
     default:
         break;
     }
+    return 0;
 }
 
-// called when one field is erased
+// called when one field is erased,
+// with the flags of its entry
 void
 header::
-on_erase(field id)
+on_erase(
+    field id,
+    unsigned char flags)
 {
     if(kind == detail::kind::fields)
         return;
     switch(id)
     {
     case field::connection:
-        return on_erase_connection();
+        return on_erase_connection(flags);
     case field::content_encoding:
-        return on_erase_content_encoding();
+        return on_erase_content_encoding(flags);
     case field::content_length:
-        return on_erase_content_length();
+        return on_erase_content_length(flags);
     case field::expect:
-        return on_erase_expect();
+        return on_erase_expect(flags);
     case field::transfer_encoding:
-        return on_erase_transfer_encoding();
+        return on_erase_transfer_encoding(flags);
     case field::upgrade:
-        return on_erase_upgrade();
+        return on_erase_upgrade(flags);
     default:
         break;
     }
@@ -477,39 +503,47 @@ on_erase(field id)
 /*
     https://datatracker.ietf.org/doc/html/rfc7230#section-6.1
 */
-void
+unsigned char
 header::
 on_insert_connection(
     core::string_view v)
 {
     ++md.connection.count;
-    if(md.connection.ec.failed())
-        return;
+    unsigned char flags = 0;
     auto rv = grammar::parse(
         v, list_rule(token_rule, 1));
     if(! rv)
     {
-        md.connection.ec =
-            BOOST_HTTP_PROTO_ERR(
-                error::bad_connection);
-        return;
+        flags = flag_bad;
     }
-    md.connection.ec = {};
-    for(auto t : *rv)
+    else
     {
-        if(grammar::ci_is_equal(
-                t, "close"))
-            md.connection.close = true;
-        else if(grammar::ci_is_equal(
-                t, "keep-alive"))
-            md.connection.keep_alive = true;
-        else if(grammar::ci_is_equal(
-                t, "upgrade"))
-            md.connection.upgrade = true;
+        for(auto t : *rv)
+        {
+            if(grammar::ci_is_equal(
+                    t, "close"))
+                flags |= flag_close;
+            else if(grammar::ci_is_equal(
+                    t, "keep-alive"))
+                flags |= flag_keep_alive;
+            else if(grammar::ci_is_equal(
+                    t, "upgrade"))
+                flags |= flag_upgrade;
+        }
     }
+    if(flags & flag_bad)
+        ++nf.bad_connection;
+    if(flags & flag_close)
+        ++nf.close;
+    if(flags & flag_keep_alive)
+        ++nf.keep_alive;
+    if(flags & flag_upgrade)
+        ++nf.upgrade;
+    update_connection();
+    return flags;
 }
 
-void
+unsigned char
 header::
 on_insert_content_length(
     core::string_view v)
@@ -520,32 +554,33 @@ on_insert_content_length(
         std::uint64_t> num_rule{};
 
     ++md.content_length.count;
-    if(md.content_length.ec.failed())
-        return;
     auto rv =
         grammar::parse(v, num_rule);
     if(! rv)
     {
         // parse failure
+        ++nf.bad_content_length;
         md.content_length.ec =
             BOOST_HTTP_PROTO_ERR(
             error::bad_content_length);
         md.content_length.value = 0;
         update_payload();
-        return;
+        return flag_bad;
     }
+    if(md.content_length.ec.failed())
+        return 0;
     if(md.content_length.count == 1)
     {
         // one value
         md.content_length.ec = {};
         md.content_length.value = *rv;
         update_payload();
-        return;
+        return 0;
     }
     if(*rv == md.content_length.value)
     {
         // ok: duplicate value
-        return;
+        return 0;
     }
     // bad: different values
     md.content_length.ec =
@@ -553,204 +588,178 @@ on_insert_content_length(
             error::multiple_content_length);
     md.content_length.value = 0;
     update_payload();
+    return 0;
 }
 
-void
+unsigned char
 header::
 on_insert_expect(
     core::string_view v)
 {
     ++md.expect.count;
     if(kind != detail::kind::request)
-        return;
-    if(md.expect.ec.failed())
-        return;
-    // VFALCO Should we allow duplicate
-    // Expect fields that have 100-continue?
-    if( md.expect.count > 1 ||
-        ! grammar::ci_is_equal(v,
+        return 0;
+    unsigned char flags = 0;
+    if(grammar::ci_is_equal(v,
             "100-continue"))
-    {
-        md.expect.ec =
-            BOOST_HTTP_PROTO_ERR(
-                error::bad_expect);
-        md.expect.is_100_continue = false;
-        return;
-    }
-    md.expect.is_100_continue = true;
+        flags = flag_100_continue;
+    update_expect(flags);
+    return flags;
 }
 
-void
+unsigned char
 header::
 on_insert_transfer_encoding(
     core::string_view v)
 {
     ++md.transfer_encoding.count;
-    if(md.transfer_encoding.ec.failed())
-        return;
-
+    unsigned char flags = 0;
     auto rv = grammar::parse(
         v, list_rule(transfer_coding_rule, 1));
     if(! rv)
     {
         // parse error
-        goto error;
+        flags = flag_bad;
     }
-    for(auto t : *rv)
+    else
     {
-        if(! md.transfer_encoding.is_chunked)
+        for(auto t : *rv)
         {
+            if(flags & flag_chunked)
+            {
+                // chunked must be last
+                // and appear only once
+                flags = flag_bad;
+                break;
+            }
             if(t.id == transfer_coding_rule_t::chunked)
-                md.transfer_encoding.is_chunked = true;
-            continue;
-        }
-        if(t.id == transfer_coding_rule_t::chunked)
-        {
-            // chunked appears twice
-            goto error;
+                flags |= flag_chunked;
         }
-        // chunked must be last
-        goto error;
     }
-    update_payload();
-    return;
-
-error:
-    md.transfer_encoding.ec =
-        BOOST_HTTP_PROTO_ERR(
-            error::bad_transfer_encoding);
-    md.transfer_encoding.is_chunked = false;
-    update_payload();
+    if(flags & flag_bad)
+        ++nf.bad_transfer_encoding;
+    if(flags & flag_chunked)
+        ++nf.chunked;
+    // this is the last field
+    update_transfer_encoding(
+        (flags & flag_chunked) != 0);
+    return flags;
 }
 
-void
+unsigned char
 header::
 on_insert_content_encoding(
     core::string_view v)
 {
     ++md.content_encoding.count;
-    if(md.content_encoding.ec.failed())
-        return;
-
+    auto coding = content_coding::unknown;
+    unsigned char flags = 0;
     auto rv = grammar::parse(
         v, list_rule(token_rule, 1));
-    if(!rv)
-    {
-        md.content_encoding.ec =
-            BOOST_HTTP_PROTO_ERR(
-                error::bad_content_encoding);
-        md.content_encoding.coding =
-            content_coding::unknown;
-        return;
-    }
-
-    if(rv->size() > 1 || md.content_encoding.count > 1)
-    {
-        md.content_encoding.coding =
-            content_coding::unknown;
-        return;
-    }
-
-    if(grammar::ci_is_equal(
-        *rv->begin(), "deflate"))
-    {
-        md.content_encoding.coding =
-            content_coding::deflate;
-    }
-    else if(grammar::ci_is_equal(
-        *rv->begin(), "gzip"))
-    {
-        md.content_encoding.coding =
-            content_coding::gzip;
-    }
-    else if(grammar::ci_is_equal(
-        *rv->begin(), "br"))
+    if(! rv)
     {
-        md.content_encoding.coding =
-            content_coding::br;
+        flags = flag_bad;
     }
-    else
+    else if(rv->size() == 1)
     {
-        md.content_encoding.coding =
-            content_coding::unknown;
+        if(grammar::ci_is_equal(
+            *rv->begin(), "deflate"))
+            coding = content_coding::deflate;
+        else if(grammar::ci_is_equal(
+            *rv->begin(), "gzip"))
+            coding = content_coding::gzip;
+        else if(grammar::ci_is_equal(
+            *rv->begin(), "br"))
+            coding = content_coding::br;
+        else if(grammar::ci_is_equal(
+            *rv->begin(), "zstd"))
+            coding = content_coding::zstd;
     }
+    flags |= static_cast<unsigned char>(
+        static_cast<unsigned char>(coding) << 4);
+    if(flags & flag_bad)
+        ++nf.bad_content_encoding;
+    update_content_encoding(flags);
+    return flags;
 }
 
-void
+unsigned char
 header::
 on_insert_upgrade(
     core::string_view v)
 {
     ++md.upgrade.count;
-    if(md.upgrade.ec.failed())
-        return;
+    unsigned char flags = 0;
     if( version !=
         http_proto::version::http_1_1)
     {
-        md.upgrade.ec =
-            BOOST_HTTP_PROTO_ERR(
-                error::bad_upgrade);
-        md.upgrade.websocket = false;
-        return;
-    }
-    auto rv = grammar::parse(
-        v, upgrade_rule);
-    if(! rv)
-    {
-        md.upgrade.ec =
-            BOOST_HTTP_PROTO_ERR(
-                error::bad_upgrade);
-        md.upgrade.websocket = false;
-        return;
+        flags = flag_bad;
     }
-    if(! md.upgrade.websocket)
+    else
     {
-        for(auto t : *rv)
+        auto rv = grammar::parse(
+            v, upgrade_rule);
+        if(! rv)
+        {
+            flags = flag_bad;
+        }
+        else
         {
-            if( grammar::ci_is_equal(
-                    t.name, "websocket") &&
-                t.version.empty())
+            for(auto t : *rv)
             {
-                md.upgrade.websocket = true;
-                break;
+                if( grammar::ci_is_equal(
+                        t.name, "websocket") &&
+                    t.version.empty())
+                {
+                    flags = flag_websocket;
+                    break;
+                }
             }
         }
     }
+    if(flags & flag_bad)
+        ++nf.bad_upgrade;
+    if(flags & flag_websocket)
+        ++nf.websocket;
+    update_upgrade();
+    return flags;
 }
 
 //------------------------------------------------
 
+// These subtract the contribution of the
+// erased field, which is no longer in the
+// table, without parsing the others.
+
 void
 header::
-on_erase_connection()
+on_erase_connection(
+    unsigned char flags)
 {
     BOOST_ASSERT(
         md.connection.count > 0);
-    // reset and re-insert
-    auto n = md.connection.count - 1;
-    auto const p = cbuf + prefix;
-    auto const* e = &tab()[0];
-    md.connection = {};
-    while(n > 0)
-    {
-        if(e->id == field::connection)
-        {
-            on_insert_connection(
-                core::string_view(
-                    p + e->vp, e->vn));
-            --n;
-        }
-        --e;
-    }
+    --md.connection.count;
+    if(flags & flag_bad)
+        --nf.bad_connection;
+    if(flags & flag_close)
+        --nf.close;
+    if(flags & flag_keep_alive)
+        --nf.keep_alive;
+    if(flags & flag_upgrade)
+        --nf.upgrade;
+    update_connection();
 }
 
 void
 header::
-on_erase_content_length()
+on_erase_content_length(
+    unsigned char flags)
 {
     BOOST_ASSERT(
         md.content_length.count > 0);
     --md.content_length.count;
+    if(flags & flag_bad)
+        --nf.bad_content_length;
     if(md.content_length.count == 0)
     {
         // no Content-Length
@@ -763,28 +772,19 @@ on_erase_content_length()
         // removing a duplicate value
         return;
     }
-    // reset and re-insert
-    auto n = md.content_length.count;
-    auto const p = cbuf + prefix;
-    auto const* e = &tab()[0];
-    md.content_length = {};
-    while(n > 0)
+    if(nf.bad_content_length > 0)
     {
-        if(e->id == field::content_length)
-        {
-            on_insert_content_length(
-                core::string_view(
-                    p + e->vp, e->vn));
-            --n;
-        }
-        --e;
+        // still an invalid value
+        return;
     }
+    update_content_length();
     update_payload();
 }
 
 void
 header::
-on_erase_expect()
+on_erase_expect(
+    unsigned char)
 {
     BOOST_ASSERT(
         md.expect.count > 0);
@@ -797,102 +797,100 @@ on_erase_expect()
         md.expect = {};
         return;
     }
-    // VFALCO This should be uncommented
-    // if we want to allow multiple Expect
-    // fields with the value 100-continue
-    /*
-    if(! md.expect.ec.failed())
+    if(md.expect.count > 1)
         return;
-    */
-    // reset and re-insert
-    auto n = md.expect.count;
-    auto const p = cbuf + prefix;
-    auto const* e = &tab()[0];
-    md.expect = {};
-    while(n > 0)
-    {
-        if(e->id == field::expect)
-        {
-            on_insert_expect(
-                core::string_view(
-                    p + e->vp, e->vn));
-            --n;
-        }
-        --e;
-    }
+    auto const e = find_last(field::expect);
+    BOOST_ASSERT(e != nullptr);
+    update_expect(e->flags);
 }
 
 void
 header::
-on_erase_transfer_encoding()
+on_erase_transfer_encoding(
+    unsigned char flags)
 {
     BOOST_ASSERT(
         md.transfer_encoding.count > 0);
-    // reset and re-insert
-    auto n = md.transfer_encoding.count - 1;
-    auto const p = cbuf + prefix;
-    auto const* e = &tab()[0];
-    md.transfer_encoding = {};
-    while(n > 0)
+    --md.transfer_encoding.count;
+    if(flags & flag_bad)
+        --nf.bad_transfer_encoding;
+    if(flags & flag_chunked)
+        --nf.chunked;
+    if(md.transfer_encoding.count == 0)
     {
-        if(e->id == field::transfer_encoding)
+        // no Transfer-Encoding
+        md.transfer_encoding = {};
+        update_payload();
+        return;
+    }
+    bool last_chunked = false;
+    if(nf.chunked == 1)
+    {
+        if(md.transfer_encoding.is_chunked)
+        {
+            // the chunked field
+            // is still the last one
+            last_chunked = true;
+        }
+        else
         {
-            on_insert_transfer_encoding(
-                core::string_view(
-                    p + e->vp, e->vn));
-            --n;
+            auto const e = find_last(
+                field::transfer_encoding);
+            BOOST_ASSERT(e != nullptr);
+            last_chunked =
+                (e->flags & flag_chunked) != 0;
         }
-        --e;
     }
+    update_transfer_encoding(last_chunked);
 }
 
 void
 header::
-on_erase_content_encoding()
+on_erase_content_encoding(
+    unsigned char flags)
 {
     BOOST_ASSERT(
         md.content_encoding.count > 0);
     --md.content_encoding.count;
+    if(flags & flag_bad)
+        --nf.bad_content_encoding;
     if(md.content_encoding.count == 0)
     {
         // no Content-Encoding
         md.content_encoding = {};
         return;
     }
-    // re-insert everything
-    --md.content_encoding.count;
-    // TODO
-    // on_insert_content_encoding();
+    unsigned char last = 0;
+    if(md.content_encoding.count == 1)
+    {
+        auto const e = find_last(
+            field::content_encoding);
+        BOOST_ASSERT(e != nullptr);
+        last = e->flags;
+    }
+    update_content_encoding(last);
 }
 
 // called when Upgrade is erased
 void
 header::
-on_erase_upgrade()
+on_erase_upgrade(
+    unsigned char flags)
 {
     BOOST_ASSERT(
         md.upgrade.count > 0);
     --md.upgrade.count;
+    if(flags & flag_bad)
+        --nf.bad_upgrade;
+    if(flags & flag_websocket)
+        --nf.websocket;
     if(md.upgrade.count == 0)
     {
         // no Upgrade
         md.upgrade = {};
         return;
     }
-    // reset and re-insert
-    auto n = md.upgrade.count;
-    auto const p = cbuf + prefix;
-    auto const* e = &tab()[0];
-    md.upgrade = {};
-    while(n > 0)
-    {
-        if(e->id == field::upgrade)
-            on_insert_upgrade(
-                core::string_view(
-                    p + e->vp, e->vn));
-        --n;
-        --e;
-    }
+    update_upgrade();
 }
 
 //------------------------------------------------
@@ -909,10 +907,20 @@ on_erase_all(
     {
     case field::connection:
         md.connection = {};
+        nf.bad_connection = 0;
+        nf.close = 0;
+        nf.keep_alive = 0;
+        nf.upgrade = 0;
+        return;
+
+    case field::content_encoding:
+        md.content_encoding = {};
+        nf.bad_content_encoding = 0;
         return;
 
     case field::content_length:
         md.content_length = {};
+        nf.bad_content_length = 0;
         update_payload();
         return;
 
@@ -923,11 +931,15 @@ on_erase_all(
 
     case field::transfer_encoding:
         md.transfer_encoding = {};
+        nf.bad_transfer_encoding = 0;
+        nf.chunked = 0;
         update_payload();
         return;
 
     case field::upgrade:
         md.upgrade = {};
+        nf.bad_upgrade = 0;
+        nf.websocket = 0;
         return;
 
     default:
@@ -937,6 +949,169 @@ on_erase_all(
 
 //------------------------------------------------
 
+// These set the metadata from the counts
+// in nf, and from the flags of the only
+// or last field where that matters.
+
+void
+header::
+update_connection()
+{
+    auto& c = md.connection;
+    if(nf.bad_connection > 0)
+        c.ec = BOOST_HTTP_PROTO_ERR(
+            error::bad_connection);
+    else
+        c.ec = {};
+    c.close = nf.close > 0;
+    c.keep_alive = nf.keep_alive > 0;
+    c.upgrade = nf.upgrade > 0;
+}
+
+// flags of the only field
+void
+header::
+update_content_encoding(
+    unsigned char flags)
+{
+    auto& ce = md.content_encoding;
+    if(nf.bad_content_encoding > 0)
+    {
+        ce.ec = BOOST_HTTP_PROTO_ERR(
+            error::bad_content_encoding);
+        ce.coding = content_coding::unknown;
+        return;
+    }
+    ce.ec = {};
+    if(ce.count > 1)
+    {
+        ce.coding = content_coding::unknown;
+        return;
+    }
+    ce.coding = static_cast<
+        content_coding>(flags >> 4);
+}
+
+// Only needed to resolve multiple
+// different values, so this parses
+// the values which are left.
+void
+header::
+update_content_length()
+{
+    static
+    constexpr
+    grammar::unsigned_rule<
+        std::uint64_t> num_rule{};
+
+    auto& cl = md.content_length;
+    cl.ec = {};
+    cl.value = 0;
+    auto const p = cbuf + prefix;
+    bool first = true;
+    for(std::size_t i = 0; i < count; ++i)
+    {
+        auto const& e = tab()[i];
+        if(e.id != field::content_length)
+            continue;
+        auto rv = grammar::parse(
+            core::string_view(
+                p + e.vp, e.vn), num_rule);
+        BOOST_ASSERT(rv.has_value());
+        if(first)
+        {
+            cl.value = *rv;
+            first = false;
+        }
+        else if(*rv != cl.value)
+        {
+            cl.ec = BOOST_HTTP_PROTO_ERR(
+                error::multiple_content_length);
+            cl.value = 0;
+            return;
+        }
+    }
+}
+
+// flags of the only field
+void
+header::
+update_expect(
+    unsigned char flags)
+{
+    // VFALCO Should we allow duplicate
+    // Expect fields that have 100-continue?
+    if( md.expect.count > 1 ||
+        ! (flags & flag_100_continue))
+    {
+        md.expect.ec =
+            BOOST_HTTP_PROTO_ERR(
+                error::bad_expect);
+        md.expect.is_100_continue = false;
+        return;
+    }
+    md.expect.ec = {};
+    md.expect.is_100_continue = true;
+}
+
+// whether the last field ends in chunked
+void
+header::
+update_transfer_encoding(
+    bool last_chunked)
+{
+    auto& te = md.transfer_encoding;
+    if( nf.bad_transfer_encoding > 0 ||
+        nf.chunked > 1 ||
+        (nf.chunked == 1 && ! last_chunked))
+    {
+        te.ec = BOOST_HTTP_PROTO_ERR(
+            error::bad_transfer_encoding);
+        te.is_chunked = false;
+    }
+    else
+    {
+        te.ec = {};
+        te.is_chunked = nf.chunked == 1;
+    }
+    update_payload();
+}
+
+void
+header::
+update_upgrade()
+{
+    auto& u = md.upgrade;
+    if(nf.bad_upgrade > 0)
+    {
+        u.ec = BOOST_HTTP_PROTO_ERR(
+            error::bad_upgrade);
+        u.websocket = false;
+        return;
+    }
+    u.ec = {};
+    u.websocket = nf.websocket > 0;
+}
+
+// return the last field with id, or null
+auto
+header::
+find_last(
+    field id) const noexcept ->
+        entry const*
+{
+    auto i = count;
+    while(i > 0)
+    {
+        auto const& e = tab()[--i];
+        if(e.id == id)
+            return &e;
+    }
+    return nullptr;
+}
+
+//------------------------------------------------
+
 /*  References:
 
     3.3.  Message Body
@@ -1214,6 +1389,7 @@ parse_field(
     header& h,
     header_limits const& lim,
     std::size_t new_size,
+    field_registry const* reg,
     system::error_code& ec) noexcept
 {
     if( new_size > lim.max_field)
@@ -1255,7 +1431,12 @@ parse_field(
     }
     auto id = string_to_field(rv->name)
         .value_or(header::unknown_field);
+    if( id == header::unknown_field &&
+        reg != nullptr)
+        id = reg->string_to_field(rv->name);
     h.size = static_cast<header::offset_type>(it - h.cbuf);
+    auto const flags =
+        h.on_insert(id, rv->value);
 
     // add field table entry
     if(h.buf != nullptr)
@@ -1273,9 +1454,9 @@ parse_field(
         e.vn = static_cast<header::offset_type>(
             rv->value.size());
         e.id = id;
+        e.flags = flags;
     }
     ++h.count;
-    h.on_insert(id, rv->value);
     ec = {};
 }
 
@@ -1284,7 +1465,8 @@ header::
 parse(
     std::size_t new_size,
     header_limits const& lim,
-    system::error_code& ec) noexcept
+    system::error_code& ec,
+    field_registry const* reg) noexcept
 {
     if( new_size > lim.max_size)
         new_size = lim.max_size;
@@ -1308,7 +1490,7 @@ parse(
     for(;;)
     {
         parse_field(
-            *this, lim, new_size, ec);
+            *this, lim, new_size, reg, ec);
         if(ec.failed())
         {
             if( ec == grammar::error::need_more &&
@@ -0,0 +1,188 @@
+//
+// Copyright (c) 2025 Mohammad Nejati
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#include <boost/http_proto/detail/header.hpp>
+#include <boost/http_proto/detail/name_index.hpp>
+
+#include <boost/assert.hpp>
+#include <boost/url/grammar/ci_string.hpp>
+
+#include <cstring>
+
+namespace boost {
+namespace http_proto {
+namespace detail {
+
+namespace {
+
+core::string_view
+name_of(
+    header const& h,
+    std::size_t i) noexcept
+{
+    auto const& e = h.tab()[i];
+    return core::string_view(
+        h.cbuf + h.prefix + e.np, e.nn);
+}
+
+} // (anon)
+
+// keep the load factor at or below one
+// half so probe sequences stay short
+std::size_t
+name_index::
+slots_needed(
+    std::size_t n) noexcept
+{
+    std::size_t size = 2 * threshold;
+    while(size < 2 * n)
+        size *= 2;
+    return size;
+}
+
+std::size_t
+name_index::
+find(
+    header const& h,
+    core::string_view name) const noexcept
+{
+    BOOST_ASSERT(size != 0);
+    auto const v = slots[probe(h, name)];
+    if(v == 0)
+        return h.count;
+    return v - 1;
+}
+
+void
+name_index::
+rebuild(
+    header const& h) noexcept
+{
+    BOOST_ASSERT(size >= slots_needed(h.count));
+    std::memset(slots, 0, size * sizeof(slot_type));
+    for(std::size_t i = 0; i < h.count; ++i)
+    {
+        auto& v = slots[probe(h, name_of(h, i))];
+        if(v == 0)
+            v = static_cast<slot_type>(i + 1);
+    }
+}
+
+void
+name_index::
+on_insert(
+    header const& h,
+    std::size_t i) noexcept
+{
+    BOOST_ASSERT(i < h.count);
+    BOOST_ASSERT(size >= slots_needed(h.count));
+    // fields from i on moved up by one
+    if(i + 1 < h.count)
+    {
+        for(std::size_t s = 0; s < size; ++s)
+        {
+            if(slots[s] > i)
+                ++slots[s];
+        }
+    }
+    auto& v = slots[probe(h, name_of(h, i))];
+    if(v == 0 || v > i + 1)
+        v = static_cast<slot_type>(i + 1);
+}
+
+void
+name_index::
+on_erase(
+    header const& h,
+    std::size_t i) noexcept
+{
+    BOOST_ASSERT(i < h.count);
+    auto const name = name_of(h, i);
+    auto const s = probe(h, name);
+    BOOST_ASSERT(slots[s] != 0);
+    if(slots[s] == i + 1)
+    {
+        // the first field with this name
+        // is going, point at the next one
+        std::size_t j = i + 1;
+        while(j < h.count && ! grammar::ci_is_equal(
+            name_of(h, j), name))
+            ++j;
+        if(j < h.count)
+            slots[s] = static_cast<slot_type>(j + 1);
+        else
+            erase_slot(h, s);
+    }
+    // fields after i move down by one
+    if(i + 1 < h.count)
+    {
+        for(std::size_t k = 0; k < size; ++k)
+        {
+            if(slots[k] > i + 1)
+                --slots[k];
+        }
+    }
+}
+
+// return the slot holding name, or the
+// empty slot where it would be inserted
+std::size_t
+name_index::
+probe(
+    header const& h,
+    core::string_view name) const noexcept
+{
+    auto const mask = size - 1;
+    auto s = grammar::ci_digest(name) & mask;
+    while(slots[s] != 0)
+    {
+        if(grammar::ci_is_equal(
+            name_of(h, slots[s] - 1), name))
+            break;
+        s = (s + 1) & mask;
+    }
+    return s;
+}
+
+// empty slot s, moving later slots of the
+// same probe sequence back so no lookup
+// stops early at the hole
+void
+name_index::
+erase_slot(
+    header const& h,
+    std::size_t s) noexcept
+{
+    auto const mask = size - 1;
+    for(;;)
+    {
+        slots[s] = 0;
+        auto t = s;
+        for(;;)
+        {
+            t = (t + 1) & mask;
+            if(slots[t] == 0)
+                return;
+            auto const home = grammar::ci_digest(
+                name_of(h, slots[t] - 1)) & mask;
+            // stays if home is cyclically in (s, t]
+            bool const stays = s <= t
+                ? (s < home && home <= t)
+                : (s < home || home <= t);
+            if(! stays)
+                break;
+        }
+        slots[s] = slots[t];
+        s = t;
+    }
+}
+
+} // detail
+} // http_proto
+} // boost
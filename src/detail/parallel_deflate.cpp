@@ -0,0 +1,553 @@
+//
+// Copyright (c) 2025 Mohammad Nejati
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#include "src/detail/parallel_deflate.hpp"
+
+#include <boost/rts/zlib/compression_method.hpp>
+#include <boost/rts/zlib/compression_strategy.hpp>
+#include <boost/rts/zlib/error.hpp>
+#include <boost/rts/zlib/flush.hpp>
+#include <boost/system/errc.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <future>
+#include <limits>
+#include <new>
+#include <vector>
+
+namespace boost {
+namespace http_proto {
+namespace detail {
+
+namespace {
+
+constexpr std::uint32_t crc32_poly = 0xedb88320;
+constexpr std::uint32_t adler32_base = 65521;
+
+// a * b modulo the CRC-32 polynomial
+std::uint32_t
+multmodp(
+    std::uint32_t a,
+    std::uint32_t b) noexcept
+{
+    std::uint32_t m = std::uint32_t(1) << 31;
+    std::uint32_t p = 0;
+    for(;;)
+    {
+        if(a & m)
+        {
+            p ^= b;
+            if((a & (m - 1)) == 0)
+                break;
+        }
+        m >>= 1;
+        b = (b & 1) ? (b >> 1) ^ crc32_poly : b >> 1;
+    }
+    return p;
+}
+
+struct crc32_tables
+{
+    std::uint32_t crc[256];
+    std::uint32_t x2n[32]; // x^2^n modulo the polynomial
+
+    crc32_tables() noexcept
+    {
+        for(std::uint32_t i = 0; i < 256; ++i)
+        {
+            std::uint32_t c = i;
+            for(int k = 0; k < 8; ++k)
+                c = (c & 1) ? (c >> 1) ^ crc32_poly : c >> 1;
+            crc[i] = c;
+        }
+        x2n[0] = std::uint32_t(1) << 30; // x^1
+        for(int n = 1; n < 32; ++n)
+            x2n[n] = multmodp(x2n[n - 1], x2n[n - 1]);
+    }
+};
+
+crc32_tables const&
+get_crc32_tables() noexcept
+{
+    static crc32_tables const tab;
+    return tab;
+}
+
+std::uint32_t
+crc32(
+    std::uint32_t crc,
+    void const* data,
+    std::size_t n) noexcept
+{
+    auto const& tab = get_crc32_tables();
+    auto p = static_cast<unsigned char const*>(data);
+    crc = ~crc;
+    while(n--)
+        crc = tab.crc[(crc ^ *p++) & 0xff] ^ (crc >> 8);
+    return ~crc;
+}
+
+// CRC-32 of the concatenation of two sequences,
+// given their CRCs and the length of the second.
+std::uint32_t
+crc32_combine(
+    std::uint32_t crc1,
+    std::uint32_t crc2,
+    std::uint64_t len2) noexcept
+{
+    auto const& tab = get_crc32_tables();
+    std::uint32_t p = std::uint32_t(1) << 31; // x^0
+    unsigned k = 3; // bytes to bits
+    while(len2 != 0)
+    {
+        if(len2 & 1)
+            p = multmodp(tab.x2n[k & 31], p);
+        len2 >>= 1;
+        ++k;
+    }
+    return multmodp(p, crc1) ^ crc2;
+}
+
+std::uint32_t
+adler32(
+    std::uint32_t adler,
+    void const* data,
+    std::size_t n) noexcept
+{
+    std::uint32_t a = adler & 0xffff;
+    std::uint32_t b = adler >> 16;
+    auto p = static_cast<unsigned char const*>(data);
+    while(n != 0)
+    {
+        // largest run which cannot overflow b
+        auto k = (std::min)(n, std::size_t(5552));
+        n -= k;
+        while(k--)
+        {
+            a += *p++;
+            b += a;
+        }
+        a %= adler32_base;
+        b %= adler32_base;
+    }
+    return a | (b << 16);
+}
+
+std::uint32_t
+adler32_combine(
+    std::uint32_t adler1,
+    std::uint32_t adler2,
+    std::uint64_t len2) noexcept
+{
+    auto const rem =
+        static_cast<std::uint32_t>(len2 % adler32_base);
+    std::uint32_t sum1 = adler1 & 0xffff;
+    std::uint32_t sum2 = static_cast<std::uint32_t>(
+        (std::uint64_t(rem) * sum1) % adler32_base);
+    sum1 += (adler2 & 0xffff) + adler32_base - 1;
+    sum2 += (adler1 >> 16) + (adler2 >> 16) + adler32_base - rem;
+    if(sum1 >= adler32_base)
+        sum1 -= adler32_base;
+    if(sum1 >= adler32_base)
+        sum1 -= adler32_base;
+    if(sum2 >= (adler32_base << 1))
+        sum2 -= (adler32_base << 1);
+    if(sum2 >= adler32_base)
+        sum2 -= adler32_base;
+    return sum1 | (sum2 << 16);
+}
+
+void*
+zalloc(
+    void* /* opaque */,
+    unsigned items,
+    unsigned size) noexcept
+{
+    return std::malloc(std::size_t(items) * size);
+}
+
+void
+zfree(
+    void* /* opaque */,
+    void* addr) noexcept
+{
+    std::free(addr);
+}
+
+system::error_code
+out_of_memory() noexcept
+{
+    return system::errc::make_error_code(
+        system::errc::not_enough_memory);
+}
+
+} // namespace
+
+//------------------------------------------------
+
+struct parallel_deflate::block
+{
+    std::vector<buffers::const_buffer> in;
+    std::vector<unsigned char> out;
+    std::size_t in_size = 0;
+    std::size_t out_pos = 0;
+    std::uint32_t check = 0;
+    bool last = false;
+    bool combined = false;
+    system::error_code ec;
+    std::promise<void> promise;
+    std::future<void> done = promise.get_future();
+
+    // called on a pool thread
+    void
+    run(
+        rts::zlib::deflate_service& svc,
+        int comp_level,
+        int window_bits,
+        int mem_level,
+        bool gzip) noexcept
+    {
+        try
+        {
+            ec = compress(
+                svc, comp_level, window_bits, mem_level, gzip);
+        }
+        catch(std::bad_alloc const&)
+        {
+            ec = out_of_memory();
+        }
+        promise.set_value();
+    }
+
+    system::error_code
+    compress(
+        rts::zlib::deflate_service& svc,
+        int comp_level,
+        int window_bits,
+        int mem_level,
+        bool gzip)
+    {
+        rts::zlib::stream zs{};
+        zs.zalloc = &zalloc;
+        zs.zfree  = &zfree;
+
+        // raw deflate, the framing is added by the filter
+        system::error_code ec = static_cast<rts::zlib::error>(svc.init2(
+            zs,
+            comp_level,
+            rts::zlib::deflated,
+            -window_bits,
+            mem_level,
+            rts::zlib::default_strategy));
+        if(ec != rts::zlib::error::ok)
+            return ec;
+
+        struct end_guard
+        {
+            rts::zlib::deflate_service& svc;
+            rts::zlib::stream& zs;
+            ~end_guard() { svc.deflate_end(zs); }
+        } guard{ svc, zs };
+
+        check = gzip ? 0 : 1;
+        out.resize(in_size + in_size / 8 + 64);
+        std::size_t pos = 0;
+
+        // avail_in and avail_out are 32 bits wide
+        std::size_t const max_avail =
+            (std::numeric_limits<unsigned>::max)();
+
+        for(std::size_t i = 0; i <= in.size(); ++i)
+        {
+            int flush = rts::zlib::no_flush;
+            unsigned char const* p = nullptr;
+            std::size_t n = 0;
+            if(i < in.size())
+            {
+                auto const& cb = in[i];
+                check = gzip
+                    ? crc32(check, cb.data(), cb.size())
+                    : adler32(check, cb.data(), cb.size());
+                p = static_cast<unsigned char const*>(cb.data());
+                n = cb.size();
+            }
+            else
+            {
+                // Non-final blocks end on a byte boundary
+                // so the next block can be appended.
+                flush = last
+                    ? rts::zlib::finish
+                    : rts::zlib::sync_flush;
+            }
+
+            do
+            {
+                auto const chunk = (std::min)(n, max_avail);
+                zs.next_in  = const_cast<unsigned char*>(p);
+                zs.avail_in = static_cast<unsigned>(chunk);
+                p += chunk;
+                n -= chunk;
+
+                // the flush applies to the last chunk only
+                auto const f = n == 0
+                    ? flush
+                    : rts::zlib::no_flush;
+
+                for(;;)
+                {
+                    if(pos == out.size())
+                        out.resize(out.size() * 2);
+                    auto const avail = (std::min)(
+                        out.size() - pos, max_avail);
+                    zs.next_out  = out.data() + pos;
+                    zs.avail_out = static_cast<unsigned>(avail);
+
+                    auto rs = static_cast<rts::zlib::error>(
+                        svc.deflate(zs, f));
+                    pos += avail - zs.avail_out;
+
+                    if(rs < rts::zlib::error::ok &&
+                        rs != rts::zlib::error::buf_err)
+                        return rs;
+                    if(rs == rts::zlib::error::stream_end)
+                        break;
+                    if(zs.avail_in == 0 && zs.avail_out != 0)
+                        break;
+                }
+            }
+            while(n != 0);
+        }
+        out.resize(pos);
+        return {};
+    }
+};
+
+//------------------------------------------------
+
+parallel_deflate::
+parallel_deflate(
+    rts::zlib::deflate_service& svc,
+    thread_pool& pool,
+    int comp_level,
+    int window_bits,
+    int mem_level,
+    bool gzip,
+    std::size_t block_size)
+    : svc_(svc)
+    , pool_(pool)
+    , comp_level_(comp_level)
+    , window_bits_(window_bits)
+    , mem_level_(mem_level)
+    , gzip_(gzip)
+    , block_size_(block_size)
+    , max_blocks_((std::max)(
+        pool.size() * 2, std::size_t(2)))
+    , pending_(new block)
+    , check_(gzip ? 0 : 1)
+{
+    // the level reported in the header, as zlib does
+    int const level = comp_level < 0 ? 6 : comp_level;
+    if(gzip_)
+    {
+        // RFC 1952, no name, no mtime, unknown OS
+        unsigned char const h[10] = {
+            0x1f, 0x8b, 8, 0, 0, 0, 0, 0,
+            static_cast<unsigned char>(
+                level == 9 ? 2 :
+                level < 2 ? 4 : 0),
+            0xff };
+        std::memcpy(head_, h, sizeof(h));
+        head_size_ = 10;
+    }
+    else
+    {
+        // RFC 1950
+        unsigned const cmf =
+            ((window_bits - 8) << 4) | 8;
+        unsigned flg =
+            level < 2 ? 0 :
+            level < 6 ? 1 :
+            level == 6 ? 2 : 3;
+        flg <<= 6;
+        flg += (31 - ((cmf << 8) + flg) % 31) % 31;
+        head_[0] = static_cast<unsigned char>(cmf);
+        head_[1] = static_cast<unsigned char>(flg);
+        head_size_ = 2;
+    }
+}
+
+parallel_deflate::
+~parallel_deflate()
+{
+    // jobs refer to the input and to the blocks
+    for(auto& b : blocks_)
+        b->done.wait();
+}
+
+auto
+parallel_deflate::
+do_process(
+    buffers::mutable_buffer out,
+    buffers::const_buffer in,
+    bool more) noexcept ->
+        results
+{
+    results rv;
+
+    // header
+    auto n = put(out,
+        head_ + head_pos_, head_size_ - head_pos_);
+    head_pos_ += static_cast<std::uint8_t>(n);
+    rv.out_bytes += n;
+
+    // compressed blocks, in order
+    while(out.size() != 0 && !blocks_.empty())
+    {
+        // never wait for a worker here, the
+        // caller retries when nothing is done
+        auto& b = *blocks_.front();
+        if(b.done.wait_for(std::chrono::seconds(0)) !=
+            std::future_status::ready)
+            break;
+
+        if(b.ec.failed())
+        {
+            rv.ec = b.ec;
+            return rv;
+        }
+
+        if(!b.combined)
+        {
+            check_ = gzip_
+                ? crc32_combine(check_, b.check, b.in_size)
+                : adler32_combine(check_, b.check, b.in_size);
+            total_in_ += b.in_size;
+            b.combined = true;
+        }
+
+        n = put(out,
+            b.out.data() + b.out_pos, b.out.size() - b.out_pos);
+        b.out_pos += n;
+        rv.out_bytes += n;
+
+        if(b.out_pos != b.out.size())
+            break;
+        blocks_.pop_front();
+    }
+
+    // input
+    if(!submitted_last_ && blocks_.size() < max_blocks_)
+    {
+        n = (std::min)(
+            in.size(), block_size_ - pending_->in_size);
+        bool const last = !more && n == in.size();
+        try
+        {
+            if(n != 0)
+            {
+                pending_->in.emplace_back(in.data(), n);
+                pending_->in_size += n;
+            }
+            if(pending_->in_size == block_size_ || last)
+                submit(last);
+        }
+        catch(std::bad_alloc const&)
+        {
+            rv.ec = out_of_memory();
+            return rv;
+        }
+        rv.in_bytes = n;
+    }
+
+    // trailer
+    if(submitted_last_ && blocks_.empty())
+    {
+        if(tail_size_ == 0)
+        {
+            if(gzip_)
+            {
+                auto const size =
+                    static_cast<std::uint32_t>(total_in_);
+                for(int i = 0; i < 4; ++i)
+                {
+                    tail_[i]     = static_cast<unsigned char>(check_ >> (8 * i));
+                    tail_[i + 4] = static_cast<unsigned char>(size >> (8 * i));
+                }
+                tail_size_ = 8;
+            }
+            else
+            {
+                for(int i = 0; i < 4; ++i)
+                    tail_[i] = static_cast<unsigned char>(check_ >> (24 - 8 * i));
+                tail_size_ = 4;
+            }
+        }
+        n = put(out,
+            tail_ + tail_pos_, tail_size_ - tail_pos_);
+        tail_pos_ += static_cast<std::uint8_t>(n);
+        rv.out_bytes += n;
+        rv.finished = (tail_pos_ == tail_size_);
+    }
+
+    return rv;
+}
+
+void
+parallel_deflate::
+submit(bool last)
+{
+    std::unique_ptr<block> next(new block);
+    pending_->last = last;
+    blocks_.push_back(nullptr);
+    try
+    {
+        auto* p = pending_.get();
+        auto& svc = svc_;
+        auto const comp_level = comp_level_;
+        auto const window_bits = window_bits_;
+        auto const mem_level = mem_level_;
+        auto const gzip = gzip_;
+        pool_.post([=, &svc]
+            {
+                p->run(svc, comp_level, window_bits, mem_level, gzip);
+            });
+    }
+    catch(...)
+    {
+        blocks_.pop_back();
+        throw;
+    }
+    blocks_.back() = std::move(pending_);
+    pending_ = std::move(next);
+    submitted_last_ = last;
+}
+
+std::size_t
+parallel_deflate::
+put(
+    buffers::mutable_buffer& out,
+    void const* data,
+    std::size_t n) noexcept
+{
+    n = (std::min)(n, out.size());
+    if(n != 0)
+    {
+        std::memcpy(out.data(), data, n);
+        out = { static_cast<unsigned char*>(out.data()) + n,
+            out.size() - n };
+    }
+    return n;
+}
+
+} // detail
+} // http_proto
+} // boost
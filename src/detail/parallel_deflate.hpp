@@ -0,0 +1,100 @@
+//
+// Copyright (c) 2025 Mohammad Nejati
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#ifndef BOOST_HTTP_PROTO_DETAIL_PARALLEL_DEFLATE_HPP
+#define BOOST_HTTP_PROTO_DETAIL_PARALLEL_DEFLATE_HPP
+
+#include "src/detail/filter.hpp"
+#include "src/detail/thread_pool.hpp"
+
+#include <boost/rts/zlib/deflate.hpp>
+
+#include <cstdint>
+#include <deque>
+#include <memory>
+
+namespace boost {
+namespace http_proto {
+namespace detail {
+
+/** A deflate or gzip encoder which compresses
+    independent blocks on a thread pool.
+
+    The input is cut into blocks which are
+    compressed as raw deflate streams ending with
+    a sync flush, except for the last one, so
+    that their concatenation forms a single
+    stream. The checksums of the blocks are
+    combined in order for the trailer.
+
+    The input buffers must remain valid until
+    the output referring to them is produced,
+    which holds for bodies provided as a buffer
+    sequence.
+*/
+class parallel_deflate
+    : public filter
+{
+public:
+    parallel_deflate(
+        rts::zlib::deflate_service& svc,
+        thread_pool& pool,
+        int comp_level,
+        int window_bits,
+        int mem_level,
+        bool gzip,
+        std::size_t block_size);
+
+    ~parallel_deflate();
+
+private:
+    struct block;
+
+    virtual
+    results
+    do_process(
+        buffers::mutable_buffer out,
+        buffers::const_buffer in,
+        bool more) noexcept override;
+
+    void
+    submit(bool last);
+
+    std::size_t
+    put(
+        buffers::mutable_buffer& out,
+        void const* data,
+        std::size_t n) noexcept;
+
+    rts::zlib::deflate_service& svc_;
+    thread_pool& pool_;
+    int comp_level_;
+    int window_bits_;
+    int mem_level_;
+    bool gzip_;
+    bool submitted_last_ = false;
+    std::size_t block_size_;
+    std::size_t max_blocks_;
+    std::deque<std::unique_ptr<block>> blocks_;
+    std::unique_ptr<block> pending_;
+    std::uint64_t total_in_ = 0;
+    std::uint32_t check_;
+    unsigned char head_[10];
+    unsigned char tail_[8];
+    std::uint8_t head_size_;
+    std::uint8_t head_pos_ = 0;
+    std::uint8_t tail_size_ = 0;
+    std::uint8_t tail_pos_ = 0;
+};
+
+} // detail
+} // http_proto
+} // boost
+
+#endif
@@ -0,0 +1,97 @@
+//
+// Copyright (c) 2025 Mohammad Nejati
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#ifndef BOOST_HTTP_PROTO_DETAIL_RESOURCE_HPP
+#define BOOST_HTTP_PROTO_DETAIL_RESOURCE_HPP
+
+#include <boost/http_proto/detail/workspace.hpp>
+#include <boost/http_proto/memory_resource.hpp>
+
+#include <cstddef>
+#include <new>
+
+namespace boost {
+namespace http_proto {
+namespace detail {
+
+// Allocate from the resource, or with
+// operator new when there is none.
+
+inline
+void*
+allocate(
+    memory_resource* mr,
+    std::size_t n)
+{
+    if(mr)
+        return mr->allocate(n);
+    return ::operator new(n);
+}
+
+inline
+void
+deallocate(
+    memory_resource* mr,
+    void* p,
+    std::size_t n) noexcept
+{
+    if(mr)
+        mr->deallocate(p, n);
+    else
+        ::operator delete(p);
+}
+
+// Allocation functions for C libraries which
+// free without a size. The size is kept in
+// front of each block; `opaque` is the resource.
+
+constexpr std::size_t c_header_size =
+    workspace::aligned_size(sizeof(std::size_t));
+
+inline
+void*
+c_alloc(
+    void* opaque,
+    std::size_t n) noexcept
+{
+    try
+    {
+        auto const p = static_cast<unsigned char*>(
+            static_cast<memory_resource*>(opaque)
+                ->allocate(c_header_size + n));
+        *reinterpret_cast<std::size_t*>(p) =
+            c_header_size + n;
+        return p + c_header_size;
+    }
+    catch(...)
+    {
+        return nullptr;
+    }
+}
+
+inline
+void
+c_free(
+    void* opaque,
+    void* addr) noexcept
+{
+    if(! addr)
+        return;
+    auto const p = static_cast<
+        unsigned char*>(addr) - c_header_size;
+    static_cast<memory_resource*>(opaque)
+        ->deallocate(p,
+            *reinterpret_cast<std::size_t*>(p));
+}
+
+} // detail
+} // http_proto
+} // boost
+
+#endif
@@ -0,0 +1,89 @@
+//
+// Copyright (c) 2025 Mohammad Nejati
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#include "src/detail/thread_pool.hpp"
+
+namespace boost {
+namespace http_proto {
+namespace detail {
+
+thread_pool::
+thread_pool(std::size_t n)
+{
+    threads_.reserve(n);
+    try
+    {
+        while(n--)
+            threads_.emplace_back([this]{ run(); });
+    }
+    catch(...)
+    {
+        join();
+        throw;
+    }
+}
+
+thread_pool::
+~thread_pool()
+{
+    join();
+}
+
+void
+thread_pool::
+join() noexcept
+{
+    {
+        std::lock_guard<std::mutex> lock(m_);
+        stop_ = true;
+    }
+    cv_.notify_all();
+    for(auto& t : threads_)
+    {
+        if(t.joinable())
+            t.join();
+    }
+}
+
+void
+thread_pool::
+post(std::function<void()> f)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_);
+        jobs_.push_back(std::move(f));
+    }
+    cv_.notify_one();
+}
+
+void
+thread_pool::
+run()
+{
+    for(;;)
+    {
+        std::function<void()> f;
+        {
+            std::unique_lock<std::mutex> lock(m_);
+            cv_.wait(lock, [this]
+                {
+                    return stop_ || !jobs_.empty();
+                });
+            if(jobs_.empty())
+                return; // stopped
+            f = std::move(jobs_.front());
+            jobs_.pop_front();
+        }
+        f();
+    }
+}
+
+} // detail
+} // http_proto
+} // boost
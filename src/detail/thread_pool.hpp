@@ -0,0 +1,72 @@
+//
+// Copyright (c) 2025 Mohammad Nejati
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#ifndef BOOST_HTTP_PROTO_DETAIL_THREAD_POOL_HPP
+#define BOOST_HTTP_PROTO_DETAIL_THREAD_POOL_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace boost {
+namespace http_proto {
+namespace detail {
+
+/** A fixed-size pool of worker threads
+
+    Jobs are run in submission order by the
+    first available thread. The destructor
+    completes all pending jobs before joining
+    the threads.
+*/
+class thread_pool
+{
+public:
+    explicit
+    thread_pool(std::size_t n);
+
+    ~thread_pool();
+
+    thread_pool(
+        thread_pool const&) = delete;
+    thread_pool& operator=(
+        thread_pool const&) = delete;
+
+    std::size_t
+    size() const noexcept
+    {
+        return threads_.size();
+    }
+
+    void
+    post(std::function<void()> f);
+
+private:
+    void
+    run();
+
+    void
+    join() noexcept;
+
+    std::mutex m_;
+    std::condition_variable cv_;
+    std::deque<std::function<void()>> jobs_;
+    std::vector<std::thread> threads_;
+    bool stop_ = false;
+};
+
+} // detail
+} // http_proto
+} // boost
+
+#endif
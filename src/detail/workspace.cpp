@@ -26,7 +26,8 @@ workspace::
 ~workspace()
 {
     clear();
-    delete[] begin_;
+    if(! external_)
+        delete[] begin_;
 }
 
 workspace::
@@ -40,6 +41,19 @@ workspace(
 {
 }
 
+workspace::
+workspace(
+    void* p,
+    std::size_t n) noexcept
+    : begin_(static_cast<unsigned char*>(p))
+    , front_(begin_)
+    , head_(begin_ + n)
+    , back_(head_)
+    , end_(head_)
+    , external_(true)
+{
+}
+
 workspace::
 workspace(
     workspace&& other) noexcept
@@ -48,6 +62,7 @@ workspace(
     , head_(boost::exchange(other.head_, nullptr))
     , back_(boost::exchange(other.back_, nullptr))
     , end_(boost::exchange(other.end_, nullptr))
+    , external_(boost::exchange(other.external_, false))
 {
 }
 
@@ -58,13 +73,15 @@ operator=(
 {
     if(this != &other)
     {
-        delete[] begin_;
+        if(! external_)
+            delete[] begin_;
 
         begin_ = boost::exchange(other.begin_, nullptr);
         front_ = boost::exchange(other.front_, nullptr);
         head_  = boost::exchange(other.head_, nullptr);
         back_  = boost::exchange(other.back_, nullptr);
         end_   = boost::exchange(other.end_, nullptr);
+        external_ = boost::exchange(other.external_, false);
     }
     return *this;
 }
@@ -0,0 +1,77 @@
+//
+// Copyright (c) 2025 Mohammad Nejati
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#ifndef BOOST_HTTP_PROTO_DETAIL_ZSTD_FILTER_BASE_HPP
+#define BOOST_HTTP_PROTO_DETAIL_ZSTD_FILTER_BASE_HPP
+
+#include <boost/http_proto/detail/workspace.hpp>
+#include <boost/http_proto/zstd/stream.hpp>
+
+#include "src/detail/filter.hpp"
+
+#include <cstdint>
+
+namespace boost {
+namespace http_proto {
+namespace detail {
+
+/** Base class for zstd filters
+*/
+class zstd_filter_base : public filter
+{
+    // zstd contexts must be 8-byte aligned
+    static constexpr std::size_t align = 8;
+
+public:
+    /** Return the workspace space needed for a
+        zstd context of n bytes.
+    */
+    static
+    constexpr
+    std::size_t
+    space_needed(std::size_t n) noexcept
+    {
+        return n + align - 1;
+    }
+
+protected:
+    static
+    void*
+    reserve(
+        workspace& ws,
+        std::size_t n)
+    {
+        auto const ip = reinterpret_cast<std::uintptr_t>(
+            ws.reserve_front(space_needed(n)));
+        return reinterpret_cast<void*>(
+            (ip + align - 1) & ~(align - 1));
+    }
+
+    static
+    zstd::in_buffer
+    make_in_buffer(
+        buffers::const_buffer b) noexcept
+    {
+        return { b.data(), b.size(), 0 };
+    }
+
+    static
+    zstd::out_buffer
+    make_out_buffer(
+        buffers::mutable_buffer b) noexcept
+    {
+        return { b.data(), b.size(), 0 };
+    }
+};
+
+} // detail
+} // http_proto
+} // boost
+
+#endif
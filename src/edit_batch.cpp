@@ -0,0 +1,127 @@
+//
+// Copyright (c) 2025 Mohammad Nejati
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#include <boost/http_proto/edit_batch.hpp>
+#include <boost/http_proto/detail/except.hpp>
+
+namespace boost {
+namespace http_proto {
+
+edit_batch&
+edit_batch::
+append(
+    field id,
+    core::string_view value)
+{
+    return push(
+        op_kind::append, id, to_string(id), value);
+}
+
+edit_batch&
+edit_batch::
+append(
+    core::string_view name,
+    core::string_view value)
+{
+    return push(
+        op_kind::append,
+        string_to_field(name).value_or(
+            detail::header::unknown_field),
+        name,
+        value);
+}
+
+edit_batch&
+edit_batch::
+set(
+    field id,
+    core::string_view value)
+{
+    return push(
+        op_kind::set, id, to_string(id), value);
+}
+
+edit_batch&
+edit_batch::
+set(
+    core::string_view name,
+    core::string_view value)
+{
+    return push(
+        op_kind::set,
+        string_to_field(name).value_or(
+            detail::header::unknown_field),
+        name,
+        value);
+}
+
+edit_batch&
+edit_batch::
+erase(
+    field id)
+{
+    return push(
+        op_kind::erase, id, to_string(id), {});
+}
+
+edit_batch&
+edit_batch::
+erase(
+    core::string_view name)
+{
+    return push(
+        op_kind::erase,
+        string_to_field(name).value_or(
+            detail::header::unknown_field),
+        name,
+        {});
+}
+
+void
+edit_batch::
+commit()
+{
+    system::error_code ec;
+    commit(ec);
+    if(ec.failed())
+        detail::throw_system_error(ec);
+}
+
+void
+edit_batch::
+commit(
+    system::error_code& ec)
+{
+    f_.commit_batch(*this, ec);
+    if(! ec.failed())
+        ops_.clear();
+}
+
+//------------------------------------------------
+
+edit_batch&
+edit_batch::
+push(
+    op_kind kind,
+    field id,
+    core::string_view name,
+    core::string_view value)
+{
+    op o;
+    o.kind = kind;
+    o.has_obs_fold = false;
+    o.id = id;
+    o.name = name;
+    o.value = value;
+    ops_.push_back(o);
+    return *this;
+}
+
+} // http_proto
+} // boost
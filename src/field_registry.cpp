@@ -0,0 +1,105 @@
+//
+// Copyright (c) 2025 Mohammad Nejati
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#include <boost/http_proto/detail/except.hpp>
+#include <boost/http_proto/detail/header.hpp>
+#include <boost/http_proto/field_registry.hpp>
+
+#include "src/detail/field_registry.hpp"
+#include "src/rfc/detail/rules.hpp"
+
+#include <boost/url/grammar/parse.hpp>
+
+namespace boost {
+namespace http_proto {
+
+field
+register_field(
+    rts::context& ctx,
+    core::string_view name)
+{
+    if(grammar::parse(name,
+        detail::field_name_rule).has_error())
+        detail::throw_invalid_argument();
+
+    auto const id = string_to_field(name);
+    if(id)
+        return *id;
+
+    auto* svc = ctx.find_service<
+        detail::field_registry>();
+    if(! svc)
+        svc = &ctx.make_service<
+            detail::field_registry>();
+
+    auto const found =
+        svc->string_to_field(name);
+    if(found != detail::header::unknown_field)
+        return found;
+
+    auto const n = static_cast<std::size_t>(
+        detail::header::first_registered_field) +
+            svc->names.size();
+    if(n > 0xffff)
+        detail::throw_length_error();
+
+    svc->names.emplace_back(
+        name.data(), name.size());
+    auto const f = static_cast<field>(n);
+    try
+    {
+        svc->ids.emplace(
+            svc->names.back(), f);
+    }
+    catch(...)
+    {
+        svc->names.pop_back();
+        throw;
+    }
+    return f;
+}
+
+boost::optional<field>
+string_to_field(
+    rts::context const& ctx,
+    core::string_view s) noexcept
+{
+    auto const id = string_to_field(s);
+    if(id)
+        return id;
+    auto const* svc =
+        detail::field_registry::find(ctx);
+    if(! svc)
+        return boost::none;
+    auto const f = svc->string_to_field(s);
+    if(f == detail::header::unknown_field)
+        return boost::none;
+    return f;
+}
+
+core::string_view
+to_string(
+    rts::context const& ctx,
+    field f)
+{
+    if(f < detail::header::first_registered_field)
+        return to_string(f);
+    auto const* svc =
+        detail::field_registry::find(ctx);
+    auto const i =
+        static_cast<std::size_t>(f) -
+        static_cast<std::size_t>(
+            detail::header::first_registered_field);
+    if(! svc || i >= svc->names.size())
+        detail::throw_invalid_argument();
+    return svc->names[i];
+}
+
+} // http_proto
+} // boost
@@ -11,6 +11,7 @@
 #include <boost/http_proto/detail/config.hpp>
 #include <boost/http_proto/detail/except.hpp>
 #include <boost/http_proto/detail/header.hpp>
+#include <boost/http_proto/edit_batch.hpp>
 #include <boost/http_proto/error.hpp>
 #include <boost/http_proto/field.hpp>
 #include <boost/http_proto/fields_base.hpp>
@@ -49,6 +50,41 @@ align_down(
     return 0;
 }
 
+// Return the capacity to allocate when at
+// least n bytes are needed. Growing
+// geometrically keeps a sequence of inserts
+// to a logarithmic number of reallocations.
+std::size_t
+grow_capacity(
+    std::size_t cap,
+    std::size_t n,
+    std::size_t max_cap) noexcept
+{
+    if(n > max_cap)
+        return n;
+    auto const cap2 = cap > max_cap / 2
+        ? max_cap : cap * 2;
+    if(cap2 <= n)
+        return n;
+    // n is already aligned
+    return cap2 & ~(
+        alignof(detail::header::entry) - 1);
+}
+
+// give the slack in front of the
+// start line back to the buffer
+void
+reclaim_slack(
+    detail::header& h) noexcept
+{
+    if(h.slack == 0)
+        return;
+    h.buf -= h.slack;
+    h.cbuf = h.buf;
+    h.cap += h.slack;
+    h.slack = 0;
+}
+
 void
 verify_field_name(
     core::string_view name,
@@ -87,6 +123,22 @@ verify_field_value(
     return rv;
 }
 
+// true if an edit of the field id
+// or name applies to the field
+bool
+edit_matches(
+    field edit_id,
+    core::string_view edit_name,
+    field id,
+    core::string_view name) noexcept
+{
+    if(edit_id != detail::header::unknown_field)
+        return id == edit_id;
+    return
+        ! detail::header::is_enumerated(id) &&
+        grammar::ci_is_equal(name, edit_name);
+}
+
 } // namespace
 
 class fields_base::
@@ -98,6 +150,7 @@ class fields_base::
     char* buf_ = nullptr;
     char const* cbuf_ = nullptr;
     std::size_t cap_ = 0;
+    bool external_ = false;
 
 public:
     explicit
@@ -113,8 +166,8 @@ public:
 
     ~op_t()
     {
-        if(buf_)
-            delete[] buf_;
+        if(buf_ && !external_)
+            self_.deallocate(buf_, cap_);
     }
 
     char const*
@@ -144,6 +197,12 @@ public:
     bool
     reserve(std::size_t n);
 
+    void
+    realloc(std::size_t n);
+
+    void
+    compact() noexcept;
+
     bool
     grow(
         std::size_t extra_char,
@@ -162,7 +221,6 @@ op_t::
 reserve(
     std::size_t n)
 {
-    // TODO: consider using a growth factor
     if(n > self_.max_cap_)
     {
         // max capacity exceeded
@@ -170,14 +228,54 @@ reserve(
     }
     if(n <= self_.h_.cap)
         return false;
-    auto buf = new char[n];
-    buf_ = self_.h_.buf;
+    if(n <= self_.h_.cap + self_.h_.slack)
+    {
+        // fits once the slack
+        // is given back
+        compact();
+        return false;
+    }
+    realloc(n);
+    return true;
+}
+
+// switch to a new buffer of n bytes,
+// keeping the old one until destruction
+void
+fields_base::
+op_t::
+realloc(
+    std::size_t n)
+{
+    auto buf = self_.allocate(n);
+    buf_ = self_.h_.buf - self_.h_.slack;
     cbuf_ = self_.h_.cbuf;
-    cap_ = self_.h_.cap;
+    cap_ = self_.h_.cap + self_.h_.slack;
+    // inline storage is left behind
+    external_ = self_.external_storage_;
+    self_.external_storage_ = false;
     self_.h_.buf = buf;
     self_.h_.cbuf = buf;
     self_.h_.cap = n;
-    return true;
+    self_.h_.slack = 0;
+}
+
+// move the characters to the front of the
+// buffer, turning the slack into capacity.
+// The table is at the end and stays put.
+void
+fields_base::
+op_t::
+compact() noexcept
+{
+    auto& h = self_.h_;
+    if(h.slack == 0)
+        return;
+    move_chars(
+        h.buf - h.slack,
+        h.buf,
+        h.size);
+    reclaim_slack(h);
 }
 
 bool
@@ -193,10 +291,18 @@ grow(
     if(extra_char > detail::header::max_offset - self_.h_.size)
         detail::throw_length_error();
 
-    return reserve(
+    auto const n =
         detail::header::bytes_needed(
             self_.h_.size + extra_char,
-            self_.h_.count + extra_field));
+            self_.h_.count + extra_field);
+    if(n <= self_.h_.cap)
+        return false;
+    auto const total =
+        self_.h_.cap + self_.h_.slack;
+    if(n <= total)
+        return reserve(n);
+    return reserve(grow_capacity(
+        total, n, self_.max_cap_));
 }
 
 void
@@ -224,81 +330,134 @@ prefix_op_t(
     , new_prefix_(static_cast<
         offset_type>(new_prefix))
 {
-    if(self.h_.size - self.h_.prefix + new_prefix
+    auto& h = self.h_;
+    if(h.size - h.prefix + new_prefix
         > detail::header::max_offset)
         detail::throw_length_error();
 
-    // memmove happens in the destructor
-    // to avoid overlaping with start line.
-    if(new_prefix_ < self_.h_.prefix
-        && !self.h_.is_default())
-        return;
+    auto const new_size = static_cast<offset_type>(
+        h.size - h.prefix + new_prefix_);
+
+    if(! h.is_default())
+    {
+        if(new_prefix_ <= h.prefix)
+        {
+            // The fields stay where they are and
+            // the bytes freed in front of the
+            // start line become slack.
+            auto const d = h.prefix - new_prefix_;
+            h.buf += d;
+            h.cbuf = h.buf;
+            h.cap -= d;
+            h.slack += d;
+            h.size = new_size;
+            h.prefix = new_prefix_;
+            return;
+        }
 
-    auto new_size = static_cast<offset_type>(
-        self.h_.size - self.h_.prefix + new_prefix_);
+        auto const d = new_prefix_ - h.prefix;
+        if(d <= h.slack)
+        {
+            // Grow into the slack. Only the start
+            // line moves, so it is where the caller
+            // expects it to be.
+            detail::move_chars(
+                h.buf - d,
+                h.cbuf,
+                h.prefix,
+                s0,
+                s1);
+            h.buf -= d;
+            h.cbuf = h.buf;
+            h.cap += d;
+            h.slack -= d;
+            h.size = new_size;
+            h.prefix = new_prefix_;
+            return;
+        }
+    }
 
-    auto bytes_needed =
+    // The fields have to move. Leave the
+    // configured slack in front of the start
+    // line when there is room for it, so that
+    // the next changes can grow into it.
+    auto const total = h.cap + h.slack;
+    auto const n0 =
         detail::header::bytes_needed(
             new_size,
-            self.h_.count);
+            h.count);
+    std::size_t slack = self.start_line_slack_;
+    auto n = detail::header::bytes_needed(
+        new_size + slack,
+        h.count);
+    if(n > total && (
+        n0 <= total || n > self.max_cap_))
+    {
+        slack = 0;
+        n = n0;
+    }
 
-    if(bytes_needed > self.h_.cap)
+    if(n > total)
     {
         // static storage will always throw which is
         // intended since they cannot reallocate.
-        if(self.max_cap_ < bytes_needed)
+        if(self.max_cap_ < n)
             detail::throw_length_error();
-        // TODO: consider using a growth factor
-        char* p = new char[bytes_needed];
+        auto const cap = grow_capacity(
+            total, n, self.max_cap_);
+        char* p = self.allocate(cap);
         std::memcpy(
-            p + new_prefix_,
-            self.h_.cbuf + self.h_.prefix,
-            self.h_.size - self.h_.prefix);
-        self.h_.copy_table(p + bytes_needed);
+            p + slack + new_prefix_,
+            h.cbuf + h.prefix,
+            h.size - h.prefix);
+        h.copy_table(p + cap);
 
         // old buffer gets released in the destructor
         // to avoid invalidating any string_views
         // that may still reference it.
-        buf_        = self.h_.buf;
-        self.h_.buf = p;
-        self.h_.cap = bytes_needed;
+        buf_        = h.buf - h.slack;
+        cap_        = total;
+        external_   = self.external_storage_;
+        h.buf       = p + slack;
+        h.cap       = cap - slack;
+        h.slack     = slack;
+        self.external_storage_ = false;
     }
     else
     {
-        // memmove to the right and update any
-        // string_views that reference that region.
+        // memmove the fields to the right, then
+        // the start line, and update any
+        // string_views that reference them.
+        auto const base = h.buf - h.slack;
         detail::move_chars(
-            self.h_.buf + new_prefix_,
-            self.h_.cbuf + self.h_.prefix,
-            self.h_.size - self.h_.prefix,
+            base + slack + new_prefix_,
+            h.cbuf + h.prefix,
+            h.size - h.prefix,
             s0,
             s1);
+        if(base + slack != h.buf)
+            detail::move_chars(
+                base + slack,
+                h.cbuf,
+                h.prefix,
+                s0,
+                s1);
+        h.buf   = base + slack;
+        h.cap   = total - slack;
+        h.slack = slack;
     }
 
-    self.h_.cbuf   = self.h_.buf;
-    self.h_.size   = new_size;
-    self.h_.prefix = new_prefix_;
+    h.cbuf   = h.buf;
+    h.size   = new_size;
+    h.prefix = new_prefix_;
 }
 
 fields_base::
 prefix_op_t::
 ~prefix_op_t()
 {
-    if(new_prefix_ < self_.h_.prefix)
-    {
-        std::memmove(
-            self_.h_.buf + new_prefix_,
-            self_.h_.cbuf + self_.h_.prefix,
-            self_.h_.size - self_.h_.prefix);
-
-        self_.h_.size =
-            self_.h_.size - self_.h_.prefix + new_prefix_;
-        self_.h_.prefix = new_prefix_;
-    }
-    else if(buf_)
-    {
-        delete[] buf_;
-    }
+    if(buf_ && !external_)
+        self_.deallocate(buf_, cap_);
 }
 
 //------------------------------------------------
@@ -310,6 +469,15 @@ fields_base(
 {
 }
 
+fields_base::
+fields_base(
+    detail::kind k,
+    memory_resource* mr) noexcept
+    : h_(k)
+    , mr_(mr)
+{
+}
+
 fields_base::
 fields_base(
     detail::kind k,
@@ -349,13 +517,16 @@ fields_base(
     h_.parse(s.size(), lim, ec);
     if(ec.failed())
         detail::throw_system_error(ec);
+    index_reserve(h_.count);
 }
 
 // construct a complete copy of h
 fields_base::
 fields_base(
-    detail::header const& h)
+    detail::header const& h,
+    memory_resource* mr)
     : h_(h.kind)
+    , mr_(mr)
 {
     if(h.is_default())
         return;
@@ -367,6 +538,7 @@ fields_base(
     std::memcpy(
         h_.buf, h.cbuf, h.size);
     h.copy_table(h_.buf + h_.cap);
+    index_reserve(h_.count);
 }
 
 // construct a complete copy of h
@@ -408,8 +580,11 @@ fields_base(fields_base const& other)
 fields_base::
 ~fields_base()
 {
+    index_release();
     if(h_.buf && !external_storage_)
-        delete[] h_.buf;
+        deallocate(
+            h_.buf - h_.slack,
+            h_.cap + h_.slack);
 }
 
 //------------------------------------------------
@@ -424,6 +599,7 @@ clear() noexcept
 {
     if(! h_.buf)
         return;
+    reclaim_slack(h_);
     using H =
         detail::header;
     auto const& h =
@@ -434,6 +610,8 @@ clear() noexcept
         h_.buf,
         h.cbuf,
         h_.size);
+    if(ix_.size != 0)
+        ix_.rebuild(h_);
 }
 
 void
@@ -441,6 +619,8 @@ fields_base::
 reserve_bytes(
     std::size_t n)
 {
+    if(n <= h_.cap)
+        return;
     op_t op(*this);
     if(! op.reserve(n))
         return;
@@ -461,14 +641,15 @@ shrink_to_fit()
 {
     if(detail::header::bytes_needed(
         h_.size, h_.count) >=
-            h_.cap)
+            capacity_in_bytes())
         return;
 
     if(external_storage_)
         return;
 
-    fields_base tmp(h_);
+    fields_base tmp(h_, mr_);
     tmp.h_.swap(h_);
+    std::swap(tmp.ix_, ix_);
 }
 
 
@@ -476,7 +657,7 @@ void
 fields_base::
 set_max_capacity_in_bytes(std::size_t n)
 {
-    if(n < h_.cap)
+    if(n < capacity_in_bytes())
         detail::throw_invalid_argument();
     max_cap_ = n;
 }
@@ -597,7 +778,7 @@ operator++() noexcept ->
     BOOST_ASSERT(i_ < ph_->count);
     auto const* e = &ph_->tab()[i_];
     auto const id = e->id;
-    if(id != detail::header::unknown_field)
+    if(detail::header::is_enumerated(id))
     {
         ++i_;
         --e;
@@ -720,6 +901,9 @@ find(
     core::string_view name) const noexcept ->
     iterator
 {
+    if(ix_.size != 0)
+        return iterator(
+            &h_, ix_.find(h_, name));
     auto it = begin();
     auto const last = end();
     while(it != last)
@@ -877,8 +1061,9 @@ erase(
 {
     auto const id = it->id.value_or(
         detail::header::unknown_field);
+    auto const flags = h_.tab()[it.i_].flags;
     raw_erase(it.i_);
-    h_.on_erase(id);
+    h_.on_erase(id, flags);
     return it;
 }
 
@@ -898,12 +1083,12 @@ fields_base::
 erase(
     core::string_view name) noexcept
 {
-    auto const i0 = h_.find(name);
+    auto const i0 = find(name).i_;
     if(i0 == h_.count)
         return 0;
     auto const ft = h_.tab();
     auto const id = ft[i0].id;
-    if(id == detail::header::unknown_field)
+    if(! detail::header::is_enumerated(id))
         return erase_all(i0, name);
     return erase_all(i0, id);
 }
@@ -1025,10 +1210,10 @@ set(
         auto& e = h_.tab()[i];
         e.id = detail::header::unknown_field;
         h_.buf[pos0] = '\0';
-        h_.on_erase(id);
+        h_.on_erase(id, e.flags);
         h_.buf[pos0] = saved; // restore
         e.id = id;
-        h_.on_insert(id, it->value);
+        e.flags = h_.on_insert(id, it->value);
     }
 }
 
@@ -1061,7 +1246,10 @@ set(
                 ft[i0].nn + 2 +
                     rv->value.size() + 2;
             // VFALCO missing overflow check
-            reserve_bytes(n0 + n);
+            reserve_bytes(
+                detail::header::bytes_needed(
+                    n0 + n, h_.count));
+            index_reserve(h_.count);
         }
         erase_all(i0, id);
     }
@@ -1094,7 +1282,7 @@ set(
         return;
     }
 
-    auto const i0 = h_.find(name);
+    auto const i0 = find(name).i_;
     if(i0 != h_.count)
     {
         // field exists
@@ -1108,11 +1296,14 @@ set(
                 ft[i0].nn + 2 +
                     rv->value.size() + 2;
             // VFALCO missing overflow check
-            reserve_bytes(n0 + n);
+            reserve_bytes(
+                detail::header::bytes_needed(
+                    n0 + n, h_.count));
+            index_reserve(h_.count);
         }
         // VFALCO simple algorithm but
         // costs one extra memmove
-        if(id != detail::header::unknown_field)
+        if(detail::header::is_enumerated(id))
             erase_all(i0, id);
         else
             erase_all(i0, name);
@@ -1220,9 +1411,11 @@ copy_impl(
     auto const n =
         detail::header::bytes_needed(
             h.size, h.count);
+    reclaim_slack(h_);
     if(n <= h_.cap && (!h.is_default() || external_storage_))
     {
         // no realloc
+        index_reserve(h.count);
         h.assign_to(h_);
         h.copy_table(
             h_.buf + h_.cap);
@@ -1230,15 +1423,315 @@ copy_impl(
             h_.buf,
             h.cbuf,
             h.size);
+        if(ix_.size != 0)
+            ix_.rebuild(h_);
         return;
     }
 
     // static storages cannot reallocate
-    if(external_storage_)
+    if(n > max_cap_)
         detail::throw_length_error();
 
-    fields_base tmp(h);
+    fields_base tmp(h, mr_);
     tmp.h_.swap(h_);
+    std::swap(tmp.ix_, ix_);
+    // inline storage is not released
+    tmp.external_storage_ = external_storage_;
+    external_storage_ = false;
+}
+
+// Release any heap buffer and go back
+// to the default contents in storage.
+void
+fields_base::
+reset_inline(
+    void* storage,
+    std::size_t cap) noexcept
+{
+    index_release();
+    if(h_.buf && !external_storage_)
+        deallocate(
+            h_.buf - h_.slack,
+            h_.cap + h_.slack);
+    auto const& h =
+        *detail::header::get_default(h_.kind);
+    h_.buf = static_cast<char*>(storage);
+    h_.cbuf = h_.buf;
+    h_.cap = align_down(
+        storage,
+        cap,
+        alignof(detail::header::entry));
+    h_.slack = 0;
+    external_storage_ = true;
+    h.assign_to(h_);
+    std::memcpy(
+        h_.buf, h.cbuf, h.size);
+}
+
+// Take the contents of other, which uses
+// inline storage of the same capacity as
+// this. Inline contents are copied and a
+// heap buffer is transferred. Either way,
+// other goes back to the default contents
+// in its own storage.
+void
+fields_base::
+take_inline(
+    fields_base& other,
+    void* other_storage,
+    std::size_t cap) noexcept
+{
+    BOOST_ASSERT(external_storage_);
+    BOOST_ASSERT(h_.slack == 0);
+    max_cap_ = other.max_cap_;
+    mr_ = other.mr_;
+    if(other.external_storage_)
+    {
+        // both storages have the same capacity,
+        // and inline contents are never indexed,
+        // so this neither throws nor allocates
+        auto const& h = other.h_;
+        BOOST_ASSERT(detail::header::bytes_needed(
+            h.size, h.count) <= h_.cap);
+        BOOST_ASSERT(other.ix_.size == 0);
+        h.assign_to(h_);
+        h.copy_table(h_.buf + h_.cap);
+        std::memcpy(h_.buf, h.cbuf, h.size);
+    }
+    else
+    {
+        h_ = other.h_;
+        ix_ = other.ix_;
+        other.ix_ = {};
+        external_storage_ = false;
+        other.external_storage_ = true;
+    }
+    other.reset_inline(other_storage, cap);
+    other.mr_ = nullptr;
+    other.max_cap_ = (std::numeric_limits<
+        std::size_t>::max)();
+}
+
+// apply the edits of a batch with one
+// pass over the fields
+void
+fields_base::
+commit_batch(
+    edit_batch& b,
+    system::error_code& ec)
+{
+    using op_kind = edit_batch::op_kind;
+    auto& ops = b.ops_;
+    if(ops.empty())
+        return;
+
+    // validate before making changes
+    for(auto& o : ops)
+    {
+        if(o.kind == op_kind::erase)
+            continue;
+        verify_field_name(o.name, ec);
+        if(ec.failed())
+            return;
+        auto rv = verify_field_value(o.value);
+        if(rv.has_error())
+        {
+            ec = rv.error();
+            return;
+        }
+        o.value = rv->value;
+        o.has_obs_fold = rv->has_obs_fold;
+    }
+
+    // true if no edit from `first` on
+    // erases the field
+    auto const kept = [&ops](
+        std::size_t first,
+        field id,
+        core::string_view name) -> bool
+    {
+        for(auto i = first; i < ops.size(); ++i)
+        {
+            if( ops[i].kind != op_kind::append &&
+                edit_matches(
+                    ops[i].id, ops[i].name, id, name))
+                return false;
+        }
+        return true;
+    };
+
+    auto const field_size = [](
+        edit_batch::op const& o) -> std::size_t
+    {
+        return
+            o.name.size() +     // name
+            1 +                 // ':'
+            ! o.value.empty() + // [SP]
+            o.value.size() +    // value
+            2;                  // CRLF
+    };
+
+    // compute the final size
+    std::size_t size = h_.size;
+    std::size_t count = 0;
+    bool aliased = false;
+    {
+        auto const ft = h_.tab();
+        auto const p = h_.cbuf + h_.prefix;
+        for(std::size_t i = 0; i < h_.count; ++i)
+        {
+            if(kept(0, ft[i].id,
+                core::string_view(p + ft[i].np, ft[i].nn)))
+                ++count;
+            else
+                size -= length(i);
+        }
+        core::string_view const buf(h_.buf, h_.cap);
+        for(std::size_t i = 0; i < ops.size(); ++i)
+        {
+            auto const& o = ops[i];
+            if( o.kind == op_kind::erase ||
+                ! kept(i + 1, o.id, o.name))
+                continue;
+            if(size > detail::header::max_offset)
+                break;
+            size += field_size(o);
+            ++count;
+            if( detail::is_overlapping(buf, o.name) ||
+                detail::is_overlapping(buf, o.value))
+                aliased = true;
+        }
+    }
+    if( size > detail::header::max_offset ||
+        count > detail::header::max_offset)
+        detail::throw_length_error();
+
+    index_reserve(count);
+
+    // reallocate at most once. Values which
+    // refer to this container are read from
+    // the old buffer.
+    op_t op(*this);
+    auto const n =
+        detail::header::bytes_needed(size, count);
+    auto const total = h_.cap + h_.slack;
+    bool const realloc = n > total || aliased;
+    if(realloc)
+    {
+        if(n > max_cap_)
+            detail::throw_length_error();
+        op.realloc(n > total
+            ? grow_capacity(total, n, max_cap_)
+            : total);
+    }
+    else if(n > h_.cap)
+    {
+        op.compact();
+    }
+
+    // compact the fields. In place, fields
+    // only move down and entries only move
+    // up, and each is read before it can
+    // be overwritten.
+    auto const src = realloc ? op.cbuf() : h_.cbuf;
+    auto const src_tab = realloc ? op.tab() : h_.tab();
+    auto const dest_tab = h_.tab();
+    auto const prefix = h_.prefix;
+    if(realloc)
+        std::memcpy(h_.buf, src, prefix);
+    std::size_t pos = prefix;
+    std::size_t j = 0;
+    for(std::size_t i = 0; i < h_.count; ++i)
+    {
+        auto e = src_tab[i];
+        auto const p0 = prefix + e.np;
+        auto const p1 = i + 1 < h_.count
+            ? prefix + src_tab[i + 1].np
+            : h_.size - 2;
+        if(! kept(0, e.id,
+            core::string_view(src + p0, e.nn)))
+            continue;
+        std::memmove(
+            h_.buf + pos, src + p0, p1 - p0);
+        auto const np = static_cast<
+            offset_type>(pos - prefix);
+        e.vp = static_cast<offset_type>(
+            np + e.vp - e.np);
+        e.np = np;
+        dest_tab[j++] = e;
+        pos += p1 - p0;
+    }
+    for(std::size_t i = 0; i < ops.size(); ++i)
+    {
+        auto const& o = ops[i];
+        if( o.kind == op_kind::erase ||
+            ! kept(i + 1, o.id, o.name))
+            continue;
+        auto dest = h_.buf + pos;
+        o.name.copy(dest, o.name.size());
+        dest += o.name.size();
+        *dest++ = ':';
+        if(! o.value.empty())
+        {
+            *dest++ = ' ';
+            o.value.copy(
+                dest, o.value.size());
+            if( o.has_obs_fold )
+                detail::remove_obs_fold(
+                    dest, dest + o.value.size());
+            dest += o.value.size();
+        }
+        *dest++ = '\r';
+        *dest = '\n';
+
+        auto& e = dest_tab[j++];
+        e.np = static_cast<offset_type>(
+            pos - prefix);
+        e.nn = static_cast<
+            offset_type>(o.name.size());
+        e.vp = static_cast<offset_type>(
+            pos - prefix +
+                o.name.size() + 1 +
+                ! o.value.empty());
+        e.vn = static_cast<
+            offset_type>(o.value.size());
+        e.id = o.id;
+        e.flags = 0;
+        pos += field_size(o);
+    }
+    h_.buf[pos] = '\r';
+    h_.buf[pos + 1] = '\n';
+    BOOST_ASSERT(j == count);
+    BOOST_ASSERT(pos + 2 == size);
+    h_.count = static_cast<offset_type>(count);
+    h_.size = static_cast<offset_type>(size);
+
+    // rebuild the metadata of each
+    // special field which was touched
+    for(std::size_t i = 0; i < ops.size(); ++i)
+    {
+        auto const id = ops[i].id;
+        if(! h_.is_special(id))
+            continue;
+        std::size_t k = 0;
+        while(k < i && ops[k].id != id)
+            ++k;
+        if(k < i)
+            continue; // already done
+        h_.on_erase_all(id);
+        auto const ft = h_.tab();
+        auto const p = h_.cbuf + h_.prefix;
+        for(k = 0; k < h_.count; ++k)
+        {
+            if(ft[k].id == id)
+                ft[k].flags = h_.on_insert(
+                    id, core::string_view(
+                        p + ft[k].vp, ft[k].vn));
+        }
+    }
+
+    if(ix_.size != 0)
+        ix_.rebuild(h_);
 }
 
 void
@@ -1278,6 +1771,7 @@ insert_unchecked(
     std::size_t before,
     bool has_obs_fold)
 {
+    index_reserve(h_.count + 1);
     auto const tab0 = h_.tab_();
     auto const pos = offset(before);
     auto const n =
@@ -1367,7 +1861,9 @@ insert_unchecked(
     h_.count++;
     h_.size = static_cast<
         offset_type>(h_.size + n);
-    h_.on_insert(e.id, value);
+    e.flags = h_.on_insert(e.id, value);
+    if(ix_.size != 0)
+        ix_.on_insert(h_, before);
 }
 
 void
@@ -1377,6 +1873,8 @@ raw_erase(
 {
     BOOST_ASSERT(i < h_.count);
     BOOST_ASSERT(h_.buf != nullptr);
+    if(ix_.size != 0)
+        ix_.on_erase(h_, i);
     auto const p0 = offset(i);
     auto const p1 = offset(i + 1);
     std::memmove(
@@ -1444,8 +1942,8 @@ erase_all(
     return n;
 }
 
-// erase all fields with name
-// when id == detail::header::unknown_field
+// erase all fields with name, when
+// the id is not an enumerated constant
 std::size_t
 fields_base::
 erase_all(
@@ -1460,7 +1958,7 @@ erase_all(
     {
         core::string_view s(
             p + ft[i].np, ft[i].nn);
-        if(s == name)
+        if(grammar::ci_is_equal(s, name))
         {
             raw_erase(i);
             ++n;
@@ -1498,5 +1996,72 @@ length(
         offset(i);
 }
 
+// Make room in the name index for n
+// fields, building it when n reaches the
+// threshold. Inline storage is never
+// indexed since it must not allocate.
+void
+fields_base::
+index_reserve(
+    std::size_t n)
+{
+    using index = detail::name_index;
+    if(external_storage_)
+        return;
+    if( ix_.size == 0 &&
+        n < index::threshold)
+        return;
+    auto const size =
+        index::slots_needed(n);
+    if(size <= ix_.size)
+        return;
+    auto const p = allocate(
+        size * sizeof(index::slot_type));
+    index_release();
+    ix_.slots = reinterpret_cast<
+        index::slot_type*>(p);
+    ix_.size = size;
+    ix_.rebuild(h_);
+}
+
+void
+fields_base::
+index_release() noexcept
+{
+    if(ix_.size == 0)
+        return;
+    deallocate(
+        reinterpret_cast<char*>(ix_.slots),
+        ix_.size * sizeof(
+            detail::name_index::slot_type));
+    ix_ = {};
+}
+
+// Memory comes from the resource, or
+// operator new[] when there is none.
+char*
+fields_base::
+allocate(
+    std::size_t n)
+{
+    if(! mr_)
+        return new char[n];
+    return static_cast<char*>(mr_->allocate(
+        n, alignof(detail::header::entry)));
+}
+
+void
+fields_base::
+deallocate(
+    char* p,
+    std::size_t n) noexcept
+{
+    if(! mr_)
+        delete[] p;
+    else
+        mr_->deallocate(
+            p, n, alignof(detail::header::entry));
+}
+
 } // http_proto
 } // boost
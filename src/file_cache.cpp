@@ -0,0 +1,326 @@
+//
+// Copyright (c) 2025 Mohammad Nejati
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#include <boost/http_proto/file_cache.hpp>
+#include <boost/http_proto/detail/except.hpp>
+
+#include <iterator>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#if BOOST_HTTP_PROTO_USE_WIN32_FILE
+# include <boost/winapi/file_management.hpp>
+# include <boost/winapi/get_last_error.hpp>
+#elif BOOST_HTTP_PROTO_USE_POSIX_FILE
+# include <errno.h>
+# include <sys/stat.h>
+#endif
+
+namespace boost {
+namespace http_proto {
+
+namespace {
+
+struct attributes
+{
+    std::uint64_t size = 0;
+    std::uint64_t mtime = 0;
+    std::uint64_t id = 0;
+};
+
+bool
+is_current(
+    file_cache::entry const& e,
+    attributes const& a) noexcept
+{
+    return
+        e.size == a.size &&
+        e.mtime == a.mtime &&
+        e.id == a.id;
+}
+
+#if ! BOOST_HTTP_PROTO_USE_WIN32_FILE && BOOST_HTTP_PROTO_USE_POSIX_FILE
+
+attributes
+to_attributes(struct ::stat const& st) noexcept
+{
+    attributes a;
+    a.size = static_cast<std::uint64_t>(st.st_size);
+#if defined(__APPLE__)
+    auto const& t = st.st_mtimespec;
+#else
+    auto const& t = st.st_mtim;
+#endif
+    a.mtime =
+        static_cast<std::uint64_t>(t.tv_sec) * 1000000000 +
+        static_cast<std::uint64_t>(t.tv_nsec);
+    a.id = static_cast<std::uint64_t>(st.st_ino);
+    return a;
+}
+
+#endif
+
+// Return the attributes of an open file
+attributes
+get_attributes(
+    file& f,
+    system::error_code& ec)
+{
+    attributes a;
+#if BOOST_HTTP_PROTO_USE_WIN32_FILE
+    winapi::BY_HANDLE_FILE_INFORMATION_ info;
+    if(! winapi::GetFileInformationByHandle(
+        f.native_handle(), &info))
+    {
+        ec.assign(winapi::GetLastError(),
+            system::system_category());
+        return a;
+    }
+    a.size =
+        (std::uint64_t(info.nFileSizeHigh) << 32) |
+        info.nFileSizeLow;
+    a.mtime =
+        (std::uint64_t(info.ftLastWriteTime.dwHighDateTime) << 32) |
+        info.ftLastWriteTime.dwLowDateTime;
+    a.id =
+        (std::uint64_t(info.nFileIndexHigh) << 32) |
+        info.nFileIndexLow;
+    ec = {};
+#elif BOOST_HTTP_PROTO_USE_POSIX_FILE
+    struct ::stat st;
+    if(::fstat(f.native_handle(), &st) != 0)
+    {
+        ec.assign(errno,
+            system::system_category());
+        return a;
+    }
+    a = to_attributes(st);
+    ec = {};
+#else
+    a.size = f.size(ec);
+#endif
+    return a;
+}
+
+// Return the attributes of the file at path
+attributes
+get_attributes(
+    char const* path,
+    system::error_code& ec)
+{
+#if ! BOOST_HTTP_PROTO_USE_WIN32_FILE && BOOST_HTTP_PROTO_USE_POSIX_FILE
+    struct ::stat st;
+    if(::stat(path, &st) != 0)
+    {
+        ec.assign(errno,
+            system::system_category());
+        return {};
+    }
+    ec = {};
+    return to_attributes(st);
+#else
+    file f;
+    f.open(path, file_mode::read, ec);
+    if(ec.failed())
+        return {};
+    return get_attributes(f, ec);
+#endif
+}
+
+} // (anon)
+
+//------------------------------------------------
+
+class file_cache::impl
+{
+public:
+    struct node
+    {
+        std::string path;
+        std::shared_ptr<entry> e;
+        std::chrono::steady_clock::time_point checked;
+    };
+
+    using list_type = std::list<node>;
+
+    config cfg;
+    mutable std::mutex m;
+
+    // most recently used first
+    list_type lru;
+    std::unordered_map<
+        std::string,
+        list_type::iterator> map;
+
+    explicit
+    impl(config const& cfg_)
+        : cfg(cfg_)
+    {
+    }
+
+    void
+    erase(list_type::iterator it) noexcept
+    {
+        map.erase(it->path);
+        lru.erase(it);
+    }
+};
+
+//------------------------------------------------
+
+file_cache::
+file_cache(config const& cfg)
+    : impl_(new impl(cfg))
+{
+}
+
+file_cache::
+~file_cache()
+{
+    delete impl_;
+}
+
+auto
+file_cache::
+open(
+    core::string_view path,
+    system::error_code& ec) ->
+        std::shared_ptr<entry>
+{
+    std::string s(path.data(), path.size());
+    auto const now = std::chrono::steady_clock::now();
+
+    {
+        std::unique_lock<std::mutex> lock(impl_->m);
+        auto it = impl_->map.find(s);
+        if(it != impl_->map.end())
+        {
+            auto const pos = it->second;
+            if(now - pos->checked < impl_->cfg.check_interval)
+            {
+                impl_->lru.splice(
+                    impl_->lru.begin(), impl_->lru, pos);
+                ec = {};
+                return pos->e;
+            }
+
+            // check the file outside of the lock; other
+            // threads use the entry until this is done
+            auto const e = pos->e;
+            pos->checked = now;
+            lock.unlock();
+
+            system::error_code ec1;
+            auto const a = get_attributes(s.c_str(), ec1);
+            bool const current =
+                ! ec1.failed() && is_current(*e, a);
+
+            // the node may be gone or replaced
+            lock.lock();
+            it = impl_->map.find(s);
+            if( it != impl_->map.end() &&
+                it->second->e == e)
+            {
+                if(current)
+                    impl_->lru.splice(
+                        impl_->lru.begin(),
+                        impl_->lru, it->second);
+                else
+                    impl_->erase(it->second);
+            }
+            if(current)
+            {
+                ec = {};
+                return e;
+            }
+        }
+    }
+
+    // open outside of the lock, so that
+    // hits on other files do not wait
+    auto e = std::make_shared<entry>();
+    e->f.open(s.c_str(), file_mode::scan, ec);
+    if(ec.failed())
+        return nullptr;
+    auto const a = get_attributes(e->f, ec);
+    if(ec.failed())
+        return nullptr;
+    e->size = a.size;
+    e->mtime = a.mtime;
+    e->id = a.id;
+
+    std::lock_guard<std::mutex> lock(impl_->m);
+
+    // another thread may have opened
+    // it meanwhile, keep the newest
+    auto const it = impl_->map.find(s);
+    if(it != impl_->map.end())
+        impl_->erase(it->second);
+
+    impl_->lru.push_front({ s, e, now });
+    try
+    {
+        impl_->map.emplace(
+            std::move(s), impl_->lru.begin());
+    }
+    catch(...)
+    {
+        impl_->lru.pop_front();
+        throw;
+    }
+
+    while(impl_->lru.size() > impl_->cfg.max_files)
+        impl_->erase(std::prev(impl_->lru.end()));
+    return e;
+}
+
+auto
+file_cache::
+open(core::string_view path) ->
+    std::shared_ptr<entry>
+{
+    system::error_code ec;
+    auto e = open(path, ec);
+    if(ec.failed())
+        detail::throw_system_error(ec);
+    return e;
+}
+
+void
+file_cache::
+erase(core::string_view path)
+{
+    std::string s(path.data(), path.size());
+    std::lock_guard<std::mutex> lock(impl_->m);
+    auto const it = impl_->map.find(s);
+    if(it != impl_->map.end())
+        impl_->erase(it->second);
+}
+
+void
+file_cache::
+clear() noexcept
+{
+    std::lock_guard<std::mutex> lock(impl_->m);
+    impl_->map.clear();
+    impl_->lru.clear();
+}
+
+std::size_t
+file_cache::
+size() const noexcept
+{
+    std::lock_guard<std::mutex> lock(impl_->m);
+    return impl_->lru.size();
+}
+
+} // http_proto
+} // boost
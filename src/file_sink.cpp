@@ -9,10 +9,28 @@
 //
 
 #include <boost/http_proto/file_sink.hpp>
+#include <boost/http_proto/detail/except.hpp>
+
+#include <boost/core/exchange.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+#if BOOST_HTTP_PROTO_USE_POSIX_FILE
+# include <fcntl.h>
+#endif
 
 namespace boost {
 namespace http_proto {
 
+namespace {
+
+// the alignment of buffers, offsets and
+// sizes for writes which bypass the cache
+constexpr std::size_t direct_align = 4096;
+
+} // (anon)
+
 file_sink::
 file_sink(file&& f) noexcept
     : f_(std::move(f))
@@ -20,10 +38,161 @@ file_sink(file&& f) noexcept
 }
 
 file_sink::
-file_sink(file_sink&&) noexcept = default;
+file_sink(
+    file&& f,
+    config const& cfg)
+    : f_(std::move(f))
+    , block_(cfg.block_size)
+    , size_(cfg.size)
+    , sync_(cfg.sync)
+    , interval_(cfg.sync_interval)
+    , direct_(cfg.direct && cfg.block_size != 0)
+{
+    if(block_ == 0)
+        return;
+    if(direct_)
+        block_ = (block_ + direct_align - 1) /
+            direct_align * direct_align;
+    storage_.reset(new char[block_ + direct_align]);
+    auto const mis = reinterpret_cast<
+        std::uintptr_t>(storage_.get()) % direct_align;
+    buf_ = storage_.get() +
+        (mis ? direct_align - mis : 0);
+}
+
+file_sink::
+file_sink(file_sink&& other) noexcept
+    : f_(std::move(other.f_))
+    , storage_(std::move(other.storage_))
+    , buf_(boost::exchange(other.buf_, nullptr))
+    , block_(other.block_)
+    , used_(boost::exchange(other.used_, 0))
+    , size_(other.size_)
+    , sync_(other.sync_)
+    , interval_(other.interval_)
+    , synced_(other.synced_)
+    , direct_(other.direct_)
+    , started_(other.started_)
+{
+}
+
+file_sink::
+~file_sink()
+{
+    // keep what arrived of an incomplete
+    // body, as writing through would
+    if(used_ != 0 && f_.is_open())
+    {
+        system::error_code ec;
+        set_direct(false);
+        write_buf(ec);
+    }
+}
 
+void
 file_sink::
-~file_sink() = default;
+flush(system::error_code& ec)
+{
+    if(used_ != 0)
+    {
+        // the offset is not aligned after
+        // writing a partial block
+        set_direct(false);
+        write_buf(ec);
+        if(ec.failed())
+            return;
+    }
+    if(sync_ != sync_mode::none)
+    {
+        f_.sync(ec);
+        if(ec.failed())
+            return;
+        synced_ = std::chrono::steady_clock::now();
+    }
+    ec = {};
+}
+
+void
+file_sink::
+flush()
+{
+    system::error_code ec;
+    flush(ec);
+    if(ec.failed())
+        detail::throw_system_error(ec);
+}
+
+void
+file_sink::
+start(system::error_code& ec)
+{
+    started_ = true;
+    synced_ = std::chrono::steady_clock::now();
+    if(size_ != 0 || direct_)
+    {
+        auto const pos = f_.pos(ec);
+        if(ec.failed())
+            return;
+        if(size_ != 0)
+        {
+            f_.allocate(pos + size_, ec);
+            if(ec.failed())
+                return;
+        }
+        set_direct(
+            direct_ && pos % direct_align == 0);
+    }
+    ec = {};
+}
+
+// Write the gathered data, keeping
+// what was not written on error
+void
+file_sink::
+write_buf(system::error_code& ec)
+{
+    auto const n = f_.write(buf_, used_, ec);
+    used_ -= n;
+    if(used_ != 0)
+        std::memmove(buf_, buf_ + n, used_);
+}
+
+void
+file_sink::
+maybe_sync(system::error_code& ec)
+{
+    if(sync_ != sync_mode::interval)
+        return;
+    auto const now = std::chrono::steady_clock::now();
+    if(now - synced_ < interval_)
+        return;
+    synced_ = now;
+    f_.sync(ec);
+}
+
+void
+file_sink::
+set_direct(bool on) noexcept
+{
+#if BOOST_HTTP_PROTO_USE_POSIX_FILE && defined(O_DIRECT)
+    if(on == direct_ && ! on)
+        return;
+    auto const fd = f_.native_handle();
+    auto const fl = ::fcntl(fd, F_GETFL);
+    // the file system may not support it,
+    // then the page cache is used
+    if(fl == -1 || ::fcntl(fd, F_SETFL, on ?
+        (fl | O_DIRECT) : (fl & ~O_DIRECT)) == -1)
+    {
+        direct_ = false;
+        return;
+    }
+    direct_ = on;
+#else
+    (void)on;
+    direct_ = false;
+#endif
+}
 
 auto
 file_sink::
@@ -32,10 +201,52 @@ on_write(
     bool more) -> results
 {
     results rv;
-    rv.bytes = f_.write(
-        b.data(), b.size(), rv.ec);
-    if(!more && !rv.ec)
-        f_.close(rv.ec);
+    if(! started_)
+    {
+        start(rv.ec);
+        if(rv.ec.failed())
+            return rv;
+    }
+    if(! buf_)
+    {
+        rv.bytes = f_.write(
+            b.data(), b.size(), rv.ec);
+        if(rv.ec.failed())
+            return rv;
+        maybe_sync(rv.ec);
+        if(rv.ec.failed())
+            return rv;
+    }
+    else
+    {
+        auto p = static_cast<
+            char const*>(b.data());
+        auto n = b.size();
+        while(n > 0)
+        {
+            auto const m = (std::min)(
+                n, block_ - used_);
+            std::memcpy(buf_ + used_, p, m);
+            used_ += m;
+            p += m;
+            n -= m;
+            rv.bytes += m;
+            if(used_ < block_)
+                break;
+            write_buf(rv.ec);
+            if(rv.ec.failed())
+                return rv;
+            maybe_sync(rv.ec);
+            if(rv.ec.failed())
+                return rv;
+        }
+    }
+    if(! more)
+    {
+        flush(rv.ec);
+        if(! rv.ec)
+            f_.close(rv.ec);
+    }
     return rv;
 }
 
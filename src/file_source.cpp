@@ -10,14 +10,42 @@
 
 #include <boost/http_proto/file_source.hpp>
 
+#include <boost/core/exchange.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+#if BOOST_HTTP_PROTO_USE_POSIX_FILE
+# include <sys/mman.h>
+# include <unistd.h>
+#endif
+
 namespace boost {
 namespace http_proto {
 
 file_source::
-~file_source() = default;
+~file_source()
+{
+#if BOOST_HTTP_PROTO_USE_POSIX_FILE
+    if(map_)
+        ::munmap(const_cast<char*>(map_), map_size_);
+#endif
+}
 
 file_source::
-file_source(file_source&&) noexcept = default;
+file_source(file_source&& other) noexcept
+    : f_(std::move(other.f_))
+    , entry_(std::move(other.entry_))
+    , shared_(other.shared_)
+    , off_(other.off_)
+    , n_(other.n_)
+    , map_(boost::exchange(other.map_, nullptr))
+    , map_size_(other.map_size_)
+    , map_pos_(other.map_pos_)
+    , released_(other.released_)
+{
+}
 
 file_source::
 file_source(
@@ -28,12 +56,76 @@ file_source(
 {
 }
 
+file_source::
+file_source(
+    file&& f,
+    std::uint64_t limit,
+    bool map) noexcept
+    : file_source(std::move(f), limit)
+{
+    if(map)
+        map_file();
+}
+
+file_source::
+file_source(
+    file& f,
+    std::uint64_t offset,
+    std::uint64_t size) noexcept
+    : shared_(&f)
+    , off_(offset)
+    , n_(size)
+{
+}
+
+file_source::
+file_source(
+    std::shared_ptr<file_cache::entry> e) noexcept
+    : file_source(e->f, 0, e->size)
+{
+    entry_ = std::move(e);
+}
+
+file_source::
+file_source(
+    std::shared_ptr<file_cache::entry> e,
+    std::uint64_t offset,
+    std::uint64_t size) noexcept
+    : file_source(e->f, offset, size)
+{
+    entry_ = std::move(e);
+}
+
 auto
 file_source::
 on_read(
     buffers::mutable_buffer b) -> results
 {
     results rv;
+    if(map_)
+    {
+        auto const n = (std::min)(
+            b.size(), map_size_ - map_pos_);
+        if(n != 0)
+            std::memcpy(b.data(), map_ + map_pos_, n);
+        map_pos_ += n;
+        rv.bytes = n;
+        rv.finished = map_pos_ == map_size_;
+        return rv;
+    }
+    if(shared_)
+    {
+        auto const n = static_cast<std::size_t>(
+            (std::min<std::uint64_t>)(n_, b.size()));
+        rv.bytes = shared_->read_at(
+            off_, b.data(), n, rv.ec);
+        off_ += rv.bytes;
+        n_ -= rv.bytes;
+        // a short read is the end of the file
+        rv.finished = !rv.ec && (
+            n_ == 0 || rv.bytes != n);
+        return rv;
+    }
     if(n_ > 0)
     {
         std::size_t n;
@@ -55,5 +147,128 @@ on_read(
     return rv;
 }
 
+auto
+file_source::
+on_read(
+    boost::span<buffers::mutable_buffer const> bs) ->
+        results
+{
+    if(! shared_)
+        return source::on_read(bs);
+
+    // read the range into the
+    // buffers with one call
+    buffers::mutable_buffer tmp[16];
+    std::size_t count = 0;
+    std::uint64_t want = 0;
+    for(auto const& b : bs)
+    {
+        if(count == 16 || want == n_)
+            break;
+        auto const n = static_cast<std::size_t>(
+            (std::min<std::uint64_t>)(n_ - want, b.size()));
+        tmp[count++] = { b.data(), n };
+        want += n;
+    }
+
+    results rv;
+    rv.bytes = shared_->read_at(off_,
+        boost::span<buffers::mutable_buffer const>(
+            tmp, count), rv.ec);
+    off_ += rv.bytes;
+    n_ -= rv.bytes;
+    rv.finished = !rv.ec && (
+        n_ == 0 || rv.bytes != want);
+    return rv;
+}
+
+bool
+file_source::
+on_can_borrow() const noexcept
+{
+    return map_ != nullptr;
+}
+
+auto
+file_source::
+on_borrow(
+    buffers::const_buffer& b) -> results
+{
+    if(! map_)
+        return source::on_borrow(b);
+
+    // lend the rest of the mapping
+    results rv;
+    b = { map_ + map_pos_, map_size_ - map_pos_ };
+    map_pos_ = map_size_;
+    rv.bytes = b.size();
+    rv.finished = true;
+    return rv;
+}
+
+void
+file_source::
+on_release(
+    std::size_t n) noexcept
+{
+#if BOOST_HTTP_PROTO_USE_POSIX_FILE
+    if(! map_)
+        return;
+
+    // drop the pages which the serializer is
+    // done with, keeping any that are shared
+    // with bytes still in use
+    auto const page = static_cast<
+        std::size_t>(::sysconf(_SC_PAGESIZE));
+    auto const first = released_ - released_ % page;
+    released_ += n;
+    auto const last = released_ - released_ % page;
+    if(first < last)
+        ::madvise(const_cast<char*>(map_) + first,
+            last - first, MADV_DONTNEED);
+#else
+    (void)n;
+#endif
+}
+
+void
+file_source::
+map_file() noexcept
+{
+#if BOOST_HTTP_PROTO_USE_POSIX_FILE
+    system::error_code ec;
+    auto const pos = f_.pos(ec);
+    if(ec)
+        return;
+    auto const size = f_.size(ec);
+    if(ec || pos >= size)
+        return;
+
+    // the mapping starts at offset zero,
+    // which is aligned to a page
+    auto const end = pos + (std::min)(n_, size - pos);
+    if(end > (std::numeric_limits<std::size_t>::max)())
+        return;
+    auto const p = ::mmap(
+        nullptr,
+        static_cast<std::size_t>(end),
+        PROT_READ,
+        MAP_SHARED,
+        f_.native_handle(),
+        0);
+    if(p == MAP_FAILED)
+        return;
+
+    // only a hint, errors are ignored
+    ::madvise(p, static_cast<std::size_t>(end),
+        MADV_SEQUENTIAL);
+
+    map_ = static_cast<char const*>(p);
+    map_size_ = static_cast<std::size_t>(end);
+    map_pos_ = static_cast<std::size_t>(pos);
+    released_ = map_pos_;
+#endif
+}
+
 } // http_proto
 } // boost
@@ -13,6 +13,7 @@
 #include <boost/http_proto/parser.hpp>
 #include <boost/http_proto/static_request.hpp>
 #include <boost/http_proto/static_response.hpp>
+#include <boost/http_proto/zstd/decompress.hpp>
 
 #include <boost/assert.hpp>
 #include <boost/buffers/circular_buffer.hpp>
@@ -30,7 +31,13 @@
 
 #include "src/detail/brotli_filter_base.hpp"
 #include "src/detail/buffer_utils.hpp"
+#include "src/detail/dictionary_service.hpp"
+#include "src/detail/field_registry.hpp"
+#include "src/detail/resource.hpp"
 #include "src/detail/zlib_filter_base.hpp"
+#include "src/detail/zstd_filter_base.hpp"
+
+#include <vector>
 
 namespace boost {
 namespace http_proto {
@@ -306,14 +313,17 @@ class zlib_filter
     : public detail::zlib_filter_base
 {
     rts::zlib::inflate_service& svc_;
+    core::string_view dict_;
 
 public:
     zlib_filter(
         const rts::context& ctx,
         http_proto::detail::workspace& ws,
-        int window_bits)
+        int window_bits,
+        core::string_view dict)
         : zlib_filter_base(ws)
         , svc_(ctx.get_service<rts::zlib::inflate_service>())
+        , dict_(dict)
     {
         system::error_code ec = static_cast<rts::zlib::error>(
             svc_.init2(strm_, window_bits));
@@ -334,17 +344,31 @@ private:
         strm_.next_in   = static_cast<unsigned char*>(const_cast<void *>(in.data()));
         strm_.avail_in  = saturate_cast(in.size());
 
+        auto const flush =
+            more ? rts::zlib::no_flush : rts::zlib::finish;
         auto rs = static_cast<rts::zlib::error>(
-            svc_.inflate(
+            svc_.inflate(strm_, flush));
+
+        // The stream names its dictionary by checksum,
+        // which zlib compares with the one provided.
+        if(rs == rts::zlib::error::need_dict && !dict_.empty())
+        {
+            rs = static_cast<rts::zlib::error>(svc_.set_dict(
                 strm_,
-                more ? rts::zlib::no_flush : rts::zlib::finish));
+                reinterpret_cast<unsigned char const*>(dict_.data()),
+                saturate_cast(dict_.size())));
+            if(rs == rts::zlib::error::ok)
+                rs = static_cast<rts::zlib::error>(
+                    svc_.inflate(strm_, flush));
+        }
 
         results rv;
         rv.out_bytes = saturate_cast(out.size()) - strm_.avail_out;
         rv.in_bytes  = saturate_cast(in.size()) - strm_.avail_in;
         rv.finished  = (rs == rts::zlib::error::stream_end);
 
-        if(rs < rts::zlib::error::ok && rs != rts::zlib::error::buf_err)
+        if((rs < rts::zlib::error::ok && rs != rts::zlib::error::buf_err) ||
+            rs == rts::zlib::error::need_dict)
             rv.ec = rs;
 
         return rv;
@@ -360,14 +384,27 @@ class brotli_filter
 public:
     brotli_filter(
         const rts::context& ctx,
-        http_proto::detail::workspace&)
+        http_proto::detail::workspace&,
+        memory_resource* mr,
+        core::string_view dict)
         : svc_(ctx.get_service<rts::brotli::decode_service>())
     {
-        // TODO: use custom allocator
-        state_ = svc_.create_instance(nullptr, nullptr, nullptr);
+        state_ = mr
+            ? svc_.create_instance(&detail::c_alloc, &detail::c_free, mr)
+            : svc_.create_instance(nullptr, nullptr, nullptr);
 
         if(!state_)
             detail::throw_bad_alloc();
+
+        if(!dict.empty() && !svc_.attach_dictionary(
+            state_,
+            rts::brotli::shared_dictionary_type::raw,
+            dict.size(),
+            reinterpret_cast<std::uint8_t const*>(dict.data())))
+        {
+            svc_.destroy_instance(state_);
+            detail::throw_bad_alloc();
+        }
     }
 
     ~brotli_filter()
@@ -412,16 +449,96 @@ private:
     }
 };
 
+class zstd_filter
+    : public detail::zstd_filter_base
+{
+    zstd::decompress_service& svc_;
+    zstd::dstream* ds_;
+    bool frame_end_ = false;
+
+public:
+    zstd_filter(
+        const rts::context& ctx,
+        http_proto::detail::workspace& ws,
+        int window_log_max,
+        zstd::ddict const* dict)
+        : svc_(ctx.get_service<zstd::decompress_service>())
+    {
+        auto const n = svc_.space_needed(window_log_max);
+        ds_ = svc_.init_static(
+            reserve(ws, n), n, window_log_max);
+        if(!ds_)
+            detail::throw_invalid_argument();
+        if(dict && !svc_.ref_dictionary(*ds_, dict))
+            detail::throw_invalid_argument();
+    }
+
+private:
+    virtual
+    results
+    do_process(
+        buffers::mutable_buffer out,
+        buffers::const_buffer in,
+        bool more) noexcept override
+    {
+        results rv;
+
+        // The body may hold several frames,
+        // it ends with the input after a frame.
+        if(frame_end_ && in.size() == 0)
+        {
+            rv.finished = !more;
+            return rv;
+        }
+
+        auto ob = make_out_buffer(out);
+        auto ib = make_in_buffer(in);
+
+        auto const rs = svc_.decompress_stream(
+            *ds_, ob, ib, rv.ec);
+        rv.out_bytes = ob.pos;
+        rv.in_bytes  = ib.pos;
+        if(rv.ec.failed())
+            return rv;
+
+        if(rs == 0)
+            frame_end_ = true;
+        else if(ib.pos != 0)
+            frame_end_ = false;
+
+        rv.finished = !more && frame_end_ &&
+            ib.pos == ib.size;
+
+        if(!more && !rv.finished &&
+            ib.pos == ib.size && ob.pos < ob.size)
+            rv.ec = BOOST_HTTP_PROTO_ERR(error::bad_payload);
+
+        return rv;
+    }
+};
+
 class parser_service
     : public rts::service
 {
+    zstd::decompress_service* zstd_ = nullptr;
+
 public:
+    // A shared dictionary, digested
+    // for the configured decoders.
+    struct dictionary
+    {
+        std::uint32_t id;
+        core::string_view data;
+        zstd::ddict* zstd = nullptr;
+    };
+
     parser::config_base cfg;
     std::size_t space_needed = 0;
     std::size_t max_codec = 0;
+    std::vector<dictionary> dictionaries;
 
     parser_service(
-        const rts::context&,
+        const rts::context& ctx,
         parser::config_base const& cfg_)
         : cfg(cfg_)
     {
@@ -483,6 +600,24 @@ public:
             if(max_codec < n)
                 max_codec = n;
         }
+
+        if(cfg.apply_zstd_decoder)
+        {
+            // zstd windows range from 1KB to 2GB
+            if(cfg.zstd_window_log_max < 10 ||
+                cfg.zstd_window_log_max > 31)
+                detail::throw_invalid_argument();
+
+            std::size_t n =
+                detail::zstd_filter_base::space_needed(
+                    ctx.get_service<zstd::decompress_service>()
+                        .space_needed(cfg.zstd_window_log_max)) +
+                detail::workspace::space_needed<
+                    zstd_filter>();
+
+            if(max_codec < n)
+                max_codec = n;
+        }
         space_needed += max_codec;
 
         // round up to alignof(detail::header::entry)
@@ -490,6 +625,43 @@ public:
             detail::header::entry);
         space_needed = al * ((
             space_needed + al - 1) / al);
+
+        auto const* dicts = detail::dictionary_service::find(ctx);
+        if(dicts)
+        {
+            if(cfg.apply_zstd_decoder)
+                zstd_ = &ctx.get_service<
+                    zstd::decompress_service>();
+
+            dictionaries.reserve(dicts->size());
+            try
+            {
+                for(auto const& e : *dicts)
+                    add_dictionary(e.id, e.data);
+            }
+            catch(...)
+            {
+                free_dictionaries();
+                throw;
+            }
+        }
+    }
+
+    ~parser_service()
+    {
+        free_dictionaries();
+    }
+
+    dictionary const*
+    find_dictionary(
+        std::uint32_t id) const noexcept
+    {
+        for(auto const& d : dictionaries)
+        {
+            if(d.id == id)
+                return &d;
+        }
+        return nullptr;
     }
 
     std::size_t
@@ -499,6 +671,37 @@ public:
             cfg.headers.max_size +
             cfg.min_buffer;
     }
+
+private:
+    void
+    free_dictionaries() noexcept
+    {
+        for(auto& d : dictionaries)
+        {
+            if(d.zstd)
+                zstd_->free_dictionary(d.zstd);
+        }
+        dictionaries.clear();
+    }
+
+    void
+    add_dictionary(
+        std::uint32_t id,
+        core::string_view data)
+    {
+        dictionaries.emplace_back();
+        auto& d = dictionaries.back();
+        d.id = id;
+        d.data = data;
+
+        if(zstd_)
+        {
+            d.zstd = zstd_->create_dictionary(
+                data.data(), data.size());
+            if(! d.zstd)
+                detail::throw_bad_alloc();
+        }
+    }
 };
 
 } // namespace
@@ -538,8 +741,10 @@ class parser::impl
 
     const rts::context& ctx_;
     parser_service& svc_;
+    detail::field_registry const* fields_;
 
     detail::workspace ws_;
+    bool owns_storage_;
     static_request m_;
     std::uint64_t body_limit_;
     std::uint64_t body_total_;
@@ -558,6 +763,7 @@ class parser::impl
     detail::filter* filter_;
     buffers::any_dynamic_buffer* eb_;
     sink* sink_;
+    parser_service::dictionary const* dict_;
 
     state state_;
     style style_;
@@ -568,11 +774,19 @@ class parser::impl
     bool trailer_headers_;
     bool chunked_body_ended;
 
-public:
-    impl(const rts::context& ctx, detail::kind k)
+    impl(
+        const rts::context& ctx,
+        parser_service& svc,
+        detail::kind k,
+        bool owns_storage)
         : ctx_(ctx)
-        , svc_(ctx.get_service<parser_service>())
-        , ws_(svc_.space_needed)
+        , svc_(svc)
+        , fields_(detail::field_registry::find(ctx))
+        , ws_(
+            reinterpret_cast<unsigned char*>(this) +
+                detail::workspace::aligned_size(sizeof(impl)),
+            svc_.space_needed)
+        , owns_storage_(owns_storage)
         , m_(ws_.data(), ws_.size())
         , state_(state::reset)
         , got_header_(false)
@@ -580,6 +794,59 @@ public:
         m_.h_ = detail::header(detail::empty{ k });
     }
 
+public:
+    // The impl and its workspace buffer share
+    // one block of storage: | impl | buffer |
+
+    static
+    std::size_t
+    storage_needed(
+        parser_service const& svc) noexcept
+    {
+        return
+            detail::workspace::aligned_size(sizeof(impl)) +
+            detail::workspace::aligned_size(svc.space_needed);
+    }
+
+    static
+    impl*
+    construct(
+        const rts::context& ctx,
+        detail::kind k,
+        void* storage)
+    {
+        auto& svc = ctx.get_service<parser_service>();
+        bool const owns_storage = storage == nullptr;
+        if(owns_storage)
+            storage = detail::allocate(
+                svc.cfg.resource, storage_needed(svc));
+        try
+        {
+            return ::new(storage) impl(ctx, svc, k, owns_storage);
+        }
+        catch(...)
+        {
+            if(owns_storage)
+                detail::deallocate(svc.cfg.resource,
+                    storage, storage_needed(svc));
+            throw;
+        }
+    }
+
+    static
+    void
+    destroy(impl* p) noexcept
+    {
+        if(! p)
+            return;
+        auto const& svc = p->svc_;
+        bool const owns_storage = p->owns_storage_;
+        p->~impl();
+        if(owns_storage)
+            detail::deallocate(svc.cfg.resource,
+                p, storage_needed(svc));
+    }
+
     bool
     got_header() const noexcept
     {
@@ -746,6 +1013,7 @@ public:
         filter_ = nullptr;
         eb_ = nullptr;
         sink_ = nullptr;
+        dict_ = nullptr;
 
         got_header_ = false;
         head_response_ = head_response;
@@ -1069,7 +1337,8 @@ public:
             BOOST_ASSERT(m_.h_.cbuf == static_cast<
                 void const*>(ws_.data()));
 
-            m_.h_.parse(fb_.size(), svc_.cfg.headers, ec);
+            m_.h_.parse(
+                fb_.size(), svc_.cfg.headers, ec, fields_);
 
             if(ec == condition::need_more_input)
             {
@@ -1161,21 +1430,33 @@ public:
                 if(!svc_.cfg.apply_deflate_decoder)
                     goto no_filter;
                 filter_ = &ws_.emplace<zlib_filter>(
-                    ctx_, ws_, svc_.cfg.zlib_window_bits);
+                    ctx_, ws_, svc_.cfg.zlib_window_bits,
+                    dict_ ? dict_->data : core::string_view());
                 break;
 
             case content_coding::gzip:
                 if(!svc_.cfg.apply_gzip_decoder)
                     goto no_filter;
+                // the gzip format cannot signal a dictionary
                 filter_ = &ws_.emplace<zlib_filter>(
-                    ctx_, ws_, svc_.cfg.zlib_window_bits + 16);
+                    ctx_, ws_, svc_.cfg.zlib_window_bits + 16,
+                    core::string_view());
                 break;
 
             case content_coding::br:
                 if(!svc_.cfg.apply_brotli_decoder)
                     goto no_filter;
                 filter_ = &ws_.emplace<brotli_filter>(
-                    ctx_, ws_);
+                    ctx_, ws_, svc_.cfg.resource,
+                    dict_ ? dict_->data : core::string_view());
+                break;
+
+            case content_coding::zstd:
+                if(!svc_.cfg.apply_zstd_decoder)
+                    goto no_filter;
+                filter_ = &ws_.emplace<zstd_filter>(
+                    ctx_, ws_, svc_.cfg.zstd_window_log_max,
+                    dict_ ? dict_->zstd : nullptr);
                 break;
 
             no_filter:
@@ -1675,6 +1956,20 @@ public:
         }
     }
 
+    void
+    set_dictionary(std::uint32_t id)
+    {
+        // set the dictionary before parsing the body
+        if(state_ != state::header &&
+            state_ != state::header_done)
+            detail::throw_logic_error();
+
+        auto const* d = svc_.find_dictionary(id);
+        if(! d)
+            detail::throw_invalid_argument();
+        dict_ = d;
+    }
+
     void
     set_body(
         buffers::any_dynamic_buffer& eb) noexcept
@@ -1716,6 +2011,23 @@ private:
         return body_limit_ - body_total_;
     }
 
+    // Return the output size to request for
+    // decoding n bytes of payload in one call.
+    std::size_t
+    one_shot_size(std::size_t n) const noexcept
+    {
+        // text bodies typically shrink by a
+        // factor of four or more when coded
+        std::size_t const ratio = 4;
+        std::size_t const max = (std::numeric_limits<
+            std::size_t>::max)();
+        if(n > max / ratio)
+            return max;
+        if(n * ratio < svc_.cfg.min_buffer)
+            return svc_.cfg.min_buffer;
+        return n * ratio;
+    }
+
     std::size_t
     apply_filter(
         system::error_code& ec,
@@ -1733,15 +2045,26 @@ private:
                 if(style_ == style::elastic)
                 {
                     std::size_t n = clamp(body_limit_remain());
-                    n = clamp(n, svc_.cfg.min_buffer);
                     n = clamp(n, eb_->max_size() - eb_->size());
 
-                    // fill capacity first to avoid
-                    // an allocation
-                    std::size_t avail = 
+                    // With the whole payload at hand, decode
+                    // it in one call if the capacity allows.
+                    std::size_t avail =
                         eb_->capacity() - eb_->size();
-                    if(avail != 0)
-                        n = clamp(n, avail);
+                    if(!more &&
+                        avail >= one_shot_size(payload_avail))
+                    {
+                        n = clamp(n, one_shot_size(payload_avail));
+                    }
+                    else
+                    {
+                        n = clamp(n, svc_.cfg.min_buffer);
+
+                        // fill capacity first to avoid
+                        // an allocation
+                        if(avail != 0)
+                            n = clamp(n, avail);
+                    }
 
                     return filter_->process(
                         eb_->prepare(n),
@@ -1848,11 +2171,12 @@ private:
 //------------------------------------------------
 
 parser::
-parser(const rts::context& ctx, detail::kind k)
-    : impl_(new impl(ctx, k))
+parser(
+    const rts::context& ctx,
+    detail::kind k,
+    void* storage)
+    : impl_(impl::construct(ctx, k, storage))
 {
-    // TODO: use a single allocation for
-    // impl and workspace buffer.
 }
 
 parser::
@@ -1865,7 +2189,16 @@ parser(parser&& other) noexcept
 parser::
 ~parser()
 {
-    delete impl_;
+    impl::destroy(impl_);
+}
+
+std::size_t
+parser::
+storage_needed(
+    const rts::context& ctx)
+{
+    return impl::storage_needed(
+        ctx.get_service<parser_service>());
 }
 
 //--------------------------------------------
@@ -1985,6 +2318,14 @@ set_body_limit(std::uint64_t n)
     impl_->set_body_limit(n);
 }
 
+void
+parser::
+set_dictionary(std::uint32_t id)
+{
+    BOOST_ASSERT(impl_);
+    impl_->set_dictionary(id);
+}
+
 //------------------------------------------------
 //
 // Implementation
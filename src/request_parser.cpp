@@ -21,6 +21,17 @@ request_parser(
 {
 }
 
+request_parser::
+request_parser(
+    const rts::context& ctx,
+    void* storage)
+    : parser(
+        ctx,
+        detail::kind::request,
+        storage)
+{
+}
+
 static_request const&
 request_parser::
 get() const
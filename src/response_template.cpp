@@ -0,0 +1,188 @@
+//
+// Copyright (c) 2025 Mohammad Nejati
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#include <boost/http_proto/response_template.hpp>
+#include <boost/http_proto/detail/except.hpp>
+#include "detail/number_string.hpp"
+
+#include <boost/url/grammar/ci_string.hpp>
+
+#include <cstring>
+
+namespace boost {
+namespace http_proto {
+
+response_template::
+response_template(
+    response_base const& res)
+    : res_(res)
+{
+}
+
+std::size_t
+response_template::
+add_slot(
+    field id,
+    std::size_t width)
+{
+    return add_slot_impl(
+        id, to_string(id), width);
+}
+
+std::size_t
+response_template::
+add_slot(
+    core::string_view name,
+    std::size_t width)
+{
+    auto const id = string_to_field(name);
+    if(id)
+        return add_slot(*id, width);
+    return add_slot_impl(
+        detail::header::unknown_field,
+        name,
+        width);
+}
+
+void
+response_template::
+set(
+    std::size_t slot,
+    core::string_view value)
+{
+    if(slot >= slots_.size())
+        detail::throw_out_of_range();
+
+    auto const& s = slots_[slot];
+    if(value.size() > s.width)
+        detail::throw_length_error();
+
+    // field-value = *( field-vchar / SP / HTAB ),
+    // without leading or trailing whitespace
+    for(char c : value)
+    {
+        auto const u = static_cast<unsigned char>(c);
+        if((u < 0x20 && c != '\t') || u == 0x7f)
+            detail::throw_invalid_argument();
+    }
+    if(! value.empty() && (
+        value.front() == ' ' || value.front() == '\t' ||
+        value.back() == ' ' || value.back() == '\t'))
+        detail::throw_invalid_argument();
+
+    auto& h = res_.h_;
+    auto& e = h.tab()[s.index];
+    auto const id = e.id;
+    // hide the entry from the metadata
+    e.id = detail::header::unknown_field;
+    h.on_erase(id, e.flags);
+
+    // the padding is trailing OWS
+    char* p = h.buf + h.prefix + e.vp;
+    std::memcpy(p, value.data(), value.size());
+    std::memset(p + value.size(), ' ',
+        s.width - value.size());
+    e.vn = static_cast<
+        detail::header::offset_type>(value.size());
+
+    e.id = id;
+    e.flags = h.on_insert(id, value);
+}
+
+void
+response_template::
+set_content_length(
+    std::uint64_t n)
+{
+    for(std::size_t i = 0; i < slots_.size(); ++i)
+    {
+        if(slots_[i].id == field::content_length)
+            return set(i, detail::number_string(n));
+    }
+    detail::throw_logic_error();
+}
+
+void
+response_template::
+set_date()
+{
+    for(std::size_t i = 0; i < slots_.size(); ++i)
+    {
+        if(slots_[i].id == field::date)
+            return set(i, current_date());
+    }
+    detail::throw_logic_error();
+}
+
+//------------------------------------------------
+
+std::size_t
+response_template::
+add_slot_impl(
+    field id,
+    core::string_view name,
+    std::size_t width)
+{
+    if(width == 0)
+        detail::throw_invalid_argument();
+
+    for(auto const& s : slots_)
+    {
+        if(grammar::ci_is_equal(s.name, name))
+            detail::throw_invalid_argument();
+    }
+
+    std::string init;
+    auto const it = res_.find(name);
+    if(it != res_.end())
+        init.assign(
+            it->value.data(),
+            it->value.size());
+    if(init.size() > width)
+        detail::throw_length_error();
+
+    slot_t s;
+    s.width = width;
+    s.id = id;
+    s.name.assign(name.data(), name.size());
+    slots_.reserve(slots_.size() + 1);
+
+    // Replace the fields with one holding the
+    // placeholder, then patch in the value.
+    std::string const ph(width, 'x');
+    if(id != detail::header::unknown_field)
+        res_.set(id, ph);
+    else
+        res_.set(name, ph);
+
+    slots_.push_back(std::move(s));
+    reindex();
+    set(slots_.size() - 1, init);
+    return slots_.size() - 1;
+}
+
+// Setting a field moves the ones after it,
+// so the indices of every slot are refreshed.
+void
+response_template::
+reindex() noexcept
+{
+    auto const& h = res_.h_;
+    for(auto& s : slots_)
+    {
+        if(s.id != detail::header::unknown_field)
+            s.index = h.find(s.id);
+        else
+            s.index = h.find(s.name);
+        BOOST_ASSERT(s.index < h.count);
+    }
+}
+
+} // http_proto
+} // boost
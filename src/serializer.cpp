@@ -13,11 +13,18 @@
 #include <boost/http_proto/detail/header.hpp>
 #include <boost/http_proto/message_base.hpp>
 #include <boost/http_proto/serializer.hpp>
+#include <boost/http_proto/zstd/compress.hpp>
 
 #include "src/detail/array_of_const_buffers.hpp"
 #include "src/detail/brotli_filter_base.hpp"
 #include "src/detail/buffer_utils.hpp"
+#include "src/detail/compression_budget.hpp"
+#include "src/detail/dictionary_service.hpp"
+#include "src/detail/parallel_deflate.hpp"
+#include "src/detail/resource.hpp"
+#include "src/detail/thread_pool.hpp"
 #include "src/detail/zlib_filter_base.hpp"
+#include "src/detail/zstd_filter_base.hpp"
 
 #include <boost/buffers/circular_buffer.hpp>
 #include <boost/buffers/copy.hpp>
@@ -30,7 +37,13 @@
 #include <boost/rts/zlib/deflate.hpp>
 #include <boost/rts/zlib/error.hpp>
 #include <boost/rts/zlib/flush.hpp>
+#include <boost/url/grammar/ci_string.hpp>
 
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <memory>
+#include <vector>
 #include <stddef.h>
 
 namespace boost {
@@ -91,6 +104,7 @@ class zlib_filter
     : public detail::zlib_filter_base
 {
     rts::zlib::deflate_service& svc_;
+    bool flush_first_;
 
 public:
     zlib_filter(
@@ -98,9 +112,12 @@ public:
         http_proto::detail::workspace& ws,
         int comp_level,
         int window_bits,
-        int mem_level)
+        int mem_level,
+        bool flush_first,
+        core::string_view dict)
         : zlib_filter_base(ws)
         , svc_(ctx.get_service<rts::zlib::deflate_service>())
+        , flush_first_(flush_first)
     {
         system::error_code ec = static_cast<rts::zlib::error>(svc_.init2(
             strm_,
@@ -111,6 +128,15 @@ public:
             rts::zlib::default_strategy));
         if(ec != rts::zlib::error::ok)
             detail::throw_system_error(ec);
+
+        if(dict.empty())
+            return;
+        ec = static_cast<rts::zlib::error>(svc_.set_dict(
+            strm_,
+            reinterpret_cast<unsigned char const*>(dict.data()),
+            saturate_cast(dict.size())));
+        if(ec != rts::zlib::error::ok)
+            detail::throw_system_error(ec);
     }
 
 private:
@@ -135,10 +161,15 @@ private:
         strm_.next_in   = static_cast<unsigned char*>(const_cast<void *>(in.data()));
         strm_.avail_in  = saturate_cast(in.size());
 
+        // The first block is flushed on request so
+        // that its compressed size can be measured.
+        auto flush = more ? rts::zlib::no_flush : rts::zlib::finish;
+        if(flush_first_ && more)
+            flush = rts::zlib::sync_flush;
+        flush_first_ = false;
+
         auto rs = static_cast<rts::zlib::error>(
-            svc_.deflate(
-                strm_,
-                more ? rts::zlib::no_flush : rts::zlib::finish));
+            svc_.deflate(strm_, flush));
 
         results rv;
         rv.out_bytes = saturate_cast(out.size()) - strm_.avail_out;
@@ -157,22 +188,33 @@ class brotli_filter
 {
     rts::brotli::encode_service& svc_;
     rts::brotli::encoder_state* state_;
+    bool flush_first_;
 
 public:
     brotli_filter(
         const rts::context& ctx,
         http_proto::detail::workspace&,
+        memory_resource* mr,
         std::uint32_t comp_quality,
-        std::uint32_t comp_window)
+        std::uint32_t comp_window,
+        bool flush_first,
+        rts::brotli::encoder_prepared_dictionary const* dict)
         : svc_(ctx.get_service<rts::brotli::encode_service>())
+        , flush_first_(flush_first)
     {
-        // TODO: use custom allocator
-        state_ = svc_.create_instance(nullptr, nullptr, nullptr);
+        state_ = mr
+            ? svc_.create_instance(&detail::c_alloc, &detail::c_free, mr)
+            : svc_.create_instance(nullptr, nullptr, nullptr);
         if(!state_)
             detail::throw_bad_alloc();
         using encoder_parameter = rts::brotli::encoder_parameter;
         svc_.set_parameter(state_, encoder_parameter::quality, comp_quality);
         svc_.set_parameter(state_, encoder_parameter::lgwin, comp_window);
+        if(dict && !svc_.attach_prepared_dictionary(state_, dict))
+        {
+            svc_.destroy_instance(state_);
+            detail::throw_bad_alloc();
+        }
     }
 
     ~brotli_filter()
@@ -196,9 +238,14 @@ private:
         using encoder_operation = 
             rts::brotli::encoder_operation;
 
+        auto op = more ? encoder_operation::process : encoder_operation::finish;
+        if(flush_first_ && more)
+            op = encoder_operation::flush;
+        flush_first_ = false;
+
         bool rs = svc_.compress_stream(
             state_,
-            more ? encoder_operation::process : encoder_operation::finish,
+            op,
             &available_in,
             &next_in,
             &available_out,
@@ -218,6 +265,102 @@ private:
     }
 };
 
+class zstd_filter
+    : public detail::zstd_filter_base
+{
+    zstd::compress_service& svc_;
+    zstd::cstream* cs_;
+    bool flush_first_;
+
+public:
+    zstd_filter(
+        const rts::context& ctx,
+        http_proto::detail::workspace& ws,
+        int comp_level,
+        int window_log,
+        bool flush_first,
+        zstd::cdict const* dict)
+        : svc_(ctx.get_service<zstd::compress_service>())
+        , flush_first_(flush_first)
+    {
+        auto const n = svc_.space_needed(comp_level, window_log);
+        cs_ = svc_.init_static(
+            reserve(ws, n), n, comp_level, window_log);
+        if(!cs_)
+            detail::throw_invalid_argument();
+        if(dict && !svc_.ref_dictionary(*cs_, dict))
+            detail::throw_invalid_argument();
+    }
+
+private:
+    virtual
+    results
+    do_process(
+        buffers::mutable_buffer out,
+        buffers::const_buffer in,
+        bool more) noexcept override
+    {
+        auto ob = make_out_buffer(out);
+        auto ib = make_in_buffer(in);
+
+        auto directive = more
+            ? zstd::end_directive::continue_
+            : zstd::end_directive::end;
+        if(flush_first_ && more)
+            directive = zstd::end_directive::flush;
+        flush_first_ = false;
+
+        results rv;
+        auto const remain = svc_.compress_stream(
+            *cs_, ob, ib, directive, rv.ec);
+        rv.out_bytes = ob.pos;
+        rv.in_bytes  = ib.pos;
+        rv.finished  = !more && !rv.ec.failed() &&
+            remain == 0 && ib.pos == ib.size;
+        return rv;
+    }
+};
+
+// Passes the body through unchanged, used
+// when compression is abandoned by the probe.
+class identity_filter
+    : public detail::filter
+{
+    virtual
+    results
+    do_process(
+        buffers::mutable_buffer out,
+        buffers::const_buffer in,
+        bool more) noexcept override
+    {
+        results rv;
+        rv.in_bytes  = buffers::copy(out, in);
+        rv.out_bytes = rv.in_bytes;
+        rv.finished  = !more && rv.in_bytes == in.size();
+        return rv;
+    }
+};
+
+// Return true if the media type matches the
+// pattern, which is either a full media type
+// or a type followed by "/*".
+bool
+match_media_type(
+    core::string_view pattern,
+    core::string_view type) noexcept
+{
+    if(pattern.ends_with("/*"))
+    {
+        pattern.remove_suffix(1);
+        return
+            type.size() > pattern.size() &&
+            grammar::ci_is_equal(
+                type.substr(0, pattern.size()),
+                pattern);
+    }
+    return grammar::ci_is_equal(type, pattern);
+}
+
 template<class UInt>
 std::size_t
 clamp(
@@ -230,17 +373,43 @@ clamp(
     return static_cast<std::size_t>(x);
 }
 
+// Return an upper bound on the size of n bytes
+// after deflate, gzip or brotli coding, including
+// the stream framing, for any supported settings.
+std::uint64_t
+max_coded_size(std::uint64_t n) noexcept
+{
+    return n + (n >> 3) + (n >> 6) + 64;
+}
+
 class serializer_service
     : public rts::service
 {
+    rts::brotli::encode_service* brotli_ = nullptr;
+    zstd::compress_service* zstd_ = nullptr;
+
 public:
+    // A shared dictionary, digested
+    // for the configured encoders.
+    struct dictionary
+    {
+        std::uint32_t id;
+        core::string_view data;
+        rts::brotli::encoder_prepared_dictionary* brotli = nullptr;
+        zstd::cdict* zstd = nullptr;
+    };
+
     serializer::config cfg;
+    detail::compression_budget budget;
     std::size_t space_needed = 0;
+    std::unique_ptr<detail::thread_pool> pool;
+    std::vector<dictionary> dictionaries;
 
     serializer_service(
-        const rts::context&,
+        const rts::context& ctx,
         serializer::config const& cfg_)
         : cfg(cfg_)
+        , budget(cfg.compression_time_budget)
     {
         space_needed += cfg.payload_buffer;
         space_needed += cfg.max_type_erase;
@@ -259,7 +428,152 @@ public:
                 5768 +
                 #endif
                 detail::workspace::space_needed<zlib_filter>();
+
+            if(cfg.parallel_compression_threads != 0)
+            {
+                if(cfg.parallel_compression_block_size == 0)
+                    detail::throw_invalid_argument();
+                pool.reset(new detail::thread_pool(
+                    cfg.parallel_compression_threads));
+            }
         }
+
+        auto const* dicts = detail::dictionary_service::find(ctx);
+
+        if(cfg.apply_zstd_encoder)
+        {
+            // RFC 9659 limits the window to 8MB
+            if(cfg.zstd_window_log != 0 &&
+                (cfg.zstd_window_log < 10 ||
+                cfg.zstd_window_log > 23))
+                detail::throw_invalid_argument();
+
+            // Levels lowered by the time budget
+            // may use different parameters.
+            auto const& zsvc =
+                ctx.get_service<zstd::compress_service>();
+            std::size_t n = 0;
+            for(int drop = 0; drop <=
+                detail::compression_budget::max_level_drop; ++drop)
+            {
+                auto const level = zstd_level(
+                    cfg.zstd_comp_level, drop);
+                n = (std::max)(n, zsvc.space_needed(
+                    level, cfg.zstd_window_log));
+            }
+
+            // A dictionary brings the parameters
+            // of the level with the default window.
+            if(dicts)
+                n = (std::max)(n, zsvc.space_needed(
+                    cfg.zstd_comp_level, 0));
+
+            space_needed +=
+                detail::zstd_filter_base::space_needed(n) +
+                detail::workspace::space_needed<zstd_filter>();
+        }
+
+        if(dicts)
+        {
+            if(cfg.apply_brotli_encoder)
+                brotli_ = &ctx.get_service<
+                    rts::brotli::encode_service>();
+            if(cfg.apply_zstd_encoder)
+                zstd_ = &ctx.get_service<
+                    zstd::compress_service>();
+
+            dictionaries.reserve(dicts->size());
+            try
+            {
+                for(auto const& e : *dicts)
+                    add_dictionary(e.id, e.data);
+            }
+            catch(...)
+            {
+                free_dictionaries();
+                throw;
+            }
+        }
+    }
+
+    ~serializer_service()
+    {
+        free_dictionaries();
+    }
+
+    dictionary const*
+    find_dictionary(
+        std::uint32_t id) const noexcept
+    {
+        for(auto const& d : dictionaries)
+        {
+            if(d.id == id)
+                return &d;
+        }
+        return nullptr;
+    }
+
+private:
+    void
+    free_dictionaries() noexcept
+    {
+        for(auto& d : dictionaries)
+        {
+            if(d.brotli)
+                brotli_->destroy_prepared_dictionary(d.brotli);
+            if(d.zstd)
+                zstd_->free_dictionary(d.zstd);
+        }
+        dictionaries.clear();
+    }
+
+    void
+    add_dictionary(
+        std::uint32_t id,
+        core::string_view data)
+    {
+        dictionaries.emplace_back();
+        auto& d = dictionaries.back();
+        d.id = id;
+        d.data = data;
+
+        if(brotli_)
+        {
+            d.brotli = brotli_->prepare_dictionary(
+                rts::brotli::shared_dictionary_type::raw,
+                data.size(),
+                reinterpret_cast<std::uint8_t const*>(data.data()),
+                static_cast<int>(cfg.brotli_comp_quality),
+                nullptr,
+                nullptr,
+                nullptr);
+            if(! d.brotli)
+                detail::throw_bad_alloc();
+        }
+
+        if(zstd_)
+        {
+            d.zstd = zstd_->create_dictionary(
+                data.data(),
+                data.size(),
+                cfg.zstd_comp_level);
+            if(! d.zstd)
+                detail::throw_bad_alloc();
+        }
+    }
+
+public:
+    // Return the zstd level after lowering
+    // it by the given number of steps.
+    static
+    int
+    zstd_level(
+        int level,
+        int drop) noexcept
+    {
+        if(level - drop < 1)
+            return (level < 1) ? level : 1;
+        return level - drop;
     }
 };
 
@@ -300,15 +614,21 @@ class serializer::impl
     const rts::context& ctx_;
     serializer_service& svc_;
     detail::workspace ws_;
+    bool owns_storage_;
 
+    identity_filter identity_;
     detail::filter* filter_ = nullptr;
     cbs_gen* cbs_gen_ = nullptr;
     source* source_ = nullptr;
+    detail::header const* h_ = nullptr;
+    serializer_service::dictionary const* dict_ = nullptr;
 
     buffers::circular_buffer out_;
     buffers::circular_buffer in_;
     detail::array_of_const_buffers prepped_;
     buffers::const_buffer tmp_;
+    buffers::const_buffer header_;
+    std::size_t lent_ = 0;
 
     state state_ = state::start;
     style style_ = style::empty;
@@ -317,20 +637,95 @@ class serializer::impl
     bool is_chunked_ = false;
     bool needs_exp100_continue_ = false;
     bool filter_done_ = false;
+    bool probe_ = false;
+    bool borrow_ = false;
 
-public:
-    impl(const rts::context& ctx)
+    impl(
+        const rts::context& ctx,
+        serializer_service& svc,
+        bool owns_storage)
         : ctx_(ctx)
-        , svc_(ctx_.get_service<serializer_service>())
-        , ws_(svc_.space_needed)
+        , svc_(svc)
+        , ws_(
+            reinterpret_cast<unsigned char*>(this) +
+                detail::workspace::aligned_size(sizeof(impl)),
+            svc_.space_needed)
+        , owns_storage_(owns_storage)
     {
     }
 
+public:
+    // The impl and its workspace buffer share
+    // one block of storage: | impl | buffer |
+
+    static
+    std::size_t
+    storage_needed(
+        serializer_service const& svc) noexcept
+    {
+        return
+            detail::workspace::aligned_size(sizeof(impl)) +
+            detail::workspace::aligned_size(svc.space_needed);
+    }
+
+    static
+    impl*
+    construct(
+        const rts::context& ctx,
+        void* storage)
+    {
+        auto& svc = ctx.get_service<serializer_service>();
+        bool const owns_storage = storage == nullptr;
+        if(owns_storage)
+            storage = detail::allocate(
+                svc.cfg.resource, storage_needed(svc));
+        try
+        {
+            return ::new(storage) impl(ctx, svc, owns_storage);
+        }
+        catch(...)
+        {
+            if(owns_storage)
+                detail::deallocate(svc.cfg.resource,
+                    storage, storage_needed(svc));
+            throw;
+        }
+    }
+
+    static
+    void
+    destroy(impl* p) noexcept
+    {
+        if(! p)
+            return;
+        auto const& svc = p->svc_;
+        bool const owns_storage = p->owns_storage_;
+        p->~impl();
+        if(owns_storage)
+            detail::deallocate(svc.cfg.resource,
+                p, storage_needed(svc));
+    }
+
     void
     reset() noexcept
     {
         ws_.clear();
         state_ = state::start;
+        dict_ = nullptr;
+    }
+
+    void
+    set_dictionary(
+        std::uint32_t id)
+    {
+        // Precondition violation
+        if(state_ != state::start)
+            detail::throw_logic_error();
+
+        auto const* d = svc_.find_dictionary(id);
+        if(!d)
+            detail::throw_invalid_argument();
+        dict_ = d;
     }
 
     auto
@@ -398,6 +793,44 @@ public:
 
             case style::source:
             {
+                if(borrow_)
+                {
+                    // add more buffers if prepped_ is half empty.
+                    if(more_input_ &&
+                        prepped_.capacity() >= prepped_.size())
+                    {
+                        prepped_.slide_to_front();
+                        while(more_input_ &&
+                            prepped_.capacity() != 0)
+                        {
+                            buffers::const_buffer buf;
+                            const auto rs = source_->borrow(buf);
+                            if(rs.ec.failed())
+                            {
+                                ws_.clear();
+                                state_ = state::reset;
+                                return rs.ec;
+                            }
+                            if(rs.finished)
+                                more_input_ = false;
+                            else if(buf.size() == 0)
+                            {
+                                // source must lend some
+                                // bytes if it is not finished
+                                ws_.clear();
+                                state_ = state::reset;
+                                detail::throw_logic_error();
+                            }
+                            if(buf.size() != 0)
+                            {
+                                prepped_.append(buf);
+                                lent_ += buf.size();
+                            }
+                        }
+                    }
+                    return detail::make_span(prepped_);
+                }
+
                 if(out_capacity() == 0 || !more_input_)
                     break;
 
@@ -431,6 +864,23 @@ public:
         }
         else // filter
         {
+            if(probe_)
+            {
+                // the sample of a stream is its first write
+                if(style_ == style::stream &&
+                    in_.size() == 0 && more_input_)
+                    BOOST_HTTP_PROTO_RETURN_EC(
+                        error::need_data);
+
+                auto ec = probe_filter();
+                if(ec.failed())
+                {
+                    ws_.clear();
+                    state_ = state::reset;
+                    return ec;
+                }
+            }
+
             switch(style_)
             {
             case style::empty:
@@ -438,8 +888,8 @@ public:
                 if(out_capacity() == 0 || filter_done_)
                     break;
 
-                const auto rs = filter_->process(
-                    detail::make_span(out_prepare()),
+                const auto rs = process_filter(
+                    out_prepare(),
                     {}, // empty input
                     false);
 
@@ -472,8 +922,8 @@ public:
                             more_input_ = false;
                     }
 
-                    const auto rs = filter_->process(
-                        detail::make_span(out_prepare()),
+                    const auto rs = process_filter(
+                        out_prepare(),
                         {{ {tmp_}, {} }},
                         more_input_);
 
@@ -490,6 +940,11 @@ public:
                     if(rs.out_short)
                         break;
 
+                    // parallel blocks are still compressing
+                    if(rs.in_bytes == 0 && rs.out_bytes == 0 &&
+                        !rs.finished)
+                        break;
+
                     if(rs.finished)
                     {
                         filter_done_ = true;
@@ -518,8 +973,8 @@ public:
                         in_.commit(rs.bytes);
                     }
 
-                    const auto rs = filter_->process(
-                        detail::make_span(out_prepare()),
+                    const auto rs = process_filter(
+                        out_prepare(),
                         in_.data(),
                         more_input_);
 
@@ -550,8 +1005,8 @@ public:
                 if(out_capacity() == 0 || filter_done_)
                     break;
 
-                const auto rs = filter_->process(
-                    detail::make_span(out_prepare()),
+                const auto rs = process_filter(
+                    out_prepare(),
                     in_.data(),
                     more_input_);
 
@@ -612,6 +1067,14 @@ public:
 
         prepped_.consume(n);
 
+        // hand consumed buffers back to the source
+        if(lent_ != 0)
+        {
+            auto const m = (std::min)(n, lent_);
+            lent_ -= m;
+            source_->release(m);
+        }
+
         // no-op when out_ is not in use
         out_.consume(n);
 
@@ -654,49 +1117,12 @@ public:
         // Transfer-Encoding
         is_chunked_ = md.transfer_encoding.is_chunked;
 
-        // Content-Encoding
-        switch (md.content_encoding.coding)
-        {
-        case content_coding::deflate:
-            if(!svc_.cfg.apply_deflate_encoder)
-                goto no_filter;
-            filter_ = &ws_.emplace<zlib_filter>(
-                ctx_,
-                ws_,
-                svc_.cfg.zlib_comp_level,
-                svc_.cfg.zlib_window_bits,
-                svc_.cfg.zlib_mem_level);
-            filter_done_ = false;
-            break;
-
-        case content_coding::gzip:
-            if(!svc_.cfg.apply_gzip_encoder)
-                goto no_filter;
-            filter_ = &ws_.emplace<zlib_filter>(
-                ctx_,
-                ws_,
-                svc_.cfg.zlib_comp_level,
-                svc_.cfg.zlib_window_bits + 16,
-                svc_.cfg.zlib_mem_level);
-            filter_done_ = false;
-            break;
-
-        case content_coding::br:
-            if(!svc_.cfg.apply_brotli_encoder)
-                goto no_filter;
-            filter_ = &ws_.emplace<brotli_filter>(
-                ctx_,
-                ws_,
-                svc_.cfg.brotli_comp_quality,
-                svc_.cfg.brotli_comp_window);
-            filter_done_ = false;
-            break;
-
-        no_filter:
-        default:
-            filter_ = nullptr;
-            break;
-        }
+        h_ = &m.h_;
+        header_ = { m.h_.cbuf, m.h_.size };
+        filter_ = nullptr;
+        probe_ = false;
+        borrow_ = false;
+        lent_ = 0;
     }
 
     void
@@ -705,6 +1131,7 @@ public:
     {
         start_init(m);
         style_ = style::empty;
+        init_filter(0);
 
         prepped_ = make_array(
             1 + // header
@@ -715,22 +1142,24 @@ public:
         if(!filter_)
             out_finish();
 
-        prepped_.append({ m.h_.cbuf, m.h_.size });
+        prepped_.append(header_);
         more_input_ = false;
     }
 
     void
     start_buffers(
-        message_base const& m,
+        message_base const&,
         cbs_gen& cbs_gen)
     {
         // start_init() already called 
         style_ = style::buffers;
         cbs_gen_ = &cbs_gen;
 
+        auto stats = cbs_gen_->stats();
+        init_filter(stats.size);
+
         if(!filter_)
         {
-            auto stats = cbs_gen_->stats();
             auto batch_size = clamp(stats.count, 16);
 
             prepped_ = make_array(
@@ -738,7 +1167,7 @@ public:
                 batch_size + // buffers
                 (is_chunked_ ? 2 : 0)); // chunk header + final chunk
 
-            prepped_.append({ m.h_.cbuf, m.h_.size });
+            prepped_.append(header_);
             more_input_ = (batch_size != 0);
 
             if(is_chunked_)
@@ -767,20 +1196,45 @@ public:
 
         out_init();
 
-        prepped_.append({ m.h_.cbuf, m.h_.size });
+        prepped_.append(header_);
         tmp_ = {};
         more_input_ = true;
+
+        // A body in one piece whose coded form fits in
+        // the output area is coded in a single call,
+        // with the end of input signalled up front.
+        if(stats.count == 1 &&
+            out_capacity() >= max_coded_size(stats.size))
+        {
+            tmp_ = cbs_gen_->next();
+            more_input_ = false;
+        }
     }
 
     void
     start_source(
-        message_base const& m,
+        message_base const&,
         source& source)
     {
         // start_init() already called 
         style_ = style::source;
         source_ = &source;
 
+        init_filter(content_length());
+
+        // Buffers lent by the source are sent as-is,
+        // which rules out chunk framing and codings.
+        if(!filter_ && !is_chunked_ && source.can_borrow())
+        {
+            borrow_ = true;
+            prepped_ = make_array(
+                1 + // header
+                16); // lent buffers
+            prepped_.append(header_);
+            more_input_ = true;
+            return;
+        }
+
         prepped_ = make_array(
             1 + // header
             2); // out buffer pairs
@@ -794,7 +1248,7 @@ public:
 
         out_init();
 
-        prepped_.append({ m.h_.cbuf, m.h_.size });
+        prepped_.append(header_);
         more_input_ = true;
     }
 
@@ -803,6 +1257,7 @@ public:
     {
         start_init(m);
         style_ = style::stream;
+        init_filter(content_length());
 
         prepped_ = make_array(
             1 + // header
@@ -817,7 +1272,7 @@ public:
 
         out_init();
 
-        prepped_.append({ m.h_.cbuf, m.h_.size });
+        prepped_.append(header_);
         more_input_ = true;
         return stream{ this };
     }
@@ -841,6 +1296,376 @@ private:
         return state_ == state::body;
     }
 
+    // Install the encoder for the Content-Encoding
+    // of the message, unless ruled out by the
+    // compression policy. `size` is the size of the
+    // body, or the maximum value if unknown.
+    void
+    init_filter(
+        std::uint64_t size)
+    {
+        auto const& cfg = svc_.cfg;
+        probe_ = cfg.compression_probe_size != 0;
+
+        switch (h_->md.content_encoding.coding)
+        {
+        case content_coding::deflate:
+            if(!cfg.apply_deflate_encoder ||
+                skip_compression(size))
+                goto no_filter;
+            filter_ = &make_zlib_filter(size, false);
+            filter_done_ = false;
+            break;
+
+        case content_coding::gzip:
+            if(!cfg.apply_gzip_encoder ||
+                skip_compression(size))
+                goto no_filter;
+            filter_ = &make_zlib_filter(size, true);
+            filter_done_ = false;
+            break;
+
+        case content_coding::br:
+            if(!cfg.apply_brotli_encoder ||
+                skip_compression(size))
+                goto no_filter;
+            filter_ = &ws_.emplace<brotli_filter>(
+                ctx_,
+                ws_,
+                cfg.resource,
+                brotli_comp_quality(),
+                cfg.brotli_comp_window,
+                probe_,
+                dict_ ? dict_->brotli : nullptr);
+            filter_done_ = false;
+            break;
+
+        case content_coding::zstd:
+            if(!cfg.apply_zstd_encoder ||
+                skip_compression(size))
+                goto no_filter;
+            filter_ = &ws_.emplace<zstd_filter>(
+                ctx_,
+                ws_,
+                serializer_service::zstd_level(
+                    cfg.zstd_comp_level, svc_.budget.level_drop()),
+                cfg.zstd_window_log,
+                probe_,
+                dict_ ? dict_->zstd : nullptr);
+            filter_done_ = false;
+            break;
+
+        no_filter:
+        default:
+            filter_ = nullptr;
+            probe_ = false;
+            break;
+        }
+    }
+
+    detail::filter&
+    make_zlib_filter(
+        std::uint64_t size,
+        bool gzip)
+    {
+        auto const& cfg = svc_.cfg;
+
+        // The gzip format cannot signal a dictionary.
+        core::string_view dict;
+        if(dict_ && !gzip)
+            dict = dict_->data;
+
+        // Only buffer sequences are guaranteed to remain
+        // valid while their blocks are being compressed.
+        // Blocks after the first cannot see a dictionary.
+        if(svc_.pool &&
+            dict.empty() &&
+            style_ == style::buffers &&
+            size >= cfg.parallel_compression_min_size)
+        {
+            probe_ = false;
+            return ws_.emplace<detail::parallel_deflate>(
+                ctx_.get_service<rts::zlib::deflate_service>(),
+                *svc_.pool,
+                zlib_comp_level(),
+                cfg.zlib_window_bits,
+                cfg.zlib_mem_level,
+                gzip,
+                cfg.parallel_compression_block_size);
+        }
+
+        return ws_.emplace<zlib_filter>(
+            ctx_,
+            ws_,
+            zlib_comp_level(),
+            cfg.zlib_window_bits + (gzip ? 16 : 0),
+            cfg.zlib_mem_level,
+            probe_,
+            dict);
+    }
+
+    // Return true if the body should be sent without
+    // compression, in which case the header is replaced
+    // with a copy lacking the Content-Encoding field.
+    bool
+    skip_compression(
+        std::uint64_t size)
+    {
+        if(size >= svc_.cfg.min_compression_size &&
+            is_compressible_type())
+            return false;
+
+        auto const n = header_size_without_content_encoding();
+        auto* p = ws_.try_reserve_front(n);
+        if(!p)
+            return false; // compress anyway
+        copy_header_without_content_encoding(
+            {{ buffers::mutable_buffer(p, n), {} }});
+        header_ = { p, n };
+        return true;
+    }
+
+    bool
+    is_compressible_type() const noexcept
+    {
+        auto const& cfg = svc_.cfg;
+        if(cfg.compressible_types.empty() &&
+            cfg.incompressible_types.empty())
+            return true;
+
+        core::string_view type;
+        auto const i = h_->find(field::content_type);
+        if(i != h_->count)
+        {
+            auto const& e = h_->tab()[i];
+            type = core::string_view(
+                h_->cbuf + h_->prefix + e.vp, e.vn);
+            // discard parameters
+            type = type.substr(0, type.find(';'));
+            while(!type.empty() &&
+                (type.back() == ' ' || type.back() == '\t'))
+                type.remove_suffix(1);
+        }
+
+        for(auto const& t : cfg.incompressible_types)
+        {
+            if(match_media_type(t, type))
+                return false;
+        }
+
+        if(cfg.compressible_types.empty())
+            return true;
+
+        for(auto const& t : cfg.compressible_types)
+        {
+            if(match_media_type(t, type))
+                return true;
+        }
+        return false;
+    }
+
+    // Call f with each range of the header which lies
+    // outside of its Content-Encoding fields, in order.
+    template<class F>
+    void
+    for_each_without_content_encoding(
+        F const& f) const
+    {
+        auto const tab = h_->tab();
+        std::size_t pos = 0;
+        for(std::size_t i = 0; i < h_->count; ++i)
+        {
+            if(tab[i].id != field::content_encoding)
+                continue;
+            std::size_t const pos0 =
+                h_->prefix + tab[i].np;
+            std::size_t const pos1 = (i + 1 < h_->count)
+                ? h_->prefix + tab[i + 1].np
+                : h_->size - 2; // final CRLF
+            if(pos0 > pos)
+                f(buffers::const_buffer(
+                    h_->cbuf + pos, pos0 - pos));
+            pos = pos1;
+        }
+        f(buffers::const_buffer(
+            h_->cbuf + pos, h_->size - pos));
+    }
+
+    std::size_t
+    header_size_without_content_encoding() const
+    {
+        std::size_t n = 0;
+        for_each_without_content_encoding(
+            [&](buffers::const_buffer b)
+            {
+                n += b.size();
+            });
+        return n;
+    }
+
+    void
+    copy_header_without_content_encoding(
+        buffers::mutable_buffer_pair dest) const
+    {
+        for_each_without_content_encoding(
+            [&](buffers::const_buffer b)
+            {
+                buffers::remove_prefix(dest,
+                    buffers::copy(dest, b));
+            });
+    }
+
+    std::uint64_t
+    content_length() const noexcept
+    {
+        if(h_->md.payload == payload::size)
+            return h_->md.payload_size;
+        return (std::numeric_limits<
+            std::uint64_t>::max)();
+    }
+
+    int
+    zlib_comp_level() const noexcept
+    {
+        auto const level = svc_.cfg.zlib_comp_level;
+        auto const drop = svc_.budget.level_drop();
+        if(level - drop < 1)
+            return (level < 1) ? level : 1;
+        return level - drop;
+    }
+
+    std::uint32_t
+    brotli_comp_quality() const noexcept
+    {
+        auto const quality = svc_.cfg.brotli_comp_quality;
+        auto const drop = static_cast<
+            std::uint32_t>(svc_.budget.level_drop());
+        if(quality < drop)
+            return 0;
+        return quality - drop;
+    }
+
+    detail::filter::results
+    process_filter(
+        buffers::mutable_buffer_pair out,
+        buffers::const_buffer_pair in,
+        bool more)
+    {
+        if(svc_.cfg.compression_time_budget.count() == 0 ||
+            filter_ == &identity_)
+            return filter_->process(
+                detail::make_span(out), in, more);
+
+        auto const t0 = std::chrono::steady_clock::now();
+        auto rs = filter_->process(
+            detail::make_span(out), in, more);
+        svc_.budget.on_compress_time(
+            std::chrono::steady_clock::now() - t0);
+        return rs;
+    }
+
+    // Compress and flush a prefix of the body before
+    // the header is sent, and fall back to the identity
+    // coding if the result does not shrink enough.
+    system::error_code
+    probe_filter()
+    {
+        probe_ = false;
+
+        // Content-Encoding is already on the wire
+        if(is_header_done())
+            return {};
+
+        buffers::const_buffer sample;
+        switch(style_)
+        {
+        case style::empty:
+            break;
+
+        case style::buffers:
+            if(more_input_ && tmp_.size() == 0)
+            {
+                tmp_ = cbs_gen_->next();
+                if(tmp_.size() == 0) // cbs_gen_ is empty
+                    more_input_ = false;
+            }
+            sample = tmp_;
+            break;
+
+        case style::source:
+            while(more_input_ && in_.capacity() != 0 &&
+                in_.size() < svc_.cfg.compression_probe_size)
+            {
+                const auto rs = source_->read(
+                    in_.prepare(in_.capacity()));
+                if(rs.ec.failed())
+                    return rs.ec;
+                if(rs.finished)
+                    more_input_ = false;
+                in_.commit(rs.bytes);
+                if(rs.bytes == 0)
+                    break;
+            }
+            sample = in_.data()[0];
+            break;
+
+        case style::stream:
+            sample = in_.data()[0];
+            break;
+        }
+
+        // Keep the flushed output well within the
+        // output area so the flush completes in one call.
+        auto const limit = (std::min)(
+            svc_.cfg.compression_probe_size,
+            out_capacity() / 2);
+        if(sample.size() == 0 || limit == 0)
+            return {};
+
+        auto const truncated = sample.size() > limit;
+        if(truncated)
+            sample = { sample.data(), limit };
+
+        const auto rs = process_filter(
+            out_prepare(),
+            {{ {sample}, {} }},
+            more_input_ || truncated);
+
+        if(rs.ec.failed())
+            return rs.ec;
+
+        auto const header_size =
+            header_size_without_content_encoding();
+        if(rs.out_bytes * 100 <=
+                rs.in_bytes * svc_.cfg.compression_probe_ratio ||
+            header_size >= out_capacity())
+        {
+            if(style_ == style::buffers)
+                buffers::remove_prefix(tmp_, rs.in_bytes);
+            else
+                in_.consume(rs.in_bytes);
+
+            out_commit(rs.out_bytes);
+
+            if(rs.finished)
+            {
+                filter_done_ = true;
+                out_finish();
+            }
+            return {};
+        }
+
+        // Discard the compressed output and send the
+        // header without Content-Encoding, followed by
+        // the body as-is.
+        copy_header_without_content_encoding(
+            out_.prepare(header_size));
+        out_.commit(header_size);
+        prepped_[0] = {};
+        filter_ = &identity_;
+        return {};
+    }
+
     detail::array_of_const_buffers
     make_array(std::size_t n)
     {
@@ -932,10 +1757,16 @@ private:
 
 serializer::
 serializer(const rts::context& ctx)
-    : impl_(new impl(ctx))
+    : impl_(impl::construct(ctx, nullptr))
+{
+}
+
+serializer::
+serializer(
+    const rts::context& ctx,
+    void* storage)
+    : impl_(impl::construct(ctx, storage))
 {
-    // TODO: use a single allocation for
-    // impl and workspace buffer.
 }
 
 serializer::
@@ -948,7 +1779,16 @@ serializer(serializer&& other) noexcept
 serializer::
 ~serializer()
 {
-    delete impl_;
+    impl::destroy(impl_);
+}
+
+std::size_t
+serializer::
+storage_needed(
+    const rts::context& ctx)
+{
+    return impl::storage_needed(
+        ctx.get_service<serializer_service>());
 }
 
 void
@@ -959,6 +1799,14 @@ reset() noexcept
     impl_->reset();
 }
 
+void
+serializer::
+set_dictionary(std::uint32_t id)
+{
+    BOOST_ASSERT(impl_);
+    impl_->set_dictionary(id);
+}
+
 void
 serializer::
 start(message_base const& m)
@@ -42,5 +42,15 @@ on_read(
     return rv;
 }
 
+auto
+source::
+on_borrow(
+    buffers::const_buffer&) ->
+        results
+{
+    // source does not lend buffers
+    detail::throw_logic_error();
+}
+
 } // http_proto
 } // boost
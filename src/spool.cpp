@@ -0,0 +1,142 @@
+//
+// Copyright (c) 2025 Mohammad Nejati
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#include <boost/http_proto/spool.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+namespace boost {
+namespace http_proto {
+
+spool::
+spool()
+    : spool(config{})
+{
+}
+
+spool::
+spool(config const& cfg)
+    : threshold_(cfg.threshold)
+    , dir_(cfg.directory)
+{
+}
+
+spool::
+spool(spool&&) noexcept = default;
+
+spool::
+~spool() = default;
+
+std::size_t
+spool::
+read_at(
+    std::uint64_t offset,
+    buffers::mutable_buffer b,
+    system::error_code& ec)
+{
+    if(offset >= size_)
+    {
+        ec = {};
+        return 0;
+    }
+    auto const n = static_cast<std::size_t>(
+        (std::min<std::uint64_t>)(
+            b.size(), size_ - offset));
+    if(in_memory())
+    {
+        std::memcpy(b.data(), buf_.data() +
+            static_cast<std::size_t>(offset), n);
+        ec = {};
+        return n;
+    }
+    return f_.read_at(offset, b.data(), n, ec);
+}
+
+void
+spool::
+reserve(
+    std::uint64_t n,
+    system::error_code& ec)
+{
+    if(in_memory())
+    {
+        if(n <= threshold_ - buf_.size())
+        {
+            buf_.reserve(buf_.size() +
+                static_cast<std::size_t>(n));
+            ec = {};
+            return;
+        }
+        spill(ec);
+        if(ec.failed())
+            return;
+    }
+    f_.allocate(size_ + n, ec);
+}
+
+void
+spool::
+append(
+    buffers::const_buffer b,
+    system::error_code& ec)
+{
+    if(in_memory())
+    {
+        if(b.size() <= threshold_ - buf_.size())
+        {
+            buf_.append(static_cast<
+                char const*>(b.data()), b.size());
+            size_ += b.size();
+            ec = {};
+            return;
+        }
+        spill(ec);
+        if(ec.failed())
+            return;
+    }
+    // positional, as reads may
+    // move the file position
+    size_ += f_.write_at(
+        size_, b.data(), b.size(), ec);
+}
+
+void
+spool::
+clear() noexcept
+{
+    // the memory is kept for reuse
+    buf_.clear();
+    system::error_code ec;
+    f_.close(ec);
+    size_ = 0;
+}
+
+// Move the data to a temporary file
+void
+spool::
+spill(system::error_code& ec)
+{
+    file f;
+    f.open_temp(dir_.c_str(), ec);
+    if(ec.failed())
+        return;
+    if(! buf_.empty())
+    {
+        f.write_at(0, buf_.data(), buf_.size(), ec);
+        if(ec.failed())
+            return;
+    }
+    f_ = std::move(f);
+    std::string().swap(buf_);
+    ec = {};
+}
+
+} // http_proto
+} // boost
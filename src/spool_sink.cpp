@@ -0,0 +1,47 @@
+//
+// Copyright (c) 2025 Mohammad Nejati
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#include <boost/http_proto/spool_sink.hpp>
+#include <boost/http_proto/detail/except.hpp>
+
+namespace boost {
+namespace http_proto {
+
+spool_sink::
+spool_sink(spool& sp) noexcept
+    : sp_(sp)
+{
+}
+
+void
+spool_sink::
+reserve(std::uint64_t n)
+{
+    system::error_code ec;
+    sp_.reserve(n, ec);
+    if(ec.failed())
+        detail::throw_system_error(ec);
+}
+
+auto
+spool_sink::
+on_write(
+    buffers::const_buffer b,
+    bool) -> results
+{
+    results rv;
+    auto const size = sp_.size();
+    sp_.append(b, rv.ec);
+    rv.bytes = static_cast<
+        std::size_t>(sp_.size() - size);
+    return rv;
+}
+
+} // http_proto
+} // boost
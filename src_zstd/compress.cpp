@@ -0,0 +1,155 @@
+//
+// Copyright (c) 2025 Mohammad Nejati
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#include <boost/http_proto/zstd/compress.hpp>
+
+#include <boost/rts/context.hpp>
+
+#include "src_zstd/error.hpp"
+
+#define ZSTD_STATIC_LINKING_ONLY
+#include <zstd.h>
+
+namespace boost {
+namespace http_proto {
+namespace zstd {
+
+namespace {
+
+// RFC 9659 limits the window to 8MB
+constexpr int max_window_log = 23;
+
+class compress_service_impl
+    : public compress_service
+{
+public:
+    using key_type = compress_service;
+
+    explicit
+    compress_service_impl(
+        const rts::context&) noexcept
+    {
+    }
+
+    static
+    ZSTD_compressionParameters
+    make_params(
+        int level,
+        int window_log) noexcept
+    {
+        auto cp = ZSTD_getCParams(level, 0, 0);
+        if(window_log != 0)
+            cp.windowLog = static_cast<unsigned>(window_log);
+        else if(cp.windowLog > max_window_log)
+            cp.windowLog = max_window_log;
+        return cp;
+    }
+
+    std::size_t
+    space_needed(
+        int level,
+        int window_log) const noexcept override
+    {
+        return ZSTD_estimateCStreamSize_usingCParams(
+            make_params(level, window_log));
+    }
+
+    cstream*
+    init_static(
+        void* p,
+        std::size_t n,
+        int level,
+        int window_log) const noexcept override
+    {
+        auto* cctx = ZSTD_initStaticCStream(p, n);
+        if(! cctx)
+            return nullptr;
+        auto const cp = make_params(level, window_log);
+        if(ZSTD_isError(ZSTD_CCtx_setParameter(
+                cctx, ZSTD_c_compressionLevel, level)) ||
+            ZSTD_isError(ZSTD_CCtx_setParameter(
+                cctx, ZSTD_c_windowLog,
+                static_cast<int>(cp.windowLog))))
+            return nullptr;
+        return reinterpret_cast<cstream*>(cctx);
+    }
+
+    cdict*
+    create_dictionary(
+        void const* data,
+        std::size_t size,
+        int level) const noexcept override
+    {
+        return reinterpret_cast<cdict*>(
+            ZSTD_createCDict_advanced(
+                data,
+                size,
+                ZSTD_dlm_byRef,
+                ZSTD_dct_auto,
+                ZSTD_getCParams(level, 0, size),
+                ZSTD_defaultCMem));
+    }
+
+    void
+    free_dictionary(
+        cdict* cd) const noexcept override
+    {
+        ZSTD_freeCDict(reinterpret_cast<ZSTD_CDict*>(cd));
+    }
+
+    bool
+    ref_dictionary(
+        cstream& cs,
+        cdict const* cd) const noexcept override
+    {
+        return ! ZSTD_isError(ZSTD_CCtx_refCDict(
+            reinterpret_cast<ZSTD_CCtx*>(&cs),
+            reinterpret_cast<ZSTD_CDict const*>(cd)));
+    }
+
+    std::size_t
+    compress_stream(
+        cstream& cs,
+        out_buffer& out,
+        in_buffer& in,
+        end_directive directive,
+        system::error_code& ec) const noexcept override
+    {
+        ZSTD_outBuffer ob{ out.dst, out.size, out.pos };
+        ZSTD_inBuffer ib{ in.src, in.size, in.pos };
+
+        ZSTD_EndDirective op = ZSTD_e_continue;
+        if(directive == end_directive::flush)
+            op = ZSTD_e_flush;
+        else if(directive == end_directive::end)
+            op = ZSTD_e_end;
+
+        auto const rv = ZSTD_compressStream2(
+            reinterpret_cast<ZSTD_CCtx*>(&cs),
+            &ob, &ib, op);
+
+        out.pos = ob.pos;
+        in.pos = ib.pos;
+        set_error(ec, rv);
+        return ec.failed() ? 0 : rv;
+    }
+};
+
+} // (anon)
+
+void
+install_compress_service(
+    rts::context& ctx)
+{
+    ctx.make_service<compress_service_impl>();
+}
+
+} // zstd
+} // http_proto
+} // boost
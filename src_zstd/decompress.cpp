@@ -0,0 +1,123 @@
+//
+// Copyright (c) 2025 Mohammad Nejati
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#include <boost/http_proto/zstd/decompress.hpp>
+
+#include <boost/rts/context.hpp>
+
+#include "src_zstd/error.hpp"
+
+#define ZSTD_STATIC_LINKING_ONLY
+#include <zstd.h>
+
+namespace boost {
+namespace http_proto {
+namespace zstd {
+
+namespace {
+
+class decompress_service_impl
+    : public decompress_service
+{
+public:
+    using key_type = decompress_service;
+
+    explicit
+    decompress_service_impl(
+        const rts::context&) noexcept
+    {
+    }
+
+    std::size_t
+    space_needed(
+        int window_log_max) const noexcept override
+    {
+        return ZSTD_estimateDStreamSize(
+            std::size_t(1) << window_log_max);
+    }
+
+    dstream*
+    init_static(
+        void* p,
+        std::size_t n,
+        int window_log_max) const noexcept override
+    {
+        auto* dctx = ZSTD_initStaticDStream(p, n);
+        if(! dctx)
+            return nullptr;
+        if(ZSTD_isError(ZSTD_DCtx_setParameter(
+                dctx, ZSTD_d_windowLogMax, window_log_max)))
+            return nullptr;
+        return reinterpret_cast<dstream*>(dctx);
+    }
+
+    ddict*
+    create_dictionary(
+        void const* data,
+        std::size_t size) const noexcept override
+    {
+        return reinterpret_cast<ddict*>(
+            ZSTD_createDDict_advanced(
+                data,
+                size,
+                ZSTD_dlm_byRef,
+                ZSTD_dct_auto,
+                ZSTD_defaultCMem));
+    }
+
+    void
+    free_dictionary(
+        ddict* dd) const noexcept override
+    {
+        ZSTD_freeDDict(reinterpret_cast<ZSTD_DDict*>(dd));
+    }
+
+    bool
+    ref_dictionary(
+        dstream& ds,
+        ddict const* dd) const noexcept override
+    {
+        return ! ZSTD_isError(ZSTD_DCtx_refDDict(
+            reinterpret_cast<ZSTD_DCtx*>(&ds),
+            reinterpret_cast<ZSTD_DDict const*>(dd)));
+    }
+
+    std::size_t
+    decompress_stream(
+        dstream& ds,
+        out_buffer& out,
+        in_buffer& in,
+        system::error_code& ec) const noexcept override
+    {
+        ZSTD_outBuffer ob{ out.dst, out.size, out.pos };
+        ZSTD_inBuffer ib{ in.src, in.size, in.pos };
+
+        auto const rv = ZSTD_decompressStream(
+            reinterpret_cast<ZSTD_DCtx*>(&ds),
+            &ob, &ib);
+
+        out.pos = ob.pos;
+        in.pos = ib.pos;
+        set_error(ec, rv);
+        return ec.failed() ? 0 : rv;
+    }
+};
+
+} // (anon)
+
+void
+install_decompress_service(
+    rts::context& ctx)
+{
+    ctx.make_service<decompress_service_impl>();
+}
+
+} // zstd
+} // http_proto
+} // boost
@@ -0,0 +1,80 @@
+//
+// Copyright (c) 2025 Mohammad Nejati
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#include "src_zstd/error.hpp"
+
+#include <zstd.h>
+#include <zstd_errors.h>
+
+#include <string>
+
+namespace boost {
+namespace http_proto {
+namespace zstd {
+
+namespace {
+
+class error_cat_type
+    : public system::error_category
+{
+public:
+    BOOST_SYSTEM_CONSTEXPR error_cat_type() noexcept
+        : error_category(0xc3f1a9b04e7d2568)
+    {
+    }
+
+    const char*
+    name() const noexcept override
+    {
+        return "boost.http_proto.zstd";
+    }
+
+    std::string
+    message(int ev) const override
+    {
+        return message(ev, nullptr, 0);
+    }
+
+    char const*
+    message(
+        int ev,
+        char*,
+        std::size_t) const noexcept override
+    {
+        return ZSTD_getErrorString(
+            static_cast<ZSTD_ErrorCode>(ev));
+    }
+};
+
+#if defined(__cpp_constinit) && __cpp_constinit >= 201907L
+constinit error_cat_type error_cat;
+#else
+error_cat_type error_cat;
+#endif
+
+} // (anon)
+
+void
+set_error(
+    system::error_code& ec,
+    std::size_t result) noexcept
+{
+    if(! ZSTD_isError(result))
+    {
+        ec = {};
+        return;
+    }
+    ec = system::error_code(
+        static_cast<int>(ZSTD_getErrorCode(result)),
+        error_cat);
+}
+
+} // zstd
+} // http_proto
+} // boost
@@ -0,0 +1,32 @@
+//
+// Copyright (c) 2025 Mohammad Nejati
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#ifndef BOOST_HTTP_PROTO_SRC_ZSTD_ERROR_HPP
+#define BOOST_HTTP_PROTO_SRC_ZSTD_ERROR_HPP
+
+#include <boost/system/error_code.hpp>
+
+#include <cstddef>
+
+namespace boost {
+namespace http_proto {
+namespace zstd {
+
+// Convert the result of a zstd function into
+// an error code, which is cleared on success.
+void
+set_error(
+    system::error_code& ec,
+    std::size_t result) noexcept;
+
+} // zstd
+} // http_proto
+} // boost
+
+#endif
@@ -8,9 +8,11 @@
 // Official repository: https://github.com/cppalliance/http_proto
 //
 
+#include <boost/http_proto/compression_dictionary.hpp>
 #include <boost/http_proto/request_parser.hpp>
 #include <boost/http_proto/response_parser.hpp>
 #include <boost/http_proto/serializer.hpp>
+#include <boost/http_proto/zstd.hpp>
 
 #include <boost/buffers.hpp>
 #include <boost/core/detail/string_view.hpp>
@@ -21,7 +23,9 @@
 
 #include "test_helpers.hpp"
 
+#include <stdexcept>
 #include <string>
+#include <thread>
 #include <vector>
 #include <random>
 
@@ -133,6 +137,29 @@ struct zlib_test
 
             svc.destroy_instance(state);
         }
+        else if(encoding == "zstd")
+        {
+            auto& svc = ctx.get_service<zstd::compress_service>();
+
+            auto const n = svc.space_needed(3, 0);
+            std::vector<std::uint64_t> mem(n / 8 + 1);
+            auto* cs = svc.init_static(mem.data(), n, 3, 0);
+
+            if(!BOOST_TEST_NE(cs, nullptr))
+                return {};
+
+            zstd::in_buffer in{ body.data(), body.size(), 0 };
+            for(;;)
+            {
+                zstd::out_buffer out{ buf.prepare(64 * 1024).data(), 64 * 1024, 0 };
+                system::error_code ec;
+                auto ret = svc.compress_stream(
+                    *cs, out, in, zstd::end_directive::end, ec);
+                buf.commit(out.pos);
+                if(!BOOST_TEST_NOT(ec.failed()) || ret == 0)
+                    break;
+            }
+        }
         else
         {
             BOOST_TEST_FAIL();
@@ -227,6 +254,35 @@ struct zlib_test
 
             svc.destroy_instance(state);
         }
+        else if(encoding == "zstd")
+        {
+            auto& svc = ctx.get_service<zstd::decompress_service>();
+
+            auto const n = svc.space_needed(23);
+            std::vector<std::uint64_t> mem(n / 8 + 1);
+            auto* ds = svc.init_static(mem.data(), n, 23);
+
+            if(!BOOST_TEST_NE(ds, nullptr))
+                return;
+
+            zstd::in_buffer in{
+                compressed_body.data(), compressed_body.size(), 0 };
+            for(;;)
+            {
+                char buf[64 * 1024];
+                zstd::out_buffer out{ &buf[0], 64 * 1024, 0 };
+                system::error_code ec;
+                auto ret = svc.decompress_stream(*ds, out, in, ec);
+                auto piece = core::string_view{ &buf[0], out.pos };
+                if(!BOOST_TEST(body.starts_with(piece)))
+                    break;
+                body.remove_prefix(piece.size());
+                if(!BOOST_TEST_NOT(ec.failed()))
+                    break;
+                if(ret == 0 && in.pos == in.size)
+                    break;
+            }
+        }
         else
         {
             BOOST_TEST_FAIL();
@@ -283,13 +339,12 @@ struct zlib_test
 
     static
     void
-    serializer_stream(
-        response const& res,
+    serializer_stream_continue(
+        serializer::stream& stream,
         serializer& sr,
         buffers::const_buffer body,
         buffers::string_buffer out)
     {
-        auto stream = sr.start_stream(res);
         do
         {
             if(stream.is_open())
@@ -319,6 +374,18 @@ struct zlib_test
         } while(!sr.is_done());
     }
 
+    static
+    void
+    serializer_stream(
+        response const& res,
+        serializer& sr,
+        buffers::const_buffer body,
+        buffers::string_buffer out)
+    {
+        auto stream = sr.start_stream(res);
+        serializer_stream_continue(stream, sr, body, out);
+    }
+
     static
     void
     serializer_buffers(
@@ -351,6 +418,27 @@ struct zlib_test
         }while(!sr.is_done());
     }
 
+    static
+    void
+    serializer_one_buffer(
+        response const& res,
+        serializer& sr,
+        buffers::const_buffer body,
+        buffers::string_buffer out)
+    {
+        // small bodies take the one-shot path
+        sr.start(res, body);
+        do
+        {
+            auto cbs = sr.prepare();
+            auto n = buffers::size(cbs.value());
+            BOOST_TEST_GT(n, 0);
+            buffers::copy(out.prepare(n), cbs.value());
+            sr.consume(n);
+            out.commit(n);
+        }while(!sr.is_done());
+    }
+
     static
     void
     serializer_empty(
@@ -394,6 +482,12 @@ struct zlib_test
             rts::brotli::install_decode_service(ctx);
             encodings.push_back("br");
         #endif
+        #ifdef BOOST_HTTP_PROTO_HAS_ZSTD
+            cfg.apply_zstd_encoder = true;
+            zstd::install_compress_service(ctx);
+            zstd::install_decompress_service(ctx);
+            encodings.push_back("zstd");
+        #endif
 
         install_serializer_service(ctx, cfg);
         serializer sr(ctx);
@@ -403,7 +497,9 @@ struct zlib_test
         for(core::string_view encoding : encodings) 
         for(auto chunked : { true, false })
         for(auto body_size : { 0, 7, 64 * 1024, 1024 * 1024 })
-        for(auto driver : { serializer_empty, serializer_buffers, serializer_stream, serializer_source })
+        for(auto driver : {
+            serializer_empty, serializer_buffers, serializer_one_buffer,
+            serializer_stream, serializer_source })
         {
             if(driver == serializer_empty && body_size != 0)
                 continue;
@@ -470,6 +566,203 @@ struct zlib_test
         }
     }
 
+    // Return the body which follows the header of
+    // res in out, checking that its framing agrees
+    // with the one declared by the header.
+    static
+    std::string
+    framed_body(
+        response const& res,
+        core::string_view out)
+    {
+        BOOST_TEST(out.starts_with(res.buffer()));
+        auto raw = out.substr(res.buffer().size());
+        if(res.payload() == payload::size)
+        {
+            BOOST_TEST_EQ(raw.size(), res.payload_size());
+            return std::string(raw);
+        }
+
+        BOOST_TEST(res.chunked());
+        std::string body;
+        for(;;)
+        {
+            auto pos = raw.find("\r\n");
+            if(! BOOST_TEST(pos != core::string_view::npos))
+                break;
+            auto chunk_size = std::stoul(
+                std::string(raw.substr(0, pos)), nullptr, 16);
+            raw.remove_prefix(pos + 2);
+            if(chunk_size == 0)
+            {
+                BOOST_TEST(raw == "\r\n");
+                break;
+            }
+            if(! BOOST_TEST(chunk_size < raw.size()))
+                break;
+            body.append(raw.data(), chunk_size);
+            raw.remove_prefix(chunk_size);
+            BOOST_TEST(raw.starts_with("\r\n"));
+            raw.remove_prefix(2);
+        }
+        return body;
+    }
+
+    void
+    test_serializer_policy()
+    {
+    #ifdef BOOST_RTS_HAS_ZLIB
+        rts::context ctx;
+        rts::zlib::install_deflate_service(ctx);
+        rts::zlib::install_inflate_service(ctx);
+
+        serializer::config cfg;
+        cfg.apply_gzip_encoder = true;
+        cfg.min_compression_size = 1024;
+        cfg.incompressible_types = { "image/*" };
+        cfg.compression_probe_size = 4096;
+        install_serializer_service(ctx, cfg);
+        serializer sr(ctx);
+
+        const auto rand_string = make_rand_string(64 * 1024);
+
+        std::string noise(64 * 1024, '\0');
+        {
+            std::mt19937 rng(7);
+            for(auto& c : noise)
+                c = static_cast<char>(rng());
+        }
+
+        auto check = [&](
+            core::string_view content_type,
+            core::string_view body,
+            bool compressed)
+        {
+            for(auto driver : { serializer_buffers, serializer_stream, serializer_source })
+            {
+                // the length of a coded body is not
+                // known up front, so it is chunked
+                response resp;
+                resp.set(field::content_type, content_type);
+                resp.set(field::content_encoding, "gzip");
+                if(compressed)
+                    resp.set_chunked(true);
+                else
+                    resp.set_content_length(body.size());
+
+                std::string buf;
+                driver(
+                    resp,
+                    sr,
+                    buffers::const_buffer(body.data(), body.size()),
+                    buffers::string_buffer(&buf));
+
+                if(compressed)
+                {
+                    verify_compressed(
+                        ctx,
+                        "gzip",
+                        framed_body(resp, buf),
+                        body);
+                }
+                else
+                {
+                    response expected = resp;
+                    expected.erase(field::content_encoding);
+                    BOOST_TEST(framed_body(expected, buf) == body);
+                }
+            }
+        };
+
+        // below min_compression_size
+        check("text/plain", core::string_view{ rand_string }.substr(0, 7), false);
+
+        // incompressible_types
+        check("image/png", rand_string, false);
+        check("Image/PNG; q=1", rand_string, false);
+
+        // probe ratio
+        check("application/octet-stream", noise, false);
+        check("text/plain", rand_string, true);
+
+        // the probe of a stream waits for its first data
+        {
+            response resp;
+            resp.set(field::content_type, "application/octet-stream");
+            resp.set(field::content_encoding, "gzip");
+            resp.set_content_length(noise.size());
+
+            auto stream = sr.start_stream(resp);
+            BOOST_TEST(sr.prepare().error() == error::need_data);
+
+            std::string buf;
+            serializer_stream_continue(
+                stream,
+                sr,
+                buffers::const_buffer(noise.data(), noise.size()),
+                buffers::string_buffer(&buf));
+
+            response expected = resp;
+            expected.erase(field::content_encoding);
+            BOOST_TEST(framed_body(expected, buf) == noise);
+        }
+    #endif
+    }
+
+    void
+    test_serializer_parallel()
+    {
+    #ifdef BOOST_RTS_HAS_ZLIB
+        rts::context ctx;
+        rts::zlib::install_deflate_service(ctx);
+        rts::zlib::install_inflate_service(ctx);
+
+        serializer::config cfg;
+        cfg.apply_deflate_encoder = true;
+        cfg.apply_gzip_encoder = true;
+        cfg.parallel_compression_threads = 4;
+        cfg.parallel_compression_min_size = 64 * 1024;
+        cfg.parallel_compression_block_size = 32 * 1024;
+        install_serializer_service(ctx, cfg);
+        serializer sr(ctx);
+
+        const auto rand_string = make_rand_string(1024 * 1024);
+
+        for(core::string_view encoding : { "gzip", "deflate" })
+        for(auto body_size : { 64 * 1024, 100 * 1000, 1024 * 1024 })
+        {
+            // the length of a coded body is not
+            // known up front, so it is chunked
+            response resp;
+            resp.set(field::content_encoding, encoding);
+            resp.set_chunked(true);
+
+            auto body = core::string_view{ rand_string }.substr(0, body_size);
+            std::string buf;
+            buffers::string_buffer out(&buf);
+            sr.start(resp,
+                buffers::const_buffer(body.data(), body.size()));
+            do
+            {
+                // empty while blocks are compressing
+                auto cbs = sr.prepare();
+                auto n = buffers::size(cbs.value());
+                if(n == 0)
+                    std::this_thread::yield();
+                buffers::copy(out.prepare(n), cbs.value());
+                sr.consume(n);
+                out.commit(n);
+            } while(!sr.is_done());
+
+            verify_compressed(
+                ctx,
+                encoding,
+                framed_body(resp, buf),
+                body);
+        }
+    #endif
+    }
+
     static
     std::string
     parser_pull_body(
@@ -630,6 +923,12 @@ struct zlib_test
             rts::brotli::install_decode_service(ctx);
             encodings.push_back("br");
         #endif
+        #ifdef BOOST_HTTP_PROTO_HAS_ZSTD
+            cfg.apply_zstd_decoder = true;
+            zstd::install_compress_service(ctx);
+            zstd::install_decompress_service(ctx);
+            encodings.push_back("zstd");
+        #endif
 
         cfg.body_limit = 1024 * 1024;
         install_parser_service(ctx, cfg);
@@ -708,10 +1007,160 @@ struct zlib_test
         }
     }
 
+    void
+    test_dictionary()
+    {
+        rts::context ctx;
+        std::vector<std::string> encodings;
+        serializer::config scfg;
+        response_parser::config pcfg;
+
+        #ifdef BOOST_RTS_HAS_ZLIB
+            rts::zlib::install_deflate_service(ctx);
+            rts::zlib::install_inflate_service(ctx);
+            scfg.apply_deflate_encoder = true;
+            pcfg.apply_deflate_decoder = true;
+            encodings.push_back("deflate");
+        #endif
+        #ifdef BOOST_RTS_HAS_BROTLI
+            rts::brotli::install_encode_service(ctx);
+            rts::brotli::install_decode_service(ctx);
+            scfg.apply_brotli_encoder = true;
+            pcfg.apply_brotli_decoder = true;
+            encodings.push_back("br");
+        #endif
+        #ifdef BOOST_HTTP_PROTO_HAS_ZSTD
+            zstd::install_compress_service(ctx);
+            zstd::install_decompress_service(ctx);
+            scfg.apply_zstd_encoder = true;
+            pcfg.apply_zstd_decoder = true;
+            encodings.push_back("zstd");
+        #endif
+
+        auto const record = [](int i)
+        {
+            return
+                "{\"id\":" + std::to_string(i) +
+                ",\"name\":\"user" + std::to_string(i % 97) +
+                "\",\"email\":\"user@example.com\"," +
+                "\"roles\":[\"reader\",\"writer\"]}";
+        };
+
+        std::string dictionary;
+        for(int i = 0; i < 64; ++i)
+            dictionary += record(i);
+
+        install_compression_dictionary(ctx, 1, dictionary);
+        BOOST_TEST_THROWS(
+            install_compression_dictionary(ctx, 1, dictionary),
+            std::invalid_argument);
+        BOOST_TEST_THROWS(
+            install_compression_dictionary(ctx, 2, ""),
+            std::invalid_argument);
+
+        install_serializer_service(ctx, scfg);
+        install_parser_service(ctx, pcfg);
+        serializer sr(ctx);
+        response_parser pr(ctx);
+        pr.reset();
+
+        BOOST_TEST_THROWS(
+            sr.set_dictionary(2),
+            std::invalid_argument);
+
+        auto const body = record(1000);
+
+        auto const serialize = [&](
+            core::string_view encoding,
+            bool use_dictionary)
+        {
+            response resp;
+            resp.set(field::content_encoding, encoding);
+            resp.set_chunked(true);
+
+            if(use_dictionary)
+                sr.set_dictionary(1);
+
+            std::string buf;
+            serializer_buffers(
+                resp,
+                sr,
+                buffers::const_buffer(body.data(), body.size()),
+                buffers::string_buffer(&buf));
+
+            auto raw = core::string_view{ buf }.substr(
+                resp.buffer().size());
+            std::string coded;
+            for(;;)
+            {
+                auto const pos = raw.find("\r\n");
+                auto const n = std::stoul(
+                    raw.substr(0, pos), nullptr, 16);
+                if(n == 0)
+                    break;
+                coded += raw.substr(pos + 2, n);
+                raw.remove_prefix(pos + 2 + n + 2);
+            }
+            return coded;
+        };
+
+        auto const parse = [&](
+            core::string_view encoding,
+            core::string_view coded,
+            bool use_dictionary,
+            system::error_code& ec)
+        {
+            std::string msg = "HTTP/1.1 200 OK\r\nContent-Encoding: ";
+            msg += encoding;
+            msg += "\r\nContent-Length: ";
+            msg += std::to_string(coded.size());
+            msg += "\r\n\r\n";
+            msg += coded;
+
+            pr.start();
+            auto n = buffers::copy(
+                pr.prepare(),
+                buffers::const_buffer(msg.data(), msg.size()));
+            BOOST_TEST_EQ(n, msg.size());
+            pr.commit(n);
+            pr.parse(ec);
+            BOOST_TEST(pr.got_header());
+
+            if(use_dictionary)
+                pr.set_dictionary(1);
+
+            std::string rs;
+            buffers::string_buffer buf(&rs);
+            pr.set_body(std::ref(buf));
+            pr.parse(ec);
+            if(ec)
+                pr.reset();
+            return rs;
+        };
+
+        for(core::string_view encoding : encodings)
+        {
+            auto const plain = serialize(encoding, false);
+            auto const coded = serialize(encoding, true);
+            BOOST_TEST_LT(coded.size(), plain.size());
+
+            system::error_code ec;
+            BOOST_TEST(parse(encoding, coded, true, ec) == body);
+            BOOST_TEST(! ec);
+
+            // the decoder needs the same dictionary
+            parse(encoding, coded, false, ec);
+            BOOST_TEST(ec.failed());
+        }
+    }
+
     void run()
     {
         test_serializer();
+        test_serializer_policy();
+        test_serializer_parallel();
         test_parser();
+        test_dictionary();
     }
 };
 
@@ -0,0 +1,111 @@
+//
+// Copyright (c) 2025 Mohammad Nejati
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+// Test that header file is self-contained.
+#include <boost/http_proto/connection_buffers.hpp>
+
+#include <boost/http_proto/response.hpp>
+#include <boost/buffers/copy.hpp>
+#include <boost/rts/context.hpp>
+
+#include "test_suite.hpp"
+
+#include <cstring>
+#include <string>
+
+namespace boost {
+namespace http_proto {
+
+struct connection_buffers_test
+{
+    void
+    testStorage()
+    {
+        rts::context ctx;
+        request_parser::config pcfg;
+        install_parser_service(ctx, pcfg);
+        serializer::config scfg;
+        install_serializer_service(ctx, scfg);
+
+        connection_buffers cb(ctx);
+        BOOST_TEST_EQ(
+            cb.size(),
+            connection_buffers::storage_needed(ctx));
+        BOOST_TEST_GE(
+            cb.size(),
+            pcfg.min_buffer + scfg.payload_buffer);
+
+        cb.parser().reset();
+        cb.parser().start();
+        auto const mb = *cb.parser().prepare().begin();
+        BOOST_TEST_GT(mb.size(), 0);
+    }
+
+    void
+    testExchange()
+    {
+        rts::context ctx;
+        install_parser_service(ctx, {});
+        install_serializer_service(ctx, {});
+
+        connection_buffers cb(ctx);
+        request_parser& pr = cb.parser();
+        serializer& sr = cb.serializer();
+
+        core::string_view const req =
+            "GET / HTTP/1.1\r\n"
+            "Host: example.com\r\n"
+            "\r\n";
+        pr.reset();
+        pr.start();
+        auto const mb = *pr.prepare().begin();
+        BOOST_TEST_GE(mb.size(), req.size());
+        std::memcpy(mb.data(), req.data(), req.size());
+        pr.commit(req.size());
+        system::error_code ec;
+        pr.parse(ec);
+        BOOST_TEST(! ec);
+        BOOST_TEST(pr.is_complete());
+        BOOST_TEST_EQ(pr.get().target(), "/");
+
+        response res;
+        res.set_content_length(5);
+        sr.start(res, buffers::const_buffer("hello", 5));
+        std::string out;
+        while(! sr.is_done())
+        {
+            auto const cbs = sr.prepare().value();
+            auto const n = buffers::size(cbs);
+            auto const pos = out.size();
+            out.resize(pos + n);
+            buffers::copy(
+                buffers::mutable_buffer(&out[pos], n), cbs);
+            sr.consume(n);
+        }
+        BOOST_TEST_EQ(out,
+            "HTTP/1.1 200 OK\r\n"
+            "Content-Length: 5\r\n"
+            "\r\n"
+            "hello");
+    }
+
+    void
+    run()
+    {
+        testStorage();
+        testExchange();
+    }
+};
+
+TEST_SUITE(
+    connection_buffers_test,
+    "boost.http_proto.connection_buffers");
+
+} // http_proto
+} // boost
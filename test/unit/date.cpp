@@ -0,0 +1,148 @@
+//
+// Copyright (c) 2025 Mohammad Nejati
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+// Test that header file is self-contained.
+#include <boost/http_proto/date.hpp>
+
+#include <boost/http_proto/response_template.hpp>
+
+#include "src/detail/date_cache.hpp"
+
+#include <chrono>
+#include <ctime>
+#include <string>
+#include <thread>
+
+#include "test_suite.hpp"
+
+namespace boost {
+namespace http_proto {
+
+class date_test
+{
+public:
+    void
+    check(
+        std::time_t t,
+        core::string_view s)
+    {
+        char buf[date_size];
+        BOOST_TEST_EQ(format_date(t, buf), s);
+    }
+
+    void
+    testFormat()
+    {
+        check(0, "Thu, 01 Jan 1970 00:00:00 GMT");
+        check(784111777, "Sun, 06 Nov 1994 08:49:37 GMT");
+        check(951782400, "Tue, 29 Feb 2000 00:00:00 GMT");
+        check(1234567890, "Fri, 13 Feb 2009 23:31:30 GMT");
+
+        // clamped
+        check(-1, "Thu, 01 Jan 1970 00:00:00 GMT");
+
+        if(sizeof(std::time_t) > 4)
+        {
+            check(static_cast<std::time_t>(
+                4107542399), "Sun, 28 Feb 2100 23:59:59 GMT");
+            check(static_cast<std::time_t>(
+                4107542400), "Mon, 01 Mar 2100 00:00:00 GMT");
+
+            // clamped
+            check(static_cast<std::time_t>(
+                253402300800), "Fri, 31 Dec 9999 23:59:59 GMT");
+        }
+    }
+
+    void
+    testCurrent()
+    {
+        char buf[date_size];
+        auto const t0 = std::time(nullptr);
+        auto const s = current_date();
+        auto const t1 = std::time(nullptr);
+        BOOST_TEST_EQ(s.size(), date_size);
+        BOOST_TEST(
+            s == format_date(t0, buf) ||
+            s == format_date(t1, buf));
+
+        // the value changes with the clock
+        std::string const s0(s);
+        auto const deadline = std::chrono::steady_clock::now() +
+            std::chrono::seconds(3);
+        while(std::time(nullptr) == t1 &&
+            std::chrono::steady_clock::now() < deadline)
+            std::this_thread::sleep_for(
+                std::chrono::milliseconds(10));
+        BOOST_TEST_NE(current_date(), s0);
+    }
+
+    void
+    testCache()
+    {
+        char buf[date_size];
+        detail::date_cache c;
+        detail::date_cache::local l1;
+        detail::date_cache::local l2;
+        BOOST_TEST_EQ(c.formats(), 0u);
+
+        auto const s1 = c.get(784111777, l1);
+        BOOST_TEST_EQ(s1, format_date(784111777, buf));
+        BOOST_TEST_EQ(c.formats(), 1u);
+
+        // same second, same thread
+        std::string const v1(s1);
+        BOOST_TEST_EQ(c.get(784111777, l1), v1);
+        BOOST_TEST_EQ(c.formats(), 1u);
+
+        // same second, another thread copies
+        BOOST_TEST_EQ(c.get(784111777, l2), v1);
+        BOOST_TEST_EQ(c.formats(), 1u);
+
+        // the clock advances
+        auto const s2 = c.get(784111778, l1);
+        BOOST_TEST_EQ(s2, "Sun, 06 Nov 1994 08:49:38 GMT");
+        BOOST_TEST_NE(s2, v1);
+        BOOST_TEST_EQ(c.formats(), 2u);
+        BOOST_TEST_EQ(c.get(784111778, l2), s2);
+        BOOST_TEST_EQ(c.formats(), 2u);
+    }
+
+    void
+    testTemplate()
+    {
+        response_template rt(response(status::ok));
+        BOOST_TEST_THROWS(
+            rt.set_date(), std::logic_error);
+
+        rt.add_slot(field::date, date_size);
+        rt.set_date();
+        BOOST_TEST_EQ(
+            rt.message().at(field::date).size(),
+            date_size);
+        BOOST_TEST(
+            rt.message().at(field::date).ends_with(" GMT"));
+    }
+
+    void
+    run()
+    {
+        testFormat();
+        testCurrent();
+        testCache();
+        testTemplate();
+    }
+};
+
+TEST_SUITE(
+    date_test,
+    "boost.http_proto.date");
+
+} // http_proto
+} // boost
@@ -0,0 +1,135 @@
+//
+// Copyright (c) 2025 Mohammad Nejati
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+// Test that header file is self-contained.
+#include "src/detail/compression_budget.hpp"
+
+#include <boost/http_proto/serializer.hpp>
+
+#include "test_suite.hpp"
+
+namespace boost {
+namespace http_proto {
+namespace detail {
+
+struct compression_budget_test
+{
+    using clock = compression_budget::clock;
+    using ms = std::chrono::milliseconds;
+
+    void
+    testDrop()
+    {
+        serializer::config cfg;
+        cfg.compression_time_budget =
+            std::chrono::milliseconds(10);
+        compression_budget b(cfg.compression_time_budget);
+        BOOST_TEST_EQ(b.level_drop(), 0);
+
+        // opens the first window
+        auto t = clock::time_point(std::chrono::hours(1));
+        b.on_compress_time(ms(0), t);
+        BOOST_TEST_EQ(b.level_drop(), 0);
+
+        // over budget
+        b.on_compress_time(ms(15), t + ms(500));
+        BOOST_TEST_EQ(b.level_drop(), 0);
+        t += std::chrono::seconds(1);
+        b.on_compress_time(ms(15), t);
+        BOOST_TEST_EQ(b.level_drop(), 1);
+        t += std::chrono::seconds(1);
+        b.on_compress_time(ms(0), t);
+        BOOST_TEST_EQ(b.level_drop(), 2);
+
+        // within budget, above half
+        b.on_compress_time(ms(7), t + ms(500));
+        t += std::chrono::seconds(1);
+        b.on_compress_time(ms(0), t);
+        BOOST_TEST_EQ(b.level_drop(), 2);
+
+        // below half of the budget
+        b.on_compress_time(ms(2), t + ms(500));
+        t += std::chrono::seconds(1);
+        b.on_compress_time(ms(0), t);
+        BOOST_TEST_EQ(b.level_drop(), 1);
+    }
+
+    void
+    testLimit()
+    {
+        compression_budget b(ms(1));
+        auto t = clock::time_point(std::chrono::hours(1));
+        b.on_compress_time(ms(0), t);
+        for(int i = 0; i < 20; ++i)
+        {
+            t += std::chrono::seconds(1);
+            b.on_compress_time(ms(100), t);
+        }
+        BOOST_TEST_EQ(
+            b.level_drop(),
+            compression_budget::max_level_drop);
+    }
+
+    void
+    testIdle()
+    {
+        compression_budget b(ms(10));
+        auto t = clock::time_point(std::chrono::hours(1));
+        b.on_compress_time(ms(0), t);
+        t += std::chrono::seconds(1);
+        b.on_compress_time(ms(50), t);
+        t += std::chrono::seconds(1);
+        b.on_compress_time(ms(0), t);
+        BOOST_TEST_EQ(b.level_drop(), 1);
+
+        // no recovery without compression
+        t += std::chrono::minutes(1);
+        BOOST_TEST_EQ(b.level_drop(), 1);
+
+        // the first report closes an idle window
+        b.on_compress_time(ms(0), t);
+        BOOST_TEST_EQ(b.level_drop(), 0);
+    }
+
+    void
+    testLongWindow()
+    {
+        // a window longer than a second
+        // is normalized to its length
+        compression_budget b(ms(10));
+        auto t = clock::time_point(std::chrono::hours(1));
+        b.on_compress_time(ms(0), t);
+        b.on_compress_time(ms(30), t + ms(100));
+        t += std::chrono::seconds(4);
+        b.on_compress_time(ms(0), t);
+        BOOST_TEST_EQ(b.level_drop(), 0);
+
+        b.on_compress_time(ms(30), t + ms(100));
+        t += std::chrono::seconds(2);
+        b.on_compress_time(ms(0), t);
+        BOOST_TEST_EQ(b.level_drop(), 1);
+    }
+
+    void
+    run()
+    {
+        testDrop();
+        testLimit();
+        testIdle();
+        testLongWindow();
+    }
+};
+
+TEST_SUITE(
+    compression_budget_test,
+    "boost.http_proto.detail.compression_budget");
+
+} // detail
+} // http_proto
+} // boost
@@ -0,0 +1,409 @@
+//
+// Copyright (c) 2025 Mohammad Nejati
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+// Test that header file is self-contained.
+#include <boost/http_proto/edit_batch.hpp>
+
+#include <boost/http_proto/fields.hpp>
+#include <boost/http_proto/request.hpp>
+#include <boost/http_proto/response.hpp>
+#include <boost/http_proto/small_response.hpp>
+#include <boost/system/system_error.hpp>
+
+#include "test_helpers.hpp"
+#include "test_suite.hpp"
+
+#include <string>
+
+namespace boost {
+namespace http_proto {
+
+struct edit_batch_test
+{
+    static
+    void
+    check_metadata(
+        message_base const& m0,
+        message_base const& m1)
+    {
+        auto const& md0 = m0.metadata();
+        auto const& md1 = m1.metadata();
+        BOOST_TEST_EQ(
+            md0.connection.count, md1.connection.count);
+        BOOST_TEST_EQ(
+            md0.connection.ec, md1.connection.ec);
+        BOOST_TEST_EQ(
+            md0.connection.close, md1.connection.close);
+        BOOST_TEST_EQ(
+            md0.connection.keep_alive, md1.connection.keep_alive);
+        BOOST_TEST_EQ(
+            md0.content_encoding.count, md1.content_encoding.count);
+        BOOST_TEST(
+            md0.content_encoding.coding == md1.content_encoding.coding);
+        BOOST_TEST_EQ(
+            md0.content_length.count, md1.content_length.count);
+        BOOST_TEST_EQ(
+            md0.content_length.ec, md1.content_length.ec);
+        BOOST_TEST_EQ(
+            md0.content_length.value, md1.content_length.value);
+        BOOST_TEST_EQ(
+            md0.expect.count, md1.expect.count);
+        BOOST_TEST_EQ(
+            md0.transfer_encoding.count, md1.transfer_encoding.count);
+        BOOST_TEST_EQ(
+            md0.transfer_encoding.is_chunked,
+            md1.transfer_encoding.is_chunked);
+        BOOST_TEST_EQ(
+            md0.upgrade.count, md1.upgrade.count);
+        BOOST_TEST(m0.payload() == m1.payload());
+        if(m0.payload() == payload::size)
+            BOOST_TEST_EQ(
+                m0.payload_size(), m1.payload_size());
+        BOOST_TEST_EQ(m0.keep_alive(), m1.keep_alive());
+    }
+
+    // The batch must produce the same message
+    // as the equivalent single calls.
+    template<class Message>
+    static
+    void
+    check(
+        core::string_view s,
+        void(*singles)(fields_base&),
+        void(*batch)(edit_batch&))
+    {
+        Message m0(s);
+        Message m1(s);
+        singles(m0);
+        edit_batch b(m1);
+        batch(b);
+        b.commit();
+        BOOST_TEST_EQ(b.size(), 0);
+        BOOST_TEST_EQ(m1.buffer(), m0.buffer());
+        test_fields(m1, m0.buffer());
+    }
+
+    static
+    void
+    check_response(
+        core::string_view s,
+        void(*singles)(fields_base&),
+        void(*batch)(edit_batch&))
+    {
+        check<response>(s, singles, batch);
+
+        response m0(s);
+        response m1(s);
+        singles(m0);
+        edit_batch b(m1);
+        batch(b);
+        b.commit();
+        check_metadata(m0, m1);
+    }
+
+    void
+    testEdits()
+    {
+        core::string_view const res =
+            "HTTP/1.1 200 OK\r\n"
+            "Server: origin\r\n"
+            "Connection: keep-alive\r\n"
+            "Keep-Alive: timeout=5\r\n"
+            "Content-Type: text/plain\r\n"
+            "Transfer-Encoding: chunked\r\n"
+            "X-Internal: 1\r\n"
+            "x-internal: 2\r\n"
+            "\r\n";
+
+        // a typical proxy rewrite
+        check_response(res,
+            [](fields_base& f)
+            {
+                f.erase(field::connection);
+                f.erase(field::keep_alive);
+                f.erase("X-Internal");
+                f.set(field::server, "proxy");
+                f.append(field::via, "1.1 proxy");
+                f.append("X-Cache", "MISS");
+            },
+            [](edit_batch& b)
+            {
+                b.erase(field::connection)
+                 .erase(field::keep_alive)
+                 .erase("X-Internal")
+                 .set(field::server, "proxy")
+                 .append(field::via, "1.1 proxy")
+                 .append("X-Cache", "MISS");
+            });
+
+        // payload changes
+        check_response(res,
+            [](fields_base& f)
+            {
+                f.erase(field::transfer_encoding);
+                f.set(field::content_length, "42");
+                f.set(field::connection, "close");
+            },
+            [](edit_batch& b)
+            {
+                b.erase(field::transfer_encoding)
+                 .set(field::content_length, "42")
+                 .set(field::connection, "close");
+            });
+
+        // later edits apply to earlier ones
+        check_response(res,
+            [](fields_base& f)
+            {
+                f.append(field::content_length, "1");
+                f.append("X-A", "a");
+                f.append(field::content_encoding, "gzip");
+                f.erase("x-a");
+                f.erase(field::content_length);
+                f.append("X-A", "b");
+                f.set(field::content_encoding, "br");
+            },
+            [](edit_batch& b)
+            {
+                b.append(field::content_length, "1")
+                 .append("X-A", "a")
+                 .append(field::content_encoding, "gzip")
+                 .erase("x-a")
+                 .erase(field::content_length)
+                 .append("X-A", "b")
+                 .set(field::content_encoding, "br");
+            });
+
+        // names which are known fields
+        check_response(res,
+            [](fields_base& f)
+            {
+                f.erase("connection");
+                f.append("content-length", "7");
+                f.erase("TRANSFER-ENCODING");
+            },
+            [](edit_batch& b)
+            {
+                b.erase("connection")
+                 .append("content-length", "7")
+                 .erase("TRANSFER-ENCODING");
+            });
+
+        // erase everything
+        check_response(res,
+            [](fields_base& f)
+            {
+                f.erase(field::server);
+                f.erase(field::connection);
+                f.erase(field::keep_alive);
+                f.erase(field::content_type);
+                f.erase(field::transfer_encoding);
+                f.erase("x-internal");
+            },
+            [](edit_batch& b)
+            {
+                b.erase(field::server)
+                 .erase(field::connection)
+                 .erase(field::keep_alive)
+                 .erase(field::content_type)
+                 .erase(field::transfer_encoding)
+                 .erase("x-internal");
+            });
+
+        // whitespace and empty values
+        check_response(res,
+            [](fields_base& f)
+            {
+                f.set(field::server, "  padded\t");
+                f.append("X-Empty", "");
+            },
+            [](edit_batch& b)
+            {
+                b.set(field::server, "  padded\t")
+                 .append("X-Empty", "");
+            });
+
+        // nothing to erase
+        check_response(res,
+            [](fields_base& f)
+            {
+                f.erase(field::age);
+                f.erase("X-Nothing");
+            },
+            [](edit_batch& b)
+            {
+                b.erase(field::age)
+                 .erase("X-Nothing");
+            });
+
+        // requests and fields
+        check<request>(
+            "GET / HTTP/1.1\r\n"
+            "Host: example.com\r\n"
+            "Proxy-Authorization: secret\r\n"
+            "\r\n",
+            [](fields_base& f)
+            {
+                f.erase(field::proxy_authorization);
+                f.append(field::forwarded, "10.0.0.1");
+                f.set(field::host, "backend");
+            },
+            [](edit_batch& b)
+            {
+                b.erase(field::proxy_authorization)
+                 .append(field::forwarded, "10.0.0.1")
+                 .set(field::host, "backend");
+            });
+
+        check<fields>(
+            "\r\n",
+            [](fields_base& f)
+            {
+                f.append(field::host, "example.com");
+                f.append(field::connection, "close");
+                f.erase(field::host);
+            },
+            [](edit_batch& b)
+            {
+                b.append(field::host, "example.com")
+                 .append(field::connection, "close")
+                 .erase(field::host);
+            });
+    }
+
+    void
+    testStorage()
+    {
+        // default container
+        {
+            response res;
+            edit_batch b(res);
+            b.commit();
+            BOOST_TEST_EQ(
+                res.capacity_in_bytes(), 0);
+            b.set(field::server, "test");
+            b.commit();
+            BOOST_TEST_EQ(
+                res.buffer(),
+                "HTTP/1.1 200 OK\r\n"
+                "Server: test\r\n"
+                "\r\n");
+        }
+
+        // edits which fit are made in place
+        {
+            response res;
+            res.reserve_bytes(1024);
+            res.set(field::server, "test");
+            res.set(field::connection, "close");
+            auto const p = res.buffer().data();
+            edit_batch b(res);
+            b.erase(field::server)
+             .set(field::connection, "keep-alive")
+             .append(field::content_length, "10");
+            b.commit();
+            BOOST_TEST(res.buffer().data() == p);
+            BOOST_TEST_EQ(
+                res.buffer(),
+                "HTTP/1.1 200 OK\r\n"
+                "Connection: keep-alive\r\n"
+                "Content-Length: 10\r\n"
+                "\r\n");
+            BOOST_TEST_EQ(res.payload_size(), 10);
+        }
+
+        // growing reallocates once
+        {
+            small_response<64> res;
+            edit_batch b(res);
+            std::string const v(40, 'x');
+            for(int i = 0; i < 16; ++i)
+                b.append("X-Filler", v);
+            b.commit();
+            BOOST_TEST(! res.is_inline());
+            BOOST_TEST_EQ(res.size(), 16);
+        }
+
+        // values which refer to the container
+        {
+            response res;
+            res.reserve_bytes(1024);
+            res.set(field::server, "origin");
+            res.set(field::content_type, "text/plain");
+            edit_batch b(res);
+            b.erase(field::server)
+             .append("X-Server", res.at(field::server))
+             .append("X-Type", res.at(field::content_type));
+            b.commit();
+            BOOST_TEST_EQ(
+                res.buffer(),
+                "HTTP/1.1 200 OK\r\n"
+                "Content-Type: text/plain\r\n"
+                "X-Server: origin\r\n"
+                "X-Type: text/plain\r\n"
+                "\r\n");
+        }
+    }
+
+    void
+    testErrors()
+    {
+        core::string_view const cs =
+            "HTTP/1.1 200 OK\r\n"
+            "Server: test\r\n"
+            "\r\n";
+
+        // invalid input leaves the container unchanged
+        {
+            response res(cs);
+            edit_batch b(res);
+            b.erase(field::server)
+             .append("bad name", "x");
+            BOOST_TEST_THROWS(
+                b.commit(), system::system_error);
+            BOOST_TEST_EQ(res.buffer(), cs);
+            BOOST_TEST_EQ(b.size(), 2);
+
+            b.clear();
+            b.erase(field::server)
+             .set(field::via, "a\r\nb");
+            system::error_code ec;
+            b.commit(ec);
+            BOOST_TEST(ec.failed());
+            BOOST_TEST_EQ(res.buffer(), cs);
+        }
+
+        // max capacity
+        {
+            response res(cs);
+            res.set_max_capacity_in_bytes(
+                res.capacity_in_bytes());
+            edit_batch b(res);
+            b.append("X-Filler", std::string(200, 'x'));
+            BOOST_TEST_THROWS(
+                b.commit(), std::length_error);
+            BOOST_TEST_EQ(res.buffer(), cs);
+        }
+    }
+
+    void
+    run()
+    {
+        testEdits();
+        testStorage();
+        testErrors();
+    }
+};
+
+TEST_SUITE(
+    edit_batch_test,
+    "boost.http_proto.edit_batch");
+
+} // http_proto
+} // boost
@@ -11,10 +11,16 @@
 #include <boost/http_proto/field.hpp>
 
 #include <boost/http_proto/detail/sv.hpp>
+#include <boost/http_proto/field_registry.hpp>
+#include <boost/http_proto/request_parser.hpp>
+#include <boost/rts/context.hpp>
 #include <boost/url/grammar/ci_string.hpp>
 
 #include "test_suite.hpp"
 
+#include <cstring>
+#include <stdexcept>
+
 namespace boost {
 namespace http_proto {
 
@@ -403,9 +409,103 @@ public:
         unknown("x");
     }
 
+    void
+    testRegister()
+    {
+        rts::context ctx;
+
+        // nothing registered
+        BOOST_TEST(! string_to_field(
+            ctx, "X-Request-Id").has_value());
+        BOOST_TEST(string_to_field(
+            ctx, "accept") == field::accept);
+
+        auto const request_id =
+            register_field(ctx, "X-Request-Id");
+        auto const tenant =
+            register_field(ctx, "X-Tenant");
+        BOOST_TEST(request_id != tenant);
+        BOOST_TEST(static_cast<unsigned>(request_id) >
+            static_cast<unsigned>(field::xref));
+
+        // registering again gives the same id
+        BOOST_TEST(register_field(
+            ctx, "x-request-id") == request_id);
+        BOOST_TEST(register_field(
+            ctx, "Accept") == field::accept);
+
+        BOOST_TEST(string_to_field(
+            ctx, "X-REQUEST-ID") == request_id);
+        BOOST_TEST(string_to_field(
+            ctx, "x-tenant") == tenant);
+        BOOST_TEST(string_to_field(
+            ctx, "user-agent") == field::user_agent);
+        BOOST_TEST(! string_to_field(
+            ctx, "X-Other").has_value());
+        BOOST_TEST(! string_to_field(
+            "X-Request-Id").has_value());
+
+        BOOST_TEST_EQ(
+            to_string(ctx, request_id), "X-Request-Id");
+        BOOST_TEST_EQ(
+            to_string(ctx, field::accept), "Accept");
+        BOOST_TEST_THROWS(
+            to_string(ctx, static_cast<field>(0xffff)),
+            std::invalid_argument);
+        BOOST_TEST_THROWS(
+            register_field(ctx, "bad name"),
+            std::invalid_argument);
+        BOOST_TEST_THROWS(
+            register_field(ctx, ""),
+            std::invalid_argument);
+
+        // parsers store the registered ids
+        install_parser_service(
+            ctx, request_parser::config());
+        request_parser pr(ctx);
+        pr.reset();
+        pr.start();
+        core::string_view const s =
+            "GET / HTTP/1.1\r\n"
+            "Host: example.com\r\n"
+            "x-request-id: 1234\r\n"
+            "X-Tenant: acme\r\n"
+            "X-Other: 1\r\n"
+            "X-Request-Id: 5678\r\n"
+            "\r\n";
+        auto const b = *pr.prepare().begin();
+        BOOST_TEST(b.size() >= s.size());
+        std::memcpy(b.data(), s.data(), s.size());
+        pr.commit(s.size());
+        system::error_code ec;
+        pr.parse(ec);
+        BOOST_TEST(! ec.failed());
+
+        auto const& req = pr.get();
+        BOOST_TEST_EQ(req.count(request_id), 2);
+        BOOST_TEST_EQ(req.find(request_id)->value, "1234");
+        BOOST_TEST(req.find(request_id)->id == request_id);
+        BOOST_TEST_EQ(req.find(tenant)->value, "acme");
+        BOOST_TEST(! req.find("X-Other")->id.has_value());
+
+        // lookups by name still work
+        BOOST_TEST_EQ(req.count("X-Request-Id"), 2);
+        BOOST_TEST_EQ(req.at("x-tenant"), "acme");
+
+        // a copy keeps the ids, and modifiers
+        // by name see every field of that name
+        request r(req);
+        r.append("X-Request-Id", "9");
+        BOOST_TEST_EQ(r.count(request_id), 2);
+        BOOST_TEST_EQ(r.count("X-Request-Id"), 3);
+        BOOST_TEST_EQ(r.erase("X-REQUEST-ID"), 3);
+        BOOST_TEST(r.find(request_id) == r.end());
+    }
+
     void run()
     {
         testField();
+        testRegister();
     }
 };
 
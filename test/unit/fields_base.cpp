@@ -22,7 +22,9 @@
 #include "test_helpers.hpp"
 #include "test_suite.hpp"
 
+#include <iterator>
 #include <stdexcept>
+#include <string>
 #include <vector>
 
 namespace boost {
@@ -1721,6 +1723,106 @@ struct fields_base_test
     {
     }
 
+    void
+    testNameIndex()
+    {
+        // lookups in containers large enough
+        // to be indexed agree with a linear search
+        auto const check_find = [](
+            fields_base const& f)
+        {
+            for(auto it = f.begin(); it != f.end(); ++it)
+                BOOST_TEST(f.find(it->name) ==
+                    f.find(f.begin(), it->name));
+            BOOST_TEST(f.find("x-missing") == f.end());
+        };
+
+        fields f;
+        for(int i = 0; i < 64; ++i)
+            f.append(
+                "X-Field-" + std::to_string(i % 40),
+                std::to_string(i));
+        check_find(f);
+        BOOST_TEST_EQ(f.at("x-field-3"), "3");
+        BOOST_TEST_EQ(f.count("X-FIELD-3"), 2);
+
+        // insert before the first of a name
+        f.insert(f.begin(), "x-FIELD-7", "first");
+        BOOST_TEST_EQ(f.at("X-Field-7"), "first");
+        check_find(f);
+
+        // erase the first of a name
+        f.erase(f.begin());
+        BOOST_TEST_EQ(f.at("X-Field-7"), "7");
+        check_find(f);
+
+        // erase all of a name
+        BOOST_TEST_EQ(f.erase("X-Field-7"), 2);
+        BOOST_TEST(! f.exists("x-field-7"));
+        check_find(f);
+
+        // set moves the name to the end
+        f.set("X-Field-8", "new");
+        BOOST_TEST_EQ(f.at("X-Field-8"), "new");
+        BOOST_TEST(f.find("X-Field-8") ==
+            std::prev(f.end()));
+        check_find(f);
+
+        // erase in the middle
+        {
+            auto it = f.find("X-Field-20");
+            while(it != f.end())
+            {
+                it = f.erase(it);
+                if(it != f.end())
+                    ++it;
+            }
+            check_find(f);
+        }
+
+        // copies
+        {
+            fields f1(f);
+            check_find(f1);
+            fields f2;
+            f2 = f;
+            check_find(f2);
+            fields f3;
+            f3.swap(f1);
+            check_find(f3);
+        }
+
+        // erase down to empty
+        while(f.size() > 0)
+        {
+            f.erase(f.begin());
+            check_find(f);
+        }
+        BOOST_TEST(f.find("X-Field-1") == f.end());
+
+        // reuse after clear
+        for(int i = 0; i < 40; ++i)
+            f.append(
+                "X-Other-" + std::to_string(i), "v");
+        f.clear();
+        BOOST_TEST(f.find("X-Other-1") == f.end());
+        f.append("X-Other-1", "w");
+        BOOST_TEST_EQ(f.at("x-other-1"), "w");
+
+        // parsed messages
+        {
+            std::string s =
+                "GET / HTTP/1.1\r\n";
+            for(int i = 0; i < 50; ++i)
+                s += "X-Trace-" + std::to_string(i) +
+                    ": " + std::to_string(i) + "\r\n";
+            s += "\r\n";
+            request req(s);
+            check_find(req);
+            BOOST_TEST_EQ(req.at("x-trace-42"), "42");
+        }
+    }
+
     void
     run()
     {
@@ -1734,6 +1836,7 @@ struct fields_base_test
         testObservers();
         testStream();
         testSubrange();
+        testNameIndex();
     }
 };
 
@@ -0,0 +1,231 @@
+//
+// Copyright (c) 2025 Mohammad Nejati
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+// Test that header file is self-contained.
+#include <boost/http_proto/file_cache.hpp>
+
+#include <boost/http_proto/file_source.hpp>
+#include <boost/buffers/make_buffer.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/system/system_error.hpp>
+#include <cstdio>
+#include <fstream>
+
+#include "test_suite.hpp"
+
+namespace boost {
+namespace http_proto {
+
+struct file_cache_test
+{
+    class temp_path
+    {
+        std::string path_;
+
+    public:
+        temp_path()
+            // filesystem::path::string() fails on older
+            // versions of mingw when rtti is off
+            : path_(filesystem::unique_path().string())
+        {
+        }
+
+        operator char const*() const noexcept
+        {
+            return path_.c_str();
+        }
+
+        core::string_view
+        str() const noexcept
+        {
+            return path_;
+        }
+
+        ~temp_path()
+        {
+            filesystem::remove(path_);
+        }
+    };
+
+    void
+    write_file(
+        temp_path const& path,
+        core::string_view content)
+    {
+        std::ofstream ofs(path);
+        ofs << content;
+    }
+
+    void
+    testOpen()
+    {
+        temp_path path;
+        write_file(path, "Hello, World!");
+
+        file_cache cache({});
+        BOOST_TEST_EQ(cache.size(), 0);
+
+        system::error_code ec;
+        auto e1 = cache.open(path.str(), ec);
+        BOOST_TEST(!ec);
+        BOOST_TEST(e1);
+        BOOST_TEST(e1->f.is_open());
+        BOOST_TEST_EQ(e1->size, 13);
+        BOOST_TEST_EQ(cache.size(), 1);
+
+        // the same entry is returned
+        auto e2 = cache.open(path.str());
+        BOOST_TEST(e1 == e2);
+        BOOST_TEST_EQ(cache.size(), 1);
+
+        // missing file
+        temp_path missing;
+        auto e3 = cache.open(
+            missing.str(), ec);
+        BOOST_TEST(ec.failed());
+        BOOST_TEST(!e3);
+        BOOST_TEST_EQ(cache.size(), 1);
+        BOOST_TEST_THROWS(
+            cache.open(missing.str()),
+            system::system_error);
+
+        // entries stay open while in use
+        cache.erase(path.str());
+        BOOST_TEST_EQ(cache.size(), 0);
+        BOOST_TEST(e1->f.is_open());
+        auto e4 = cache.open(path.str());
+        BOOST_TEST(e4 != e1);
+
+        cache.clear();
+        BOOST_TEST_EQ(cache.size(), 0);
+    }
+
+    void
+    testEviction()
+    {
+        temp_path p1;
+        temp_path p2;
+        temp_path p3;
+        write_file(p1, "1");
+        write_file(p2, "22");
+        write_file(p3, "333");
+
+        file_cache::config cfg;
+        cfg.max_files = 2;
+        file_cache cache(cfg);
+
+        auto e1 = cache.open(p1.str());
+        auto e2 = cache.open(p2.str());
+        // p1 becomes the most recently used
+        BOOST_TEST(cache.open(p1.str()) == e1);
+        auto e3 = cache.open(p3.str());
+        BOOST_TEST_EQ(cache.size(), 2);
+
+        // p2 was evicted
+        BOOST_TEST(cache.open(p1.str()) == e1);
+        BOOST_TEST(cache.open(p3.str()) == e3);
+        BOOST_TEST(cache.open(p2.str()) != e2);
+        BOOST_TEST_EQ(cache.size(), 2);
+    }
+
+    void
+    testInvalidate()
+    {
+        // Windows does not allow writing or
+        // removing a file which is open for reading
+#ifndef _WIN32
+        temp_path path;
+        write_file(path, "Hello");
+
+        // checked on every open
+        {
+            file_cache::config cfg;
+            cfg.check_interval = std::chrono::milliseconds(0);
+            file_cache cache(cfg);
+
+            auto e1 = cache.open(path.str());
+            BOOST_TEST_EQ(e1->size, 5);
+            BOOST_TEST(cache.open(path.str()) == e1);
+
+            write_file(path, "Hello, World!");
+            auto e2 = cache.open(path.str());
+            BOOST_TEST(e2 != e1);
+            BOOST_TEST_EQ(e2->size, 13);
+            BOOST_TEST_EQ(cache.size(), 1);
+
+            // removed files leave the cache
+            std::remove(path);
+            system::error_code ec;
+            BOOST_TEST(!cache.open(
+                path.str(), ec));
+            BOOST_TEST(ec.failed());
+            BOOST_TEST_EQ(cache.size(), 0);
+        }
+
+        // not checked within the interval
+        {
+            write_file(path, "Hello");
+            file_cache::config cfg;
+            cfg.check_interval = std::chrono::hours(1);
+            file_cache cache(cfg);
+
+            auto e1 = cache.open(path.str());
+            write_file(path, "Hello, World!");
+            BOOST_TEST(cache.open(path.str()) == e1);
+        }
+#endif
+    }
+
+    void
+    testFileSource()
+    {
+        temp_path path;
+        write_file(path, "Hello, World!");
+
+        file_cache cache({});
+        auto e = cache.open(path.str());
+
+        file_source s1(e);
+        file_source s2(e, 7, 5);
+        cache.clear();
+
+        char buf[16] = {};
+        auto rs = s1.read(
+            buffers::make_buffer(buf));
+        BOOST_TEST(!rs.ec);
+        BOOST_TEST(rs.finished);
+        BOOST_TEST_EQ(
+            core::string_view(buf, rs.bytes),
+            "Hello, World!");
+
+        rs = s2.read(
+            buffers::make_buffer(buf));
+        BOOST_TEST(!rs.ec);
+        BOOST_TEST(rs.finished);
+        BOOST_TEST_EQ(
+            core::string_view(buf, rs.bytes),
+            "World");
+    }
+
+    void
+    run()
+    {
+        testOpen();
+        testEviction();
+        testInvalidate();
+        testFileSource();
+    }
+};
+
+TEST_SUITE(
+    file_cache_test,
+    "boost.http_proto.file_cache");
+
+} // http_proto
+} // boost
@@ -11,6 +11,7 @@
 #include <boost/http_proto/file_sink.hpp>
 
 #include <boost/filesystem.hpp>
+#include <algorithm>
 #include <fstream>
 
 #include "test_suite.hpp"
@@ -93,11 +94,82 @@ struct file_sink_test
             "Hello, World!");
     }
 
+    void
+    testConfig()
+    {
+        std::string body;
+        for(std::size_t i = 0; i < 10000; ++i)
+            body.push_back(char('a' + i % 26));
+
+        auto const test =
+            [&](file_sink::config const& cfg)
+        {
+            temp_path path;
+            file f;
+            f.open(path, file_mode::write);
+            file_sink fsink(std::move(f), cfg);
+
+            std::size_t i = 0;
+            while(i < body.size())
+            {
+                auto const n = (std::min)(
+                    std::size_t(3000), body.size() - i);
+                buffers::const_buffer cb(
+                    body.data() + i, n);
+                i += n;
+                auto rs = fsink.write(
+                    cb, i < body.size());
+                BOOST_TEST_EQ(rs.bytes, n);
+                BOOST_TEST(!rs.ec);
+                // a partial block
+                if(i == 3000)
+                    fsink.flush();
+            }
+            BOOST_TEST(read_file(path) == body);
+        };
+
+        file_sink::config cfg;
+        test(cfg);
+
+        cfg.size = body.size();
+        cfg.block_size = 4096;
+        test(cfg);
+
+        cfg.block_size = 0;
+        test(cfg);
+
+        cfg.block_size = 100;
+        cfg.sync = file_sink::sync_mode::at_end;
+        test(cfg);
+
+        cfg.direct = true;
+        cfg.sync = file_sink::sync_mode::interval;
+        cfg.sync_interval = std::chrono::milliseconds(0);
+        test(cfg);
+
+        // an incomplete body is kept
+        {
+            temp_path path;
+            {
+                file f;
+                f.open(path, file_mode::write);
+                file_sink fsink(std::move(f), {});
+                buffers::const_buffer cb("Hello", 5);
+                auto rs = fsink.write(cb, true);
+                BOOST_TEST_EQ(rs.bytes, 5);
+                BOOST_TEST(!rs.ec);
+                BOOST_TEST_EQ(read_file(path), "");
+            }
+            BOOST_TEST_EQ(read_file(path), "Hello");
+        }
+    }
+
     void
     run()
     {
         testReportErros();
         testWrite();
+        testConfig();
     }
 };
 
@@ -12,6 +12,7 @@
 
 #include <boost/buffers/make_buffer.hpp>
 #include <boost/filesystem.hpp>
+#include <array>
 #include <fstream>
 
 #include "test_suite.hpp"
@@ -133,12 +134,159 @@ struct file_source_test
         }
     }
 
+    void
+    testMapped()
+    {
+        // read
+        {
+            temp_path path;
+            write_file(path, "Hello, World!");
+            file f;
+            system::error_code ec;
+            f.open(path, file_mode::scan, ec);
+            BOOST_TEST(!ec);
+            file_source fsource(
+                std::move(f), std::uint64_t(-1), true);
+            char buf[8] = {};
+            auto rs = fsource.read(
+                buffers::make_buffer(buf));
+            BOOST_TEST_EQ(rs.bytes, 8);
+            BOOST_TEST(!rs.ec);
+            BOOST_TEST(!rs.finished);
+            BOOST_TEST_EQ(
+                core::string_view(buf, 8),
+                "Hello, W");
+            rs = fsource.read(
+                buffers::make_buffer(buf));
+            BOOST_TEST_EQ(rs.bytes, 5);
+            BOOST_TEST(!rs.ec);
+            BOOST_TEST(rs.finished);
+            BOOST_TEST_EQ(
+                core::string_view(buf, 5),
+                "orld!");
+        }
+
+        // borrow
+        {
+            temp_path path;
+            write_file(path, "Hello, World!");
+            file f;
+            system::error_code ec;
+            f.open(path, file_mode::scan, ec);
+            BOOST_TEST(!ec);
+            f.seek(7, ec);
+            BOOST_TEST(!ec);
+            file_source fsource(
+                std::move(f), 5, true);
+#if BOOST_HTTP_PROTO_USE_POSIX_FILE
+            BOOST_TEST(fsource.can_borrow());
+            buffers::const_buffer b;
+            auto rs = fsource.borrow(b);
+            BOOST_TEST(!rs.ec);
+            BOOST_TEST(rs.finished);
+            BOOST_TEST_EQ(rs.bytes, 5);
+            BOOST_TEST_EQ(
+                core::string_view(
+                    static_cast<char const*>(b.data()),
+                    b.size()),
+                "World");
+            fsource.release(2);
+            fsource.release(3);
+            // still valid while the source lives
+            file_source moved(std::move(fsource));
+            BOOST_TEST_EQ(
+                core::string_view(
+                    static_cast<char const*>(b.data()),
+                    b.size()),
+                "World");
+#else
+            BOOST_TEST(!fsource.can_borrow());
+#endif
+        }
+
+        // empty file is read as usual
+        {
+            temp_path path;
+            write_file(path, "");
+            file f;
+            system::error_code ec;
+            f.open(path, file_mode::scan, ec);
+            BOOST_TEST(!ec);
+            file_source fsource(
+                std::move(f), std::uint64_t(-1), true);
+            BOOST_TEST(!fsource.can_borrow());
+            char buf[8] = {};
+            auto rs = fsource.read(
+                buffers::make_buffer(buf));
+            BOOST_TEST_EQ(rs.bytes, 0);
+            BOOST_TEST(rs.finished);
+        }
+    }
+
+    void
+    testRange()
+    {
+        temp_path path;
+        write_file(path, "Hello, World!");
+        file f;
+        system::error_code ec;
+        f.open(path, file_mode::read, ec);
+        BOOST_TEST(!ec);
+
+        // sources sharing one file
+        file_source s1(f, 7, 5);
+        file_source s2(f, 0, 5);
+        char buf[8] = {};
+        auto rs = s1.read(
+            buffers::mutable_buffer(buf, 3));
+        BOOST_TEST_EQ(rs.bytes, 3);
+        BOOST_TEST(!rs.ec);
+        BOOST_TEST(!rs.finished);
+        BOOST_TEST_EQ(
+            core::string_view(buf, 3), "Wor");
+        rs = s2.read(
+            buffers::make_buffer(buf));
+        BOOST_TEST_EQ(rs.bytes, 5);
+        BOOST_TEST(!rs.ec);
+        BOOST_TEST(rs.finished);
+        BOOST_TEST_EQ(
+            core::string_view(buf, 5), "Hello");
+
+        // vectored
+        std::array<buffers::mutable_buffer, 2> mbs = {{
+            { buf, 1 },
+            { buf + 1, 4 } }};
+        rs = s1.read(mbs);
+        BOOST_TEST_EQ(rs.bytes, 2);
+        BOOST_TEST(!rs.ec);
+        BOOST_TEST(rs.finished);
+        BOOST_TEST_EQ(
+            core::string_view(buf, 2), "ld");
+
+        // range past the end of the file
+        file_source s3(f, 10, 100);
+        rs = s3.read(
+            buffers::make_buffer(buf));
+        BOOST_TEST_EQ(rs.bytes, 3);
+        BOOST_TEST(!rs.ec);
+        BOOST_TEST(rs.finished);
+        BOOST_TEST_EQ(
+            core::string_view(buf, 3), "ld!");
+
+#if BOOST_HTTP_PROTO_USE_POSIX_FILE
+        // the position is left alone
+        BOOST_TEST(f.pos() == 0);
+#endif
+    }
+
     void
     run()
     {
         testReportErros();
         testRead();
         testBoundedRead();
+        testMapped();
+        testRange();
     }
 };
 
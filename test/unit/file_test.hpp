@@ -11,6 +11,7 @@
 #define BOOST_HTTP_PROTO_FILE_TEST_HPP
 
 #include <boost/http_proto/file_mode.hpp>
+#include <boost/buffers/buffer.hpp>
 #include <boost/config.hpp>
 #include <boost/core/detail/string_view.hpp>
 #include <boost/filesystem/path.hpp>
@@ -168,6 +169,18 @@ test_file()
             BOOST_TEST(ec ==
                 system::errc::bad_file_descriptor);
         }
+        {
+            system::error_code ec;
+            f.allocate(1, ec);
+            BOOST_TEST(ec ==
+                system::errc::bad_file_descriptor);
+        }
+        {
+            system::error_code ec;
+            f.sync(ec);
+            BOOST_TEST(ec ==
+                system::errc::bad_file_descriptor);
+        }
     }
 
     // file_mode::read
@@ -457,6 +470,100 @@ test_file()
             BOOST_TEST(! ec);
             BOOST_TEST(pos == 4);
         }
+
+        // positional
+        {
+            File f;
+            system::error_code ec;
+            f.open(path, file_mode::write, ec);
+            BOOST_TEST(! ec);
+
+            auto n = f.write_at(7, "world!", 6, ec);
+            BOOST_TEST(! ec);
+            BOOST_TEST(n == 6);
+            n = f.write_at(0, "Hello, ", 7, ec);
+            BOOST_TEST(! ec);
+            BOOST_TEST(n == 7);
+
+            std::string buf;
+            buf.resize(5);
+            n = f.read_at(7, &buf[0], buf.size(), ec);
+            BOOST_TEST(! ec);
+            BOOST_TEST(n == 5);
+            BOOST_TEST(buf == "world");
+
+            // short read at the end
+            n = f.read_at(10, &buf[0], buf.size(), ec);
+            BOOST_TEST(! ec);
+            BOOST_TEST(n == 3);
+
+            // vectored
+            char b0[5];
+            char b1[8];
+            buffers::mutable_buffer const mbs[] = {
+                { b0, sizeof(b0) },
+                {},
+                { b1, sizeof(b1) } };
+            n = f.read_at(0, mbs, ec);
+            BOOST_TEST(! ec);
+            BOOST_TEST(n == 13);
+            BOOST_TEST(core::string_view(b0, 5) == "Hello");
+            BOOST_TEST(core::string_view(b1, 8) == ", world!");
+
+            buffers::const_buffer const cbs[] = {
+                { "HE", 2 },
+                { "LLO", 3 } };
+            n = f.write_at(0, cbs, ec);
+            BOOST_TEST(! ec);
+            BOOST_TEST(n == 5);
+            n = f.read_at(0, &buf[0], buf.size(), ec);
+            BOOST_TEST(! ec);
+            BOOST_TEST(buf == "HELLO");
+        }
+
+        // allocate and sync
+        {
+            File f;
+            system::error_code ec;
+            f.open(path, file_mode::write, ec);
+            BOOST_TEST(! ec);
+
+            // the size is not changed
+            f.allocate(1024 * 1024, ec);
+            BOOST_TEST(! ec);
+            auto size = f.size(ec);
+            BOOST_TEST(! ec);
+            BOOST_TEST(size == 0);
+
+            f.write(s.data(), s.size(), ec);
+            BOOST_TEST(! ec);
+            f.sync(ec);
+            BOOST_TEST(! ec);
+            size = f.size(ec);
+            BOOST_TEST(! ec);
+            BOOST_TEST(size == s.size());
+        }
+
+        // temporary
+        {
+            File f;
+            system::error_code ec;
+            f.open_temp(nullptr, ec);
+            BOOST_TEST(! ec);
+            BOOST_TEST(f.is_open());
+
+            f.write(s.data(), s.size(), ec);
+            BOOST_TEST(! ec);
+            std::string buf;
+            buf.resize(s.size());
+            auto n = f.read_at(0, &buf[0], buf.size(), ec);
+            BOOST_TEST(! ec);
+            BOOST_TEST(n == s.size());
+            BOOST_TEST(buf == s);
+
+            f.close(ec);
+            BOOST_TEST(! ec);
+        }
         remove(path);
     }
 
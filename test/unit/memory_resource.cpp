@@ -0,0 +1,178 @@
+//
+// Copyright (c) 2025 Mohammad Nejati
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+// Test that header file is self-contained.
+#include <boost/http_proto/memory_resource.hpp>
+
+#include <boost/http_proto/connection_buffers.hpp>
+#include <boost/http_proto/fields.hpp>
+#include <boost/http_proto/request.hpp>
+#include <boost/http_proto/request_parser.hpp>
+#include <boost/http_proto/response.hpp>
+#include <boost/http_proto/serializer.hpp>
+#include <boost/rts/context.hpp>
+
+#include "test_suite.hpp"
+
+#include <new>
+
+namespace boost {
+namespace http_proto {
+
+struct memory_resource_test
+{
+    // Counts the blocks and bytes outstanding
+    class counting_resource : public memory_resource
+    {
+        void*
+        do_allocate(
+            std::size_t n,
+            std::size_t) override
+        {
+            ++allocs;
+            ++blocks;
+            bytes += n;
+            return ::operator new(n);
+        }
+
+        void
+        do_deallocate(
+            void* p,
+            std::size_t n,
+            std::size_t) override
+        {
+            --blocks;
+            bytes -= n;
+            ::operator delete(p);
+        }
+
+        bool
+        do_is_equal(
+            memory_resource const& other) const noexcept override
+        {
+            return this == &other;
+        }
+
+    public:
+        std::size_t allocs = 0;
+        std::size_t blocks = 0;
+        std::size_t bytes = 0;
+    };
+
+    void
+    testContainers()
+    {
+        counting_resource mr;
+        {
+            response res(mr);
+            BOOST_TEST_EQ(mr.allocs, 0);
+            res.set(field::server, "test");
+            BOOST_TEST_EQ(mr.blocks, 1);
+            BOOST_TEST_EQ(mr.bytes, res.capacity_in_bytes());
+
+            res.set(field::content_type, "text/plain");
+            res.reserve_bytes(1024);
+            BOOST_TEST_EQ(mr.blocks, 1);
+            BOOST_TEST_EQ(mr.bytes, res.capacity_in_bytes());
+
+            res.shrink_to_fit();
+            BOOST_TEST_EQ(mr.blocks, 1);
+            BOOST_TEST_EQ(mr.bytes, res.capacity_in_bytes());
+            BOOST_TEST_EQ(
+                res.buffer(),
+                "HTTP/1.1 200 OK\r\n"
+                "Server: test\r\n"
+                "Content-Type: text/plain\r\n"
+                "\r\n");
+
+            // assignment reuses the resource
+            response const other(status::not_found);
+            res = other;
+            BOOST_TEST_EQ(mr.blocks, 1);
+            BOOST_TEST_EQ(res.buffer(), other.buffer());
+
+            // move carries the resource
+            response res2(std::move(res));
+            BOOST_TEST_EQ(mr.blocks, 1);
+            res2.set(field::server, "test");
+            res2.reserve_bytes(4096);
+            BOOST_TEST_EQ(mr.blocks, 1);
+            BOOST_TEST_EQ(mr.bytes, res2.capacity_in_bytes());
+
+            // swap carries the resource
+            response res3;
+            res3.set(field::server, "test");
+            res3.swap(res2);
+            BOOST_TEST_EQ(mr.bytes, res3.capacity_in_bytes());
+        }
+        BOOST_TEST_EQ(mr.blocks, 0);
+        BOOST_TEST_EQ(mr.bytes, 0);
+
+        {
+            request req(mr);
+            req.set_target("/index.html");
+            req.set(field::host, "example.com");
+            BOOST_TEST_EQ(mr.blocks, 1);
+
+            fields f(mr);
+            f.set(field::host, "example.com");
+            BOOST_TEST_EQ(mr.blocks, 2);
+        }
+        BOOST_TEST_EQ(mr.blocks, 0);
+    }
+
+    void
+    testServices()
+    {
+        counting_resource mr;
+        {
+            rts::context ctx;
+            request_parser::config pcfg;
+            pcfg.resource = &mr;
+            install_parser_service(ctx, pcfg);
+            serializer::config scfg;
+            scfg.resource = &mr;
+            install_serializer_service(ctx, scfg);
+
+            {
+                request_parser pr(ctx);
+                BOOST_TEST_EQ(mr.blocks, 1);
+                serializer sr(ctx);
+                BOOST_TEST_EQ(mr.blocks, 2);
+
+                // moves keep the storage
+                serializer sr2(std::move(sr));
+                BOOST_TEST_EQ(mr.blocks, 2);
+            }
+            BOOST_TEST_EQ(mr.blocks, 0);
+
+            {
+                connection_buffers cb(ctx, &mr);
+                BOOST_TEST_EQ(mr.blocks, 1);
+                BOOST_TEST_EQ(mr.bytes, cb.size());
+            }
+            BOOST_TEST_EQ(mr.blocks, 0);
+        }
+        BOOST_TEST_EQ(mr.bytes, 0);
+    }
+
+    void
+    run()
+    {
+        testContainers();
+        testServices();
+    }
+};
+
+TEST_SUITE(
+    memory_resource_test,
+    "boost.http_proto.memory_resource");
+
+} // http_proto
+} // boost
@@ -268,6 +268,29 @@ struct metadata_test
                 f.erase(field::connection);
             },
             { ok, 0, false, false, false});
+
+        // erase the invalid field
+        req("GET / HTTP/1.1\r\n"
+            "Connection: /\r\n"
+            "Connection: close\r\n"
+            "Connection: keep-alive\r\n"
+            "\r\n",
+            [](message_base& f)
+            {
+                f.erase(f.find(field::connection));
+            },
+            { ok, 2, true, true, false});
+
+        // a token still present in another field
+        req("GET / HTTP/1.1\r\n"
+            "Connection: close\r\n"
+            "Connection: upgrade, close\r\n"
+            "\r\n",
+            [](message_base& f)
+            {
+                f.erase(f.find(field::connection));
+            },
+            { ok, 1, true, false, true});
     }
 
     void
@@ -300,6 +323,13 @@ struct metadata_test
             [](message_base&){},
             { ok, 1, content_coding::gzip });
 
+        check(
+            "GET / HTTP/1.1\r\n"
+            "Content-Encoding: ZSTD\r\n"
+            "\r\n",
+            [](message_base&){},
+            { ok, 1, content_coding::zstd });
+
         check(
             "GET / HTTP/1.1\r\n"
             "Content-Encoding: gzip, deflate\r\n"
@@ -321,6 +351,55 @@ struct metadata_test
             "\r\n",
             [](message_base&){},
             { error::bad_content_encoding, 1, content_coding::unknown});
+
+        //----------------------------------------
+
+        check(
+            "GET / HTTP/1.1\r\n"
+            "Content-Encoding: gzip\r\n"
+            "Content-Encoding: br\r\n"
+            "\r\n",
+            [](message_base& f)
+            {
+                f.erase(f.find(field::content_encoding));
+            },
+            { ok, 1, content_coding::br });
+
+        check(
+            "GET / HTTP/1.1\r\n"
+            "Content-Encoding: bad;\r\n"
+            "Content-Encoding: gzip\r\n"
+            "\r\n",
+            [](message_base& f)
+            {
+                f.erase(f.find(field::content_encoding));
+            },
+            { ok, 1, content_coding::gzip });
+
+        check(
+            "GET / HTTP/1.1\r\n"
+            "Content-Encoding: gzip\r\n"
+            "Content-Encoding: bad;\r\n"
+            "Content-Encoding: br\r\n"
+            "\r\n",
+            [](message_base& f)
+            {
+                f.erase(f.find(field::content_encoding));
+            },
+            { error::bad_content_encoding, 2, content_coding::unknown });
+
+        // erase all
+        check(
+            "GET / HTTP/1.1\r\n"
+            "Content-Encoding: gzip\r\n"
+            "Content-Encoding: bad;\r\n"
+            "\r\n",
+            [](message_base& f)
+            {
+                f.erase(field::content_encoding);
+                f.append(field::content_encoding, "zstd");
+            },
+            { ok, 1, content_coding::zstd });
     }
 
     void
@@ -456,6 +535,32 @@ struct metadata_test
                 f.erase(field::content_length);
             },
             { ok, 0, 0 });
+
+        // erase the invalid value
+        check(
+            "GET / HTTP/1.1\r\n"
+            "Content-Length: x\r\n"
+            "Content-Length: 3\r\n"
+            "\r\n",
+            [](message_base& f)
+            {
+                f.erase(f.find(
+                    field::content_length));
+            },
+            { ok, 1, 3 });
+
+        check(
+            "GET / HTTP/1.1\r\n"
+            "Content-Length: x\r\n"
+            "Content-Length: 3\r\n"
+            "Content-Length: 5\r\n"
+            "\r\n",
+            [](message_base& f)
+            {
+                f.erase(f.find(
+                    field::content_length));
+            },
+            { error::multiple_content_length, 2, 0 });
     }
 
     void
@@ -634,6 +739,53 @@ struct metadata_test
                 f.erase(field::transfer_encoding);
             },
             { ok, 0, false });
+
+        check(
+            "GET / HTTP/1.1\r\n"
+            "Transfer-Encoding: chunked\r\n"
+            "Transfer-Encoding: chunked\r\n"
+            "\r\n",
+            [](message_base& f)
+            {
+                f.erase(f.find(field::transfer_encoding));
+            },
+            { ok, 1, true });
+
+        check(
+            "GET / HTTP/1.1\r\n"
+            "Transfer-Encoding: chunked\r\n"
+            "Transfer-Encoding: gzip\r\n"
+            "\r\n",
+            [](message_base& f)
+            {
+                f.erase(f.find(field::transfer_encoding));
+            },
+            { ok, 1, false });
+
+        check(
+            "GET / HTTP/1.1\r\n"
+            "Transfer-Encoding: chunked, gzip\r\n"
+            "Transfer-Encoding: gzip\r\n"
+            "Transfer-Encoding: chunked\r\n"
+            "\r\n",
+            [](message_base& f)
+            {
+                f.erase(f.find(field::transfer_encoding));
+            },
+            { ok, 2, true });
+
+        // chunked is not last
+        check(
+            "GET / HTTP/1.1\r\n"
+            "Transfer-Encoding: gzip\r\n"
+            "Transfer-Encoding: chunked\r\n"
+            "Transfer-Encoding: gzip\r\n"
+            "\r\n",
+            [](message_base& f)
+            {
+                f.erase(f.find(field::transfer_encoding));
+            },
+            { error::bad_transfer_encoding, 2, false });
     }
 
     void
@@ -783,6 +935,29 @@ struct metadata_test
                 f.erase(field::upgrade);
             },
             { ok, 0, false });
+
+        check(
+            "GET / HTTP/1.1\r\n"
+            "Upgrade: /usr\r\n"
+            "Upgrade: websocket\r\n"
+            "\r\n",
+            [](message_base& f)
+            {
+                f.erase(f.find(field::upgrade));
+            },
+            { ok, 1, true });
+
+        check(
+            "GET / HTTP/1.1\r\n"
+            "Upgrade: websocket\r\n"
+            "Upgrade: chaka\r\n"
+            "Upgrade: websocket\r\n"
+            "\r\n",
+            [](message_base& f)
+            {
+                f.erase(f.find(field::upgrade));
+            },
+            { ok, 2, true });
     }
 
     void
@@ -13,6 +13,7 @@
 
 #include <boost/http_proto/message_base.hpp>
 
+#include <string>
 #include <utility>
 
 #include "test_suite.hpp"
@@ -784,6 +785,127 @@ struct request_test
         }
     }
 
+    void
+    testStartLineSlack()
+    {
+        core::string_view const cs =
+            "GET http://example.com/api/v1/items HTTP/1.1\r\n"
+            "Host: example.com\r\n"
+            "User-Agent: boost\r\n"
+            "\r\n";
+
+        // shorter start lines do not move the fields
+        {
+            request req(cs);
+            auto const n = req.capacity_in_bytes();
+            auto const p = req.find(field::host)->value.data();
+            req.set_target("/api/v1/items");
+            BOOST_TEST(req.find(field::host)->value.data() == p);
+            BOOST_TEST_EQ(req.capacity_in_bytes(), n);
+            BOOST_TEST_EQ(req.buffer(),
+                "GET /api/v1/items HTTP/1.1\r\n"
+                "Host: example.com\r\n"
+                "User-Agent: boost\r\n"
+                "\r\n");
+
+            // longer, within the slack
+            req.set_method(method::options);
+            req.set_target("/api/v2/items");
+            BOOST_TEST(req.find(field::host)->value.data() == p);
+            BOOST_TEST_EQ(req.method_text(), "OPTIONS");
+            BOOST_TEST_EQ(req.target(), "/api/v2/items");
+            BOOST_TEST_EQ(req.buffer(),
+                "OPTIONS /api/v2/items HTTP/1.1\r\n"
+                "Host: example.com\r\n"
+                "User-Agent: boost\r\n"
+                "\r\n");
+
+            // the slack is given back
+            req.clear();
+            BOOST_TEST_EQ(req.capacity_in_bytes(), n);
+            BOOST_TEST_EQ(req.buffer(),
+                "GET / HTTP/1.1\r\n\r\n");
+        }
+
+        // configured slack
+        {
+            request req(cs);
+            req.reserve_bytes(1024);
+            req.set_start_line_slack(32);
+            req.set_target("/");
+            req.set_target("/a/much/longer/target/than/before");
+            auto const p = req.find(field::host)->value.data();
+            req.set_target("/a/much/longer/target/than/before/x/y/z");
+            req.set_method(method::propfind);
+            BOOST_TEST(req.find(field::host)->value.data() == p);
+            BOOST_TEST_EQ(req.buffer(),
+                "PROPFIND /a/much/longer/target/than/before/x/y/z HTTP/1.1\r\n"
+                "Host: example.com\r\n"
+                "User-Agent: boost\r\n"
+                "\r\n");
+            BOOST_TEST_EQ(req.at(field::user_agent), "boost");
+
+            // a copy has no slack
+            request req2(req);
+            BOOST_TEST_EQ(req2.buffer(), req.buffer());
+            req = request(cs);
+            BOOST_TEST_EQ(req.buffer(), cs);
+        }
+
+        // the slack counts towards the capacity
+        {
+            request req(128, 128);
+            req.set_target("/a/long/target/to/leave/slack");
+            req.append(field::host, "x");
+            auto const p = req.buffer().data();
+            req.set_target("/");
+
+            // the longest value which fits
+            // along with one table entry
+            using entry = detail::header::entry;
+            auto const size = req.buffer().size();
+            std::size_t n = 0;
+            while(((size + n + alignof(entry) - 1) &
+                    ~(alignof(entry) - 1)) +
+                        sizeof(entry) <= 128)
+                ++n;
+
+            // strong guarantee
+            std::string const s(req.buffer());
+            BOOST_TEST_THROWS(
+                req.set(field::host, std::string(n + 1, 'x')),
+                std::length_error);
+            BOOST_TEST_EQ(req.buffer(), s);
+
+            req.set(field::host, std::string(n, 'x'));
+            BOOST_TEST(req.buffer().data() == p);
+            BOOST_TEST_EQ(req.capacity_in_bytes(), 128);
+            BOOST_TEST_EQ(req.at(field::host).size(), n);
+            BOOST_TEST_EQ(req.target(), "/");
+        }
+
+        // the target refers to the fields
+        {
+            request req(cs);
+            req.set_start_line_slack(16);
+            req.set_target("/");
+            req.set_target(req.at(field::user_agent));
+            BOOST_TEST_EQ(req.target(), "boost");
+            req.set_target(req.at(field::host));
+            BOOST_TEST_EQ(req.target(), "example.com");
+            req.set_target(
+                "/a/much/longer/target/than/the/capacity/"
+                "of/the/buffer/so/that/it/reallocates/"
+                "a/much/longer/target/than/the/capacity");
+            req.set_target(req.at(field::host));
+            BOOST_TEST_EQ(req.buffer(),
+                "GET example.com HTTP/1.1\r\n"
+                "Host: example.com\r\n"
+                "User-Agent: boost\r\n"
+                "\r\n");
+        }
+    }
+
     void
     run()
     {
@@ -793,6 +915,7 @@ struct request_test
         testModifiers();
         testExpect();
         testInitialSize();
+        testStartLineSlack();
     }
 };
 
@@ -0,0 +1,180 @@
+//
+// Copyright (c) 2025 Mohammad Nejati
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+// Test that header file is self-contained.
+#include <boost/http_proto/response_template.hpp>
+
+#include <boost/system/system_error.hpp>
+
+#include <stdexcept>
+
+#include "test_suite.hpp"
+
+namespace boost {
+namespace http_proto {
+
+class response_template_test
+{
+public:
+    void
+    testSlots()
+    {
+        response res(status::ok);
+        res.set(field::server, "test");
+        res.set(field::content_type, "text/plain");
+
+        response_template rt(res);
+        BOOST_TEST_EQ(rt.slot_count(), 0);
+        BOOST_TEST_EQ(
+            rt.message().buffer(), res.buffer());
+
+        auto const date =
+            rt.add_slot(field::date, 29);
+        auto const rid =
+            rt.add_slot("X-Request-Id", 8);
+        auto const cl =
+            rt.add_slot(field::content_length, 4);
+        BOOST_TEST_EQ(rt.slot_count(), 3);
+        BOOST_TEST_EQ(
+            rt.message().buffer(),
+            "HTTP/1.1 200 OK\r\n"
+            "Server: test\r\n"
+            "Content-Type: text/plain\r\n"
+            "Date:                              \r\n"
+            "X-Request-Id:         \r\n"
+            "Content-Length:     \r\n"
+            "\r\n");
+        // empty Content-Length until it is set
+        BOOST_TEST(
+            rt.message().payload() == payload::error);
+
+        rt.set(date, "Sun, 06 Nov 1994 08:49:37 GMT");
+        rt.set(rid, "abc");
+        rt.set(cl, "12");
+        BOOST_TEST_EQ(
+            rt.message().buffer(),
+            "HTTP/1.1 200 OK\r\n"
+            "Server: test\r\n"
+            "Content-Type: text/plain\r\n"
+            "Date: Sun, 06 Nov 1994 08:49:37 GMT\r\n"
+            "X-Request-Id: abc     \r\n"
+            "Content-Length: 12  \r\n"
+            "\r\n");
+        BOOST_TEST_EQ(
+            rt.message().at(field::date),
+            "Sun, 06 Nov 1994 08:49:37 GMT");
+        BOOST_TEST_EQ(
+            rt.message().at("X-Request-Id"), "abc");
+        BOOST_TEST(
+            rt.message().payload() == payload::size);
+        BOOST_TEST_EQ(
+            rt.message().payload_size(), 12);
+
+        // the padding parses as OWS
+        response const parsed(rt.message().buffer());
+        BOOST_TEST_EQ(
+            parsed.at(field::content_length), "12");
+        BOOST_TEST_EQ(parsed.payload_size(), 12);
+
+        rt.set_content_length(1234);
+        BOOST_TEST_EQ(
+            rt.message().payload_size(), 1234);
+        rt.set_content_length(0);
+        BOOST_TEST_EQ(
+            rt.message().payload_size(), 0);
+        rt.set(rid, "");
+        BOOST_TEST_EQ(
+            rt.message().at("X-Request-Id"), "");
+
+        // errors
+        BOOST_TEST_THROWS(
+            rt.set(3, "x"), std::out_of_range);
+        BOOST_TEST_THROWS(
+            rt.set(rid, "123456789"), std::length_error);
+        BOOST_TEST_THROWS(
+            rt.set(rid, "a\r\nb"), std::invalid_argument);
+        BOOST_TEST_THROWS(
+            rt.set(rid, " a"), std::invalid_argument);
+        BOOST_TEST_THROWS(
+            rt.set_content_length(12345), std::length_error);
+        BOOST_TEST_EQ(
+            rt.message().payload_size(), 0);
+        BOOST_TEST_THROWS(
+            rt.add_slot(field::date, 29),
+            std::invalid_argument);
+        BOOST_TEST_THROWS(
+            rt.add_slot("x-request-id", 8),
+            std::invalid_argument);
+        BOOST_TEST_THROWS(
+            rt.add_slot(field::etag, 0),
+            std::invalid_argument);
+        BOOST_TEST_THROWS(
+            rt.add_slot("bad name", 8),
+            system::system_error);
+    }
+
+    void
+    testExisting()
+    {
+        response res(status::ok);
+        res.set(field::etag, "\"v1\"");
+        res.set(field::server, "test");
+
+        // existing values move to the end
+        // and become the initial value
+        {
+            response_template rt(res);
+            auto const etag =
+                rt.add_slot("ETag", 6);
+            BOOST_TEST_EQ(
+                rt.message().buffer(),
+                "HTTP/1.1 200 OK\r\n"
+                "Server: test\r\n"
+                "ETag: \"v1\"  \r\n"
+                "\r\n");
+            rt.set(etag, "\"v22\"");
+            BOOST_TEST_EQ(
+                rt.message().at(field::etag),
+                "\"v22\"");
+        }
+
+        // too wide
+        {
+            response_template rt(res);
+            BOOST_TEST_THROWS(
+                rt.add_slot(field::etag, 3),
+                std::length_error);
+            BOOST_TEST_EQ(rt.slot_count(), 0);
+            BOOST_TEST_EQ(
+                rt.message().buffer(), res.buffer());
+        }
+
+        // no Content-Length slot
+        {
+            response_template rt(res);
+            BOOST_TEST_THROWS(
+                rt.set_content_length(1),
+                std::logic_error);
+        }
+    }
+
+    void
+    run()
+    {
+        testSlots();
+        testExisting();
+    }
+};
+
+TEST_SUITE(
+    response_template_test,
+    "boost.http_proto.response_template");
+
+} // http_proto
+} // boost
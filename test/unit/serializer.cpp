@@ -21,6 +21,7 @@
 
 #include "test_helpers.hpp"
 
+#include <algorithm>
 #include <array>
 #include <stdexcept>
 #include <string>
@@ -90,6 +91,70 @@ struct serializer_test
         bool is_done_ = false;
     };
 
+    struct lending_source : source
+    {
+        lending_source(
+            core::string_view s,
+            std::size_t piece,
+            std::size_t& released)
+            : s_(s)
+            , piece_(piece)
+            , released_(released)
+        {
+        }
+
+        results
+        on_read(
+            buffers::mutable_buffer b) override
+        {
+            results rv;
+            rv.bytes =
+                buffers::copy(
+                    b,
+                    buffers::make_buffer(
+                        s_.data(),
+                        s_.size()));
+            s_ = s_.substr(rv.bytes);
+            rv.finished = s_.empty();
+            return rv;
+        }
+
+        bool
+        on_can_borrow() const noexcept override
+        {
+            return true;
+        }
+
+        results
+        on_borrow(
+            buffers::const_buffer& b) override
+        {
+            results rv;
+            auto const n = (std::min)(
+                piece_, s_.size());
+            b = { s_.data(), n };
+            s_.remove_prefix(n);
+            lent_ += n;
+            rv.bytes = n;
+            rv.finished = s_.empty();
+            return rv;
+        }
+
+        void
+        on_release(
+            std::size_t n) noexcept override
+        {
+            BOOST_TEST_LE(n, lent_ - released_);
+            released_ += n;
+        }
+
+    private:
+        core::string_view s_;
+        std::size_t piece_;
+        std::size_t lent_ = 0;
+        std::size_t& released_;
+    };
+
     template<
         class ConstBuffers>
     static
@@ -939,6 +1004,106 @@ struct serializer_test
         }
     }
 
+    void
+    testBorrowedSource()
+    {
+        std::string body;
+        for(int i = 0; i < 5000; ++i)
+            body += static_cast<char>('0' + i % 10);
+
+        // buffers are gathered without copying
+        {
+            response res(
+                "HTTP/1.1 200 OK\r\n"
+                "Content-Length: 5000\r\n"
+                "\r\n");
+            rts::context ctx;
+            install_serializer_service(ctx, {});
+            serializer sr(ctx);
+            std::size_t released = 0;
+            sr.start<lending_source>(
+                res, body, 100, released);
+            auto cbs = sr.prepare().value();
+            BOOST_TEST_EQ(cbs.size(), 17);
+            BOOST_TEST_EQ(
+                cbs[1].data(),
+                static_cast<void const*>(body.data()));
+            sr.consume(res.buffer().size() + 150);
+            BOOST_TEST_EQ(released, 150);
+        }
+
+        // content length
+        {
+            std::size_t released = 0;
+            check_src(
+                "HTTP/1.1 200 OK\r\n"
+                "Content-Length: 5000\r\n"
+                "\r\n",
+                lending_source{body, 100, released},
+                [&](core::string_view s){
+                    BOOST_TEST(s ==
+                        "HTTP/1.1 200 OK\r\n"
+                        "Content-Length: 5000\r\n"
+                        "\r\n" + body);
+                });
+            BOOST_TEST_EQ(released, body.size());
+        }
+
+        // empty
+        {
+            std::size_t released = 0;
+            check_src(
+                "HTTP/1.1 200 OK\r\n"
+                "Content-Length: 0\r\n"
+                "\r\n",
+                lending_source{"", 100, released},
+                [&](core::string_view s){
+                    BOOST_TEST(s ==
+                        "HTTP/1.1 200 OK\r\n"
+                        "Content-Length: 0\r\n"
+                        "\r\n");
+                });
+            BOOST_TEST_EQ(released, 0);
+        }
+
+        // lending nothing before the end
+        {
+            response res(
+                "HTTP/1.1 200 OK\r\n"
+                "Content-Length: 5000\r\n"
+                "\r\n");
+            rts::context ctx;
+            install_serializer_service(ctx, {});
+            serializer sr(ctx);
+            std::size_t released = 0;
+            sr.start<lending_source>(
+                res, body, 0, released);
+            BOOST_TEST_THROWS(
+                sr.prepare(),
+                std::logic_error);
+        }
+
+        // chunked is read as usual
+        {
+            std::size_t released = 0;
+            check_src(
+                "HTTP/1.1 200 OK\r\n"
+                "Transfer-Encoding: chunked\r\n"
+                "\r\n",
+                lending_source{body, 100, released},
+                [&](core::string_view s){
+                    core::string_view expected_header =
+                        "HTTP/1.1 200 OK\r\n"
+                        "Transfer-Encoding: chunked\r\n"
+                        "\r\n";
+                    BOOST_TEST(s.starts_with(expected_header));
+                    s.remove_prefix(expected_header.size());
+                    check_chunked_body(s, body);
+                });
+            BOOST_TEST_EQ(released, 0);
+        }
+    }
+
     void
     testOverConsume()
     {
@@ -961,6 +1126,7 @@ struct serializer_test
         testOutput();
         testExpect100Continue();
         testStreamErrors();
+        testBorrowedSource();
         testOverConsume();
     }
 };
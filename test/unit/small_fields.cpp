@@ -0,0 +1,84 @@
+//
+// Copyright (c) 2025 Mohammad Nejati
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+// Test that header file is self-contained.
+#include <boost/http_proto/small_fields.hpp>
+
+#include "test_suite.hpp"
+
+#include <string>
+
+namespace boost {
+namespace http_proto {
+
+class small_fields_test
+{
+public:
+    void
+    testSpecial()
+    {
+        core::string_view const cs =
+            "Host: example.com\r\n"
+            "Connection: close\r\n"
+            "\r\n";
+
+        // small_fields()
+        {
+            small_fields<> fs;
+            BOOST_TEST(fs.is_inline());
+            BOOST_TEST_EQ(fs.buffer(), "\r\n");
+        }
+
+        // small_fields(fields const&)
+        {
+            fields const f(cs);
+            small_fields<> fs(f);
+            BOOST_TEST(fs.is_inline());
+            BOOST_TEST_EQ(fs.buffer(), cs);
+        }
+
+        // operator=(small_fields&&)
+        {
+            small_fields<> f1;
+            f1 = fields(cs);
+            small_fields<> f2;
+            f2 = std::move(f1);
+            BOOST_TEST_EQ(f2.buffer(), cs);
+            BOOST_TEST_EQ(f1.buffer(), "\r\n");
+        }
+    }
+
+    void
+    testCapacity()
+    {
+        small_fields<64> fs;
+        fs.set(field::host, "example.com");
+        BOOST_TEST(fs.is_inline());
+        fs.set(field::user_agent, std::string(64, 'a'));
+        BOOST_TEST(! fs.is_inline());
+        BOOST_TEST_EQ(
+            fs.at(field::host), "example.com");
+        BOOST_TEST_EQ(
+            fs.at(field::user_agent), std::string(64, 'a'));
+    }
+
+    void
+    run()
+    {
+        testSpecial();
+        testCapacity();
+    }
+};
+
+TEST_SUITE(
+    small_fields_test,
+    "boost.http_proto.small_fields");
+
+} // http_proto
+} // boost
@@ -0,0 +1,148 @@
+//
+// Copyright (c) 2025 Mohammad Nejati
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+// Test that header file is self-contained.
+#include <boost/http_proto/small_request.hpp>
+
+#include <boost/http_proto/request.hpp>
+
+#include "test_suite.hpp"
+
+#include <string>
+
+namespace boost {
+namespace http_proto {
+
+class small_request_test
+{
+public:
+    void
+    testSpecial()
+    {
+        core::string_view const cs =
+            "POST /upload HTTP/1.1\r\n"
+            "Host: example.com\r\n"
+            "Content-Length: 12\r\n"
+            "\r\n";
+
+        // small_request()
+        {
+            small_request<> req;
+            BOOST_TEST(req.is_inline());
+            BOOST_TEST_EQ(
+                req.buffer(),
+                "GET / HTTP/1.1\r\n\r\n");
+        }
+
+        // small_request(request_base const&)
+        {
+            request const r(cs);
+            small_request<> req(r);
+            BOOST_TEST(req.is_inline());
+            BOOST_TEST_EQ(req.buffer(), cs);
+            BOOST_TEST(req.method() == method::post);
+            BOOST_TEST_EQ(req.target(), "/upload");
+        }
+
+        // small_request(small_request&&)
+        {
+            small_request<64> r1;
+            r1.set_target(std::string(100, 'a'));
+            BOOST_TEST(! r1.is_inline());
+            auto const p = r1.buffer().data();
+            small_request<64> r2(std::move(r1));
+            BOOST_TEST(r2.buffer().data() == p);
+            BOOST_TEST_EQ(
+                r2.target(), std::string(100, 'a'));
+            BOOST_TEST(r1.is_inline());
+            BOOST_TEST_EQ(
+                r1.buffer(),
+                "GET / HTTP/1.1\r\n\r\n");
+        }
+
+        // small_request(small_request&&), inline
+        {
+            small_request<> r1(request{cs});
+            BOOST_TEST(r1.is_inline());
+            small_request<> r2(std::move(r1));
+            BOOST_TEST(r2.is_inline());
+            BOOST_TEST_EQ(r2.buffer(), cs);
+            BOOST_TEST(r1.is_inline());
+            BOOST_TEST_EQ(r1.size(), 0);
+            BOOST_TEST_EQ(
+                r1.buffer(),
+                "GET / HTTP/1.1\r\n\r\n");
+        }
+
+        // operator=(small_request&&), inline
+        {
+            small_request<> r1(request{cs});
+            small_request<> r2;
+            r2.set(field::user_agent, "test");
+            r2 = std::move(r1);
+            BOOST_TEST_EQ(r2.buffer(), cs);
+            BOOST_TEST(r1.is_inline());
+            BOOST_TEST_EQ(r1.size(), 0);
+            BOOST_TEST_EQ(
+                r1.buffer(),
+                "GET / HTTP/1.1\r\n\r\n");
+
+            // the moved-from object is usable
+            r1.set(field::host, "example.com");
+            BOOST_TEST_EQ(
+                r1.buffer(),
+                "GET / HTTP/1.1\r\n"
+                "Host: example.com\r\n"
+                "\r\n");
+        }
+    }
+
+    void
+    testCapacity()
+    {
+        // a typical request stays inline
+        {
+            small_request<> req;
+            req.set_start_line(method::get, "/index.html");
+            req.set(field::host, "www.example.com");
+            req.set(field::user_agent, "Boost.HttpProto");
+            req.set(field::accept, "text/html,application/xhtml+xml");
+            req.set(field::accept_encoding, "gzip, deflate, br");
+            req.set(field::accept_language, "en-US,en;q=0.5");
+            req.set(field::connection, "keep-alive");
+            BOOST_TEST(req.is_inline());
+        }
+
+        // the start line moves to the heap
+        {
+            small_request<64> req;
+            req.set(field::host, "example.com");
+            req.set_target(std::string(200, 'a'));
+            BOOST_TEST(! req.is_inline());
+            BOOST_TEST_EQ(
+                req.target(), std::string(200, 'a'));
+            BOOST_TEST_EQ(
+                req.at(field::host), "example.com");
+        }
+    }
+
+    void
+    run()
+    {
+        testSpecial();
+        testCapacity();
+    }
+};
+
+TEST_SUITE(
+    small_request_test,
+    "boost.http_proto.small_request");
+
+} // http_proto
+} // boost
@@ -0,0 +1,220 @@
+//
+// Copyright (c) 2025 Mohammad Nejati
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+// Test that header file is self-contained.
+#include <boost/http_proto/small_response.hpp>
+
+#include <boost/http_proto/response.hpp>
+
+#include "test_suite.hpp"
+
+#include <string>
+
+namespace boost {
+namespace http_proto {
+
+class small_response_test
+{
+public:
+    core::string_view const cs =
+        "HTTP/1.1 404 Not Found\r\n"
+        "Server: test\r\n"
+        "Content-Length: 0\r\n"
+        "\r\n";
+
+    // Append fields until the response
+    // moves to the heap.
+    template<std::size_t N>
+    static
+    void
+    overflow(small_response<N>& res)
+    {
+        std::string const v(40, 'x');
+        while(res.is_inline())
+            res.append("X-Filler", v);
+    }
+
+    void
+    testSpecial()
+    {
+        // small_response()
+        {
+            small_response<> res;
+            BOOST_TEST(res.is_inline());
+            BOOST_TEST_EQ(
+                res.buffer(),
+                "HTTP/1.1 200 OK\r\n\r\n");
+            BOOST_TEST_EQ(
+                res.capacity_in_bytes(), 512);
+            BOOST_TEST_GT(
+                res.max_capacity_in_bytes(), 512);
+        }
+
+        // small_response(response_base const&)
+        {
+            response const r(cs);
+            small_response<> res(r);
+            BOOST_TEST(res.is_inline());
+            BOOST_TEST_EQ(res.buffer(), cs);
+            BOOST_TEST_EQ(res.status_int(), 404);
+        }
+
+        // small_response(small_response const&)
+        {
+            small_response<64> r1;
+            overflow(r1);
+            small_response<64> r2(r1);
+            BOOST_TEST(! r2.is_inline());
+            BOOST_TEST_EQ(r2.buffer(), r1.buffer());
+            BOOST_TEST(
+                r2.buffer().data() != r1.buffer().data());
+        }
+
+        // small_response(small_response&&)
+        {
+            small_response<> r1;
+            r1 = response(cs);
+            small_response<> r2(std::move(r1));
+            BOOST_TEST(r2.is_inline());
+            BOOST_TEST_EQ(r2.buffer(), cs);
+            BOOST_TEST(r1.is_inline());
+            BOOST_TEST_EQ(
+                r1.buffer(),
+                "HTTP/1.1 200 OK\r\n\r\n");
+
+            // the heap buffer is transferred
+            small_response<64> r3;
+            overflow(r3);
+            auto const p = r3.buffer().data();
+            auto const s = std::string(r3.buffer());
+            small_response<64> r4(std::move(r3));
+            BOOST_TEST(! r4.is_inline());
+            BOOST_TEST(r4.buffer().data() == p);
+            BOOST_TEST_EQ(r4.buffer(), s);
+            BOOST_TEST(r3.is_inline());
+            BOOST_TEST_EQ(
+                r3.buffer(),
+                "HTTP/1.1 200 OK\r\n\r\n");
+            r3.set(field::server, "test");
+            BOOST_TEST(r3.is_inline());
+        }
+
+        // operator=(small_response&&)
+        {
+            small_response<64> r1;
+            overflow(r1);
+            small_response<64> r2;
+            overflow(r2);
+            auto const p = r1.buffer().data();
+            r2 = std::move(r1);
+            BOOST_TEST(r2.buffer().data() == p);
+            BOOST_TEST(r1.is_inline());
+
+            small_response<64> r3;
+            r3.set(field::server, "test");
+            r2 = std::move(r3);
+            BOOST_TEST(r2.is_inline());
+            BOOST_TEST_EQ(
+                r2.buffer(),
+                "HTTP/1.1 200 OK\r\n"
+                "Server: test\r\n"
+                "\r\n");
+            BOOST_TEST(r3.is_inline());
+            BOOST_TEST_EQ(r3.size(), 0);
+            BOOST_TEST_EQ(
+                r3.buffer(),
+                "HTTP/1.1 200 OK\r\n\r\n");
+        }
+
+        // operator=(small_response const&)
+        {
+            small_response<> r1;
+            r1 = response(cs);
+            small_response<> r2;
+            r2 = r1;
+            BOOST_TEST(r2.is_inline());
+            BOOST_TEST_EQ(r2.buffer(), cs);
+            BOOST_TEST(
+                r2.buffer().data() != r1.buffer().data());
+        }
+    }
+
+    void
+    testCapacity()
+    {
+        // a typical response stays inline
+        {
+            small_response<> res;
+            res.set_start_line(status::not_found);
+            res.set(field::server, "Boost.HttpProto");
+            res.set(field::date, "Sun, 06 Nov 1994 08:49:37 GMT");
+            res.set(field::content_type, "text/plain; charset=utf-8");
+            res.set(field::cache_control, "no-cache");
+            res.set(field::connection, "keep-alive");
+            res.set_content_length(80);
+            BOOST_TEST(res.is_inline());
+            BOOST_TEST_EQ(
+                res.capacity_in_bytes(), 512);
+        }
+
+        // geometric growth past the inline storage
+        {
+            small_response<64> res;
+            overflow(res);
+            BOOST_TEST_GE(
+                res.capacity_in_bytes(), 128);
+            auto const n = res.size();
+            std::size_t reallocs = 0;
+            for(int i = 0; i < 64; ++i)
+            {
+                auto const p = res.buffer().data();
+                res.append("X-Filler", "y");
+                if(res.buffer().data() != p)
+                    ++reallocs;
+            }
+            BOOST_TEST_EQ(res.size(), n + 64);
+            BOOST_TEST_LE(reallocs, 6);
+        }
+
+        // clear keeps the heap buffer
+        {
+            small_response<64> res;
+            overflow(res);
+            auto const cap = res.capacity_in_bytes();
+            res.clear();
+            BOOST_TEST(! res.is_inline());
+            BOOST_TEST_EQ(
+                res.capacity_in_bytes(), cap);
+        }
+
+        // max capacity still applies
+        {
+            small_response<64> res;
+            res.set_max_capacity_in_bytes(64);
+            BOOST_TEST_THROWS(
+                overflow(res),
+                std::length_error);
+            BOOST_TEST(res.is_inline());
+        }
+    }
+
+    void
+    run()
+    {
+        testSpecial();
+        testCapacity();
+    }
+};
+
+TEST_SUITE(
+    small_response_test,
+    "boost.http_proto.small_response");
+
+} // http_proto
+} // boost
@@ -0,0 +1,166 @@
+//
+// Copyright (c) 2025 Mohammad Nejati
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+// Test that header file is self-contained.
+#include <boost/http_proto/spool.hpp>
+
+#include <boost/buffers/make_buffer.hpp>
+
+#include "test_suite.hpp"
+
+namespace boost {
+namespace http_proto {
+
+struct spool_test
+{
+    std::string
+    read_all(spool& sp)
+    {
+        std::string s;
+        s.resize(static_cast<std::size_t>(sp.size()));
+        system::error_code ec;
+        auto n = sp.read_at(0,
+            buffers::make_buffer(&s[0], s.size()), ec);
+        BOOST_TEST(!ec);
+        BOOST_TEST_EQ(n, s.size());
+        return s;
+    }
+
+    void
+    append(spool& sp, core::string_view s)
+    {
+        system::error_code ec;
+        sp.append(buffers::make_buffer(
+            s.data(), s.size()), ec);
+        BOOST_TEST(!ec);
+    }
+
+    void
+    testMemory()
+    {
+        spool::config cfg;
+        cfg.threshold = 16;
+        spool sp(cfg);
+        BOOST_TEST(sp.in_memory());
+        BOOST_TEST_EQ(sp.size(), 0);
+
+        append(sp, "Hello, ");
+        append(sp, "World!");
+        BOOST_TEST(sp.in_memory());
+        BOOST_TEST_EQ(sp.size(), 13);
+        BOOST_TEST_EQ(core::string_view(
+            static_cast<char const*>(sp.data().data()),
+            sp.data().size()), "Hello, World!");
+        BOOST_TEST_EQ(read_all(sp), "Hello, World!");
+
+        // partial and past the end
+        char buf[8];
+        system::error_code ec;
+        auto n = sp.read_at(7,
+            buffers::make_buffer(buf), ec);
+        BOOST_TEST(!ec);
+        BOOST_TEST_EQ(n, 6);
+        BOOST_TEST_EQ(
+            core::string_view(buf, n), "World!");
+        n = sp.read_at(13,
+            buffers::make_buffer(buf), ec);
+        BOOST_TEST(!ec);
+        BOOST_TEST_EQ(n, 0);
+
+        // the data does not move
+        auto const p = sp.data().data();
+        spool sp2(std::move(sp));
+        BOOST_TEST(sp2.data().data() == p);
+
+        sp2.clear();
+        BOOST_TEST(sp2.in_memory());
+        BOOST_TEST_EQ(sp2.size(), 0);
+    }
+
+    void
+    testFile()
+    {
+        spool::config cfg;
+        cfg.threshold = 8;
+        spool sp(cfg);
+
+        append(sp, "Hello, ");
+        BOOST_TEST(sp.in_memory());
+        append(sp, "World!");
+        BOOST_TEST(! sp.in_memory());
+        append(sp, " Bye.");
+        BOOST_TEST(! sp.in_memory());
+        BOOST_TEST_EQ(sp.size(), 18);
+        BOOST_TEST_EQ(read_all(sp), "Hello, World! Bye.");
+
+        char buf[4];
+        system::error_code ec;
+        auto n = sp.read_at(7,
+            buffers::make_buffer(buf), ec);
+        BOOST_TEST(!ec);
+        BOOST_TEST_EQ(n, 4);
+        BOOST_TEST_EQ(
+            core::string_view(buf, n), "Worl");
+
+        // appends follow reads
+        append(sp, "!");
+        BOOST_TEST_EQ(read_all(sp), "Hello, World! Bye.!");
+
+        sp.clear();
+        BOOST_TEST(sp.in_memory());
+        BOOST_TEST_EQ(sp.size(), 0);
+        append(sp, "again");
+        BOOST_TEST(sp.in_memory());
+        BOOST_TEST_EQ(read_all(sp), "again");
+    }
+
+    void
+    testReserve()
+    {
+        spool::config cfg;
+        cfg.threshold = 8;
+
+        // fits in memory
+        {
+            spool sp(cfg);
+            system::error_code ec;
+            sp.reserve(8, ec);
+            BOOST_TEST(!ec);
+            BOOST_TEST(sp.in_memory());
+        }
+
+        // too large, goes to the file now
+        {
+            spool sp(cfg);
+            append(sp, "abc");
+            system::error_code ec;
+            sp.reserve(1024, ec);
+            BOOST_TEST(!ec);
+            BOOST_TEST(! sp.in_memory());
+            BOOST_TEST_EQ(sp.size(), 3);
+            append(sp, "def");
+            BOOST_TEST_EQ(read_all(sp), "abcdef");
+        }
+    }
+
+    void
+    run()
+    {
+        testMemory();
+        testFile();
+        testReserve();
+    }
+};
+
+TEST_SUITE(
+    spool_test,
+    "boost.http_proto.spool");
+
+} // http_proto
+} // boost
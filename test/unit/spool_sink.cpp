@@ -0,0 +1,77 @@
+//
+// Copyright (c) 2025 Mohammad Nejati
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+// Test that header file is self-contained.
+#include <boost/http_proto/spool_sink.hpp>
+
+#include <array>
+
+#include "test_suite.hpp"
+
+namespace boost {
+namespace http_proto {
+
+struct spool_sink_test
+{
+    void
+    testWrite()
+    {
+        spool::config cfg;
+        cfg.threshold = 10;
+        spool sp(cfg);
+        {
+            spool_sink sink(sp);
+            std::array<core::string_view, 3> bufs{
+                "Hello",
+                ", ",
+                "World!" };
+            for(auto s : bufs)
+            {
+                buffers::const_buffer cb(s.data(), s.size());
+                auto rs = sink.write(cb, s != bufs.back());
+                BOOST_TEST_EQ(rs.bytes, cb.size());
+                BOOST_TEST(!rs.ec);
+            }
+        }
+        // the body outlives the sink
+        BOOST_TEST(! sp.in_memory());
+        BOOST_TEST_EQ(sp.size(), 13);
+
+        std::string s(13, 0);
+        system::error_code ec;
+        sp.read_at(0, { &s[0], s.size() }, ec);
+        BOOST_TEST(!ec);
+        BOOST_TEST_EQ(s, "Hello, World!");
+    }
+
+    void
+    testReserve()
+    {
+        spool::config cfg;
+        cfg.threshold = 10;
+        spool sp(cfg);
+        spool_sink sink(sp);
+        sink.reserve(100);
+        BOOST_TEST(! sp.in_memory());
+    }
+
+    void
+    run()
+    {
+        testWrite();
+        testReserve();
+    }
+};
+
+TEST_SUITE(
+    spool_sink_test,
+    "boost.http_proto.spool_sink");
+
+} // http_proto
+} // boost
@@ -106,6 +106,29 @@ struct static_request_test
             std::length_error);
 
         r.set_target("/");
+
+        // the slack left by a shorter start
+        // line is used before allocating
+        {
+            char buf2[96];
+            static_request r2(buf2, sizeof(buf2));
+            r2.set_target("/index.html");
+            r2.set_target("/");
+            r2.append("T", "*");
+            r2.append("T", "*");
+            r2.append("T", "*");
+            BOOST_TEST(
+                r2.buffer().data() == buf2);
+            BOOST_TEST_EQ(r2.buffer(),
+                "GET / HTTP/1.1\r\n"
+                "T: *\r\n"
+                "T: *\r\n"
+                "T: *\r\n"
+                "\r\n");
+            BOOST_TEST_THROWS(
+                r2.append("T", "*"),
+                std::length_error);
+        }
     }
 
     void